@@ -7,10 +7,12 @@
  * - Real-time configuration
  * - GPIO direction setting
  * - Digital output control
+ * - Deadline-scheduled waveforms with GPIOPatternPlayer
  */
 
 #include <hal/core.h>
 #include <hal/gpio.h>
+#include <hal/gpio_pattern_player.h>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -89,37 +91,36 @@ int main(int argc, char** argv)
         }
         
         std::cout << "Pin " << static_cast<int>(ledPin) << " configured as OUTPUT" << std::endl;
-        std::cout << "Starting blink loop..." << std::endl;
+        std::cout << "Starting blink pattern..." << std::endl;
         std::cout << std::endl;
         
-        // Blink LED
-        int blinkCount = 0;
-        while (running.load())
+        // One cycle: LED on at 0 ms, off at 500 ms, repeated every second on absolute deadlines
+        PinMask led;
+        led.set(ledPin);
+        GPIOPatternPlayer player(*gpio);
+        player.setThreadPriority(50);
+        if (!player.load({{0, led, led}, {500000000, led, PinMask()}}, 1000000000) || !player.start(true))
         {
-            // Turn LED ON
-            if (!gpio->write(ledPin, mex_hal::PinValue::HIGH))
-            {
-                std::cerr << "Failed to write HIGH to pin" << std::endl;
-                break;
-            }
-            std::cout << "Blink #" << ++blinkCount << " - LED ON" << std::endl;
-            
-            // Wait 500ms
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
-            
-            if (!running.load()) break;
+            std::cerr << "Failed to start blink pattern" << std::endl;
+            hal->shutdown();
+            return 1;
+        }
+        
+        uint64_t reportedCycles = 0;
+        while (running.load() && player.isRunning())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
             
-            // Turn LED OFF
-            if (!gpio->write(ledPin, mex_hal::PinValue::LOW))
-            {
-                std::cerr << "Failed to write LOW to pin" << std::endl;
-                break;
-            }
-            std::cout << "Blink #" << blinkCount << " - LED OFF" << std::endl;
+            const GPIOPatternStats stats = player.getStats();
+            if (stats.cycles == reportedCycles) continue;
+            reportedCycles = stats.cycles;
             
-            // Wait 500ms
-            std::this_thread::sleep_for(std::chrono::milliseconds(500));
+            std::cout << "Blink #" << stats.cycles
+                      << " - max lateness " << stats.maxLatenessNs / 1000 << " us"
+                      << ", write errors " << stats.writeErrors << std::endl;
         }
+        player.stop();
+        const uint64_t blinkCount = player.getStats().cycles;
         
         // Ensure LED is off before exiting
         gpio->write(ledPin, mex_hal::PinValue::LOW);
@@ -107,6 +107,12 @@ namespace mex_hal
          */
         virtual float readVoltage(uint8_t channel, float referenceVoltage) = 0;
 
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] virtual uint64_t getResourceId() const = 0;
+
     protected:
         inline static const std::string SYS_CLASS_IIO = "/sys/bus/iio/devices/iio:device";
     };
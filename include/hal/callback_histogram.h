@@ -0,0 +1,98 @@
+#ifndef MEX_HAL_CALLBACK_HISTOGRAM_H
+#define MEX_HAL_CALLBACK_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /// @brief Distribution summary of a histogram, percentiles are bucket upper bounds \struct HistogramSummary
+    struct HistogramSummary
+    {
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t meanNs = 0;
+        uint64_t p50Ns = 0;
+        uint64_t p90Ns = 0;
+        uint64_t p99Ns = 0;
+        uint64_t p999Ns = 0;
+        uint64_t maxNs = 0;
+    };
+
+    /**
+     * @brief Lock-free log-linear histogram of durations in nanoseconds, HDR style
+     *
+     * Values below 8 ns have a bucket each, above that every power of two is split
+     * into 8 linear sub-buckets, so a bucket is at most 12.5 % wide over the whole
+     * 64-bit range. record() is a handful of relaxed atomic increments and may run
+     * on any number of threads; summary() and reset() are not synchronized with it
+     * and see a recording in progress either fully, partly or not at all.
+     */
+    class CallbackHistogram
+    {
+    public:
+        static constexpr unsigned SUB_BUCKET_BITS = 3;
+        static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+        static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        /**
+         * @brief Record one duration
+         * @param valueNs The duration in nanoseconds
+         */
+        void record(const uint64_t valueNs) noexcept
+        {
+            buckets_[bucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+            total_.fetch_add(valueNs, std::memory_order_relaxed);
+
+            uint64_t max = max_.load(std::memory_order_relaxed);
+            while (valueNs > max && !max_.compare_exchange_weak(max, valueNs, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        /**
+         * @brief Summarize the recorded durations
+         * @return The summary, all zero if nothing was recorded
+         */
+        [[nodiscard]] HistogramSummary summary() const noexcept;
+
+        /**
+         * @brief Clear all recorded durations
+         */
+        void reset() noexcept;
+
+        /**
+         * @brief Get the bucket of a value
+         * @param valueNs The value in nanoseconds
+         * @return The bucket index
+         */
+        static size_t bucketIndex(const uint64_t valueNs) noexcept
+        {
+            if (valueNs < SUB_BUCKETS)
+            {
+                return static_cast<size_t>(valueNs);
+            }
+
+            const unsigned exponent = 63 - static_cast<unsigned>(__builtin_clzll(valueNs));
+            const unsigned shift = exponent - SUB_BUCKET_BITS;
+            return (shift + 1) * SUB_BUCKETS + static_cast<size_t>((valueNs >> shift) & (SUB_BUCKETS - 1));
+        }
+
+        /**
+         * @brief Get the largest value of a bucket
+         * @param index The bucket index
+         * @return The upper bound in nanoseconds
+         */
+        static uint64_t bucketUpperBound(size_t index) noexcept;
+
+    private:
+        std::array<std::atomic<uint64_t>, BUCKETS> buckets_{};
+        std::atomic<uint64_t> total_{0};
+        std::atomic<uint64_t> max_{0};
+    };
+}
+
+#endif //MEX_HAL_CALLBACK_HISTOGRAM_H
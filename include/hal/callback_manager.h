@@ -2,26 +2,178 @@
 #define MEX_HAL_CALLBACK_MANAGER_H
 
 #include "types.h"
+#include "callback_histogram.h"
+#include "gpio_event_queue.h"
+#include "resource_manager.h"
+#include <array>
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
-#include <shared_mutex>
 
 namespace mex_hal
 {
+    /// @brief Where a registered callback runs \struct CallbackSchedule
+    struct CallbackSchedule
+    {
+        int32_t priority = -1;  // -1 = on the thread that raised the event, 0..99 = executor priority band
+        int32_t cpu = -1;       // preferred worker CPU within the band, -1 = any
+        uint32_t budgetUs = 0;  // execution time budget, longer runs count as overruns, 0 = unbounded
+    };
+
+    /// @brief Executor worker thread configuration \struct CallbackWorkerConfig
+    struct CallbackWorkerConfig
+    {
+        int32_t priority = 0;           // 0 = SCHED_OTHER, 1..99 = SCHED_FIFO, also the lowest callback priority served
+        int32_t cpu = -1;               // -1 = no CPU affinity
+        size_t queueCapacity = 1024;    // rounded up to a power of two
+    };
+
+    /// @brief Executor worker counters \struct CallbackWorkerStats
+    struct CallbackWorkerStats
+    {
+        uint64_t executed = 0;          // callbacks run by the worker
+        uint64_t dropped = 0;           // events lost because the queue was full
+        size_t queued = 0;              // events waiting to run
+        bool scheduleApplied = false;   // the priority and affinity were accepted by the system
+    };
+
+    /// @brief Kind of peripheral event published on the event bus \enum HALEventKind
+    enum class HALEventKind : uint8_t
+    {
+        TRANSFER_COMPLETE,  // SPI or I2C transfer finished, value = bytes
+        DATA_RECEIVED,      // UART bytes read, value = bytes
+        DATA_SENT,          // UART bytes written, value = bytes
+        SAMPLE,             // ADC conversion, value = raw sample
+        OUTPUT_CHANGED,     // PWM configuration changed, value = duty cycle in ns
+        IO_ERROR            // the operation failed, value = bytes requested
+    };
+
+    /// @brief Peripheral event, plain data so executor queues can hold it \struct HALEvent
+    struct HALEvent
+    {
+        ResourceType type = ResourceType::GPIO_PIN;
+        uint64_t source = 0;            // resource id of the publishing device
+        HALEventKind kind = HALEventKind::TRANSFER_COMPLETE;
+        uint32_t channel = 0;           // ADC or PWM channel, I2C address, 0 otherwise
+        uint64_t value = 0;
+        uint64_t timestampNs = 0;       // CLOCK_MONOTONIC time of the event
+    };
+
+    using EventCallback = InplaceFunction<void(const HALEvent&)>;
+
+    /// @brief Event bus subscription key, source ANY_SOURCE matches every device of the type \struct EventKey
+    struct EventKey
+    {
+        static constexpr uint64_t ANY_SOURCE = 0;
+
+        ResourceType type = ResourceType::GPIO_PIN;
+        uint64_t source = ANY_SOURCE;
+
+        bool operator<(const EventKey& other) const
+        {
+            return type != other.type ? type < other.type : source < other.source;
+        }
+
+        bool operator==(const EventKey& other) const
+        {
+            return type == other.type && source == other.source;
+        }
+
+        bool operator!=(const EventKey& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /// @brief Accumulation bounds of a batch subscription \struct BatchConfig
+    struct BatchConfig
+    {
+        size_t maxEvents = 64;          // a full batch is delivered by the thread adding the last event, or after an in-flight delivery
+        uint32_t maxDelayUs = 1000;     // age of the oldest event before delivery, 0 = deliver every event at once
+    };
+
+    using GPIOBatchCallback = InplaceFunction<void(const GPIOEdgeEvent* events, size_t count)>;
+    using EventBatchCallback = InplaceFunction<void(const HALEvent* events, size_t count)>;
+
+    /// @brief Source of the events a callback is registered for \enum CallbackKind
+    enum class CallbackKind : uint8_t
+    {
+        GPIO,
+        TIMER,
+        EVENT
+    };
+
+    /// @brief Dispatch latency and execution time of one callback \struct CallbackProfile
+    struct CallbackProfile
+    {
+        uint64_t callbackId = 0;
+        CallbackKind kind = CallbackKind::GPIO;
+        ResourceType resourceType = ResourceType::GPIO_PIN;    // the subscribed type of an event callback
+        uint64_t source = 0;            // the GPIO pin, timer id or subscribed resource id
+        HistogramSummary latency;       // from the event to the start of the callback
+        HistogramSummary execution;     // run time of the callback
+        uint64_t overruns = 0;          // runs longer than the budget of the callback's schedule
+    };
+
     /**
      * @brief Thread-safe callback manager for handling asynchronous events
      * 
      * Provides thread-safe registration, unregistration, and invocation
      * of callbacks for various HAL events (interrupts, timers, etc.)
+     *
+     * Invocation reads an immutable snapshot of the per-pin and per-timer lists
+     * that registration rebuilds and publishes with one atomic pointer swap, in
+     * the manner of RCU. A dispatch takes no lock and allocates nothing: it marks
+     * its thread's reader slot, loads the snapshot pointer, calls the callbacks
+     * in place and clears the slot. Replaced snapshots are retired and freed by a
+     * later registration once no reader slot is marked. A dispatch that already
+     * loaded a snapshot may still run a callback that was unregistered meanwhile.
+     *
+     * An optional executor moves callbacks off the I/O threads. Each worker thread
+     * has its own priority and CPU and a bounded lock-free queue; a callback
+     * registered with a priority runs on the worker of its band, the worker with
+     * the highest priority not above it, preferring a worker on the requested CPU.
+     * Dispatch then only appends the callback and event to that queue, so a slow
+     * logging callback never delays a safety callback of a higher band, nor the next
+     * edge. Callbacks without a priority, or without a matching worker, run on the
+     * thread that raised the event.
+     *
+     * Peripheral events share the same engine. SPI, I2C, UART, ADC and PWM devices
+     * publish a HALEvent keyed by their resource type and id; a subscriber registers
+     * for one device or, with EventKey::ANY_SOURCE, for every device of a type, so a
+     * single callback or executor band serves any number of sources without a thread
+     * each. Publishing costs the same for every type: a lookup in a sorted snapshot
+     * that returns before reading the clock when nobody listens.
+     *
+     * High-rate sources can be consumed in batches instead. A batch subscription
+     * collects the events of a pin or event key in a buffer and delivers them as
+     * one array once BatchConfig::maxEvents have accumulated, on the thread adding
+     * the last one, or once the oldest is BatchConfig::maxDelayUs old, on a shared
+     * flush thread. A delay of 0 delivers every event at once. Deliveries of one
+     * subscription never overlap and keep the event order. Producers never wait
+     * for the subscriber: while a delivery is in flight, the delivering thread
+     * picks the next full batch up, and events beyond a full batch are dropped
+     * and counted by getBatchDrops().
+     *
+     * Built with HAL_CALLBACK_PROFILING, every callback records the latency from its
+     * event to its start and its execution time in lock-free histograms. Without the
+     * flag the dispatch path reads no clock and the profile queries return nothing.
      */
     class CallbackManager
     {
     public:
+#ifdef HAL_CALLBACK_PROFILING
+        static constexpr bool PROFILING_ENABLED = true;
+#else
+        static constexpr bool PROFILING_ENABLED = false;
+#endif
+
         /**
          * @brief Get singleton instance
          */
@@ -35,6 +187,25 @@ namespace mex_hal
          */
         uint64_t registerGPIOCallback(uint8_t pin, InterruptCallback callback);
 
+        /**
+         * @brief Register a GPIO interrupt callback with its own schedule
+         * @param pin GPIO pin number
+         * @param callback Callback function
+         * @param schedule The executor band the callback runs on
+         * @return Callback ID for future reference
+         */
+        uint64_t registerGPIOCallback(uint8_t pin, InterruptCallback callback, const CallbackSchedule& schedule);
+
+        /**
+         * @brief Set the schedule of later registrations for a pin that do not pass one
+         *
+         * GPIO backends register the callbacks of setInterrupt() without a schedule,
+         * this selects their band.
+         * @param pin GPIO pin number
+         * @param schedule The executor band
+         */
+        void setGPIOCallbackSchedule(uint8_t pin, const CallbackSchedule& schedule);
+
         /**
          * @brief Unregister a GPIO interrupt callback
          * @param callbackId Callback ID returned from register
@@ -49,6 +220,15 @@ namespace mex_hal
          */
         void invokeGPIOCallback(uint8_t pin, PinValue value);
 
+        /**
+         * @brief Invoke GPIO interrupt callback for an event detected earlier
+         * @param pin GPIO pin number
+         * @param value Pin value
+         * @param eventNs CLOCK_MONOTONIC time of the event in nanoseconds, the start of the dispatch latency
+         * @param coalesced Earlier edges a COALESCE rate limit folded into this one, passed on to batch subscribers
+         */
+        void invokeGPIOCallback(uint8_t pin, PinValue value, uint64_t eventNs, uint32_t coalesced = 0);
+
         /**
          * @brief Register a timer callback
          * @param timerId Timer identifier
@@ -57,6 +237,15 @@ namespace mex_hal
          */
         uint64_t registerTimerCallback(uint32_t timerId, TimerCallback callback);
 
+        /**
+         * @brief Register a timer callback with its own schedule
+         * @param timerId Timer identifier
+         * @param callback Callback function
+         * @param schedule The executor band the callback runs on
+         * @return Callback ID for future reference
+         */
+        uint64_t registerTimerCallback(uint32_t timerId, TimerCallback callback, const CallbackSchedule& schedule);
+
         /**
          * @brief Unregister a timer callback
          * @param callbackId Callback ID returned from register
@@ -71,10 +260,148 @@ namespace mex_hal
         void invokeTimerCallback(uint32_t timerId);
 
         /**
-         * @brief Clear all callbacks
+         * @brief Invoke timer callback for an expiry detected earlier
+         * @param timerId Timer identifier
+         * @param eventNs CLOCK_MONOTONIC time of the expiry in nanoseconds, the start of the dispatch latency
+         */
+        void invokeTimerCallback(uint32_t timerId, uint64_t eventNs);
+
+        /**
+         * @brief Subscribe to the events of a device, or of every device of a type
+         * @param type The resource type of the publishing devices
+         * @param source The resource id of the device, EventKey::ANY_SOURCE for all of the type
+         * @param callback Callback function
+         * @return Callback ID for future reference
+         */
+        uint64_t registerEventCallback(ResourceType type, uint64_t source, EventCallback callback);
+
+        /**
+         * @brief Subscribe to the events of a device with its own schedule
+         * @param type The resource type of the publishing devices
+         * @param source The resource id of the device, EventKey::ANY_SOURCE for all of the type
+         * @param callback Callback function
+         * @param schedule The executor band the callback runs on
+         * @return Callback ID for future reference
+         */
+        uint64_t registerEventCallback(ResourceType type, uint64_t source, EventCallback callback,
+                                       const CallbackSchedule& schedule);
+
+        /**
+         * @brief Unsubscribe an event callback
+         * @param callbackId Callback ID returned from register
+         * @return true if successful
+         */
+        bool unregisterEventCallback(uint64_t callbackId);
+
+        /**
+         * @brief Publish a peripheral event to the subscribers of its device and type
+         * @param type The resource type of the publishing device
+         * @param source The resource id of the publishing device
+         * @param kind What happened
+         * @param value Event value, see HALEventKind
+         * @param channel Channel or address within the device
+         */
+        void publishEvent(ResourceType type, uint64_t source, HALEventKind kind, uint64_t value = 0,
+                          uint32_t channel = 0);
+
+        /**
+         * @brief Register a batch subscription to the edges of a GPIO pin
+         * @param pin GPIO pin number
+         * @param callback Receives the accumulated edges, oldest first
+         * @param config The batch size and delay bounds
+         * @param schedule The executor band the edges are collected on, its budget bounds each delivery
+         * @return Callback ID, unregistered with unregisterGPIOCallback()
+         */
+        uint64_t registerGPIOBatchCallback(uint8_t pin, GPIOBatchCallback callback, const BatchConfig& config,
+                                           const CallbackSchedule& schedule = CallbackSchedule{});
+
+        /**
+         * @brief Register a batch subscription to the events of a device, or of every device of a type
+         * @param type The resource type of the publishing devices
+         * @param source The resource id of the device, EventKey::ANY_SOURCE for all of the type
+         * @param callback Receives the accumulated events, oldest first
+         * @param config The batch size and delay bounds
+         * @param schedule The executor band the events are collected on, its budget bounds each delivery
+         * @return Callback ID, unregistered with unregisterEventCallback()
+         */
+        uint64_t registerEventBatchCallback(ResourceType type, uint64_t source, EventBatchCallback callback,
+                                            const BatchConfig& config,
+                                            const CallbackSchedule& schedule = CallbackSchedule{});
+
+        /**
+         * @brief Deliver the pending events of every batch subscription now, on the calling thread
+         */
+        void flushBatches();
+
+        /**
+         * @brief Clear all callbacks and pin schedules, a running executor keeps running
          */
         void clearAll();
 
+        /**
+         * @brief Start the executor worker threads
+         * @param workers One entry per worker thread
+         * @return A true if every configuration is valid and the workers started, false otherwise
+         */
+        bool startExecutor(const std::vector<CallbackWorkerConfig>& workers);
+
+        /**
+         * @brief Run the queued callbacks and stop the workers, not from within a callback
+         *
+         * Callbacks of a priority band run on their event thread again afterwards.
+         */
+        void stopExecutor();
+
+        /**
+         * @brief Get the number of running executor workers
+         * @return The worker count, 0 if the executor is stopped
+         */
+        [[nodiscard]] size_t getExecutorWorkerCount() const;
+
+        /**
+         * @brief Get the counters of an executor worker
+         * @param worker The worker index, in the order passed to startExecutor()
+         * @return The counters, all zero for an invalid index
+         */
+        [[nodiscard]] CallbackWorkerStats getExecutorStats(size_t worker) const;
+
+        /**
+         * @brief Get the profiles of all registered callbacks
+         * @return One profile per callback, empty without HAL_CALLBACK_PROFILING
+         */
+        [[nodiscard]] std::vector<CallbackProfile> getCallbackProfiles() const;
+
+        /**
+         * @brief Get the profile of one callback
+         * @param callbackId Callback ID returned from register
+         * @param profile Receives the profile
+         * @return A true if the callback is registered and profiling is built in, false otherwise
+         */
+        bool getCallbackProfile(uint64_t callbackId, CallbackProfile& profile) const;
+
+        /**
+         * @brief Clear the histograms and overrun counters of all registered callbacks
+         */
+        void resetCallbackProfiles();
+
+        /**
+         * @brief Get the number of runs of a callback that exceeded its execution budget
+         *
+         * Counted with or without HAL_CALLBACK_PROFILING, a callback without a budget never overruns.
+         * @param callbackId Callback ID returned from register
+         * @return The overrun count, 0 for an unknown callback
+         */
+        [[nodiscard]] uint64_t getCallbackOverruns(uint64_t callbackId) const;
+
+        /**
+         * @brief Get the number of events a batch subscription dropped because its buffer was full
+         *
+         * Drops are counted when the batch they did not fit into is delivered.
+         * @param callbackId Callback ID returned from a batch register
+         * @return The drop count, 0 for an unknown or non-batch callback
+         */
+        [[nodiscard]] uint64_t getBatchDrops(uint64_t callbackId) const;
+
         // Prevent copying and assignment
         CallbackManager(const CallbackManager&) = delete;
         CallbackManager& operator=(const CallbackManager&) = delete;
@@ -82,32 +409,217 @@ namespace mex_hal
         CallbackManager& operator=(CallbackManager&&) = delete;
 
     private:
-        CallbackManager() = default;
-        ~CallbackManager() = default;
+        CallbackManager();
+        ~CallbackManager();
+
+        // Threads are spread over the slots, a shared slot only costs contention
+        static constexpr size_t READER_SLOTS = 32;
+
+        /// @brief Dispatch-in-progress counter on its own cache line \struct ReaderSlot
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<uint32_t> active{0};
+        };
 
-        /// @brief GPIO Callback Info struct \struct GPIOCallbackInfo
-        struct GPIOCallbackInfo
+        /// @brief Marks the calling thread's reader slot for the lifetime of a dispatch \class ReadGuard
+        class ReadGuard
         {
-            uint8_t pin;
-            InterruptCallback callback;
+        public:
+            explicit ReadGuard(ReaderSlot& slot);
+            ~ReadGuard();
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+        private:
+            ReaderSlot& slot_;
         };
 
-        /// @brief Timer Callback Info struct \struct TimerCallbackInfo
-        struct TimerCallbackInfo
+        class Worker;
+        class Batch;
+        template <typename Event, typename Callback>
+        class EventBatch;
+
+        /// @brief Registered callback, shared by the snapshots and queued events \struct Target
+        template <typename Callback, typename Key>
+        struct Target
         {
-            uint32_t timerId;
-            TimerCallback callback;
+            Callback callback;
+            Key key;
+            uint64_t budgetNs = 0;
+            mutable std::atomic<uint64_t> overruns{0};
+#ifdef HAL_CALLBACK_PROFILING
+            bool profiled = true;   // batch collectors are profiled per delivered batch instead
+            mutable CallbackHistogram latency;
+            mutable CallbackHistogram execution;
+#endif
         };
 
-        // Use shared_mutex for read-heavy scenarios (callback invocation is more frequent than registration)
-        mutable std::shared_mutex gpioCallbackMutex_;
-        mutable std::shared_mutex timerCallbackMutex_;
+        using GPIOTarget = Target<InterruptCallback, uint8_t>;
+        using TimerTarget = Target<TimerCallback, uint32_t>;
+        using EventTarget = Target<EventCallback, EventKey>;
+
+        /// @brief Callback in a snapshot \struct Entry
+        template <typename T>
+        struct Entry
+        {
+            uint64_t id;
+            std::shared_ptr<const T> target;
+            CallbackSchedule schedule;
+            Worker* worker;     // nullptr runs the callback on the event thread
+        };
+
+        /// @brief Immutable GPIO dispatch table, indexed by pin \struct GPIOSnapshot
+        struct GPIOSnapshot
+        {
+            std::array<std::vector<Entry<GPIOTarget>>, 256> byPin;
+        };
+
+        /// @brief Immutable dispatch table, sorted by key \struct KeyedSnapshot
+        template <typename Key, typename T>
+        struct KeyedSnapshot
+        {
+            std::vector<std::pair<Key, std::vector<Entry<T>>>> byKey;
+        };
+
+        using TimerSnapshot = KeyedSnapshot<uint32_t, TimerTarget>;
+        using EventSnapshot = KeyedSnapshot<EventKey, EventTarget>;
+
+        /**
+         * @brief Get the reader slot of the calling thread
+         * @return The slot
+         */
+        ReaderSlot& readerSlot();
+
+        /**
+         * @brief Publish a snapshot and retire the previous one, registrationMutex_ must be held
+         * @param current The published snapshot pointer
+         * @param retired The retired snapshots of the table
+         * @param snapshot The new snapshot
+         */
+        template <typename Snapshot>
+        void publish(std::atomic<const Snapshot*>& current, std::vector<std::unique_ptr<const Snapshot>>& retired,
+                     std::unique_ptr<Snapshot> snapshot);
+
+        /**
+         * @brief Add a callback to a keyed table, registrationMutex_ must be held
+         * @param current The published snapshot pointer
+         * @param retired The retired snapshots of the table
+         * @param targets The registered callbacks of the table
+         * @param key The key the callback listens to
+         * @param callback Callback function
+         * @param schedule The executor band the callback runs on
+         * @param profiled A false for batch collectors, which are profiled and budgeted per batch
+         * @return Callback ID for future reference
+         */
+        template <typename Key, typename T, typename Callback>
+        uint64_t registerKeyed(std::atomic<const KeyedSnapshot<Key, T>*>& current,
+                               std::vector<std::unique_ptr<const KeyedSnapshot<Key, T>>>& retired,
+                               std::unordered_map<uint64_t, std::shared_ptr<const T>>& targets, const Key& key,
+                               Callback callback, const CallbackSchedule& schedule, bool profiled);
+
+        /**
+         * @brief Add a GPIO callback
+         * @param pin GPIO pin number
+         * @param callback Callback function
+         * @param schedule The executor band the callback runs on
+         * @param profiled A false for batch collectors, which are profiled and budgeted per batch
+         * @return Callback ID for future reference
+         */
+        uint64_t registerGPIOTarget(uint8_t pin, InterruptCallback callback, const CallbackSchedule& schedule,
+                                    bool profiled);
+
+        /**
+         * @brief Replace the histograms and overrun count of a batch subscription's collector with those of its batches
+         * @param profile The profile of the collector
+         */
+        void summarizeBatch(CallbackProfile& profile) const;
+
+        /**
+         * @brief Remove a callback from a keyed table, registrationMutex_ must be held
+         * @param current The published snapshot pointer
+         * @param retired The retired snapshots of the table
+         * @param targets The registered callbacks of the table
+         * @param callbackId Callback ID returned from register
+         * @return A true if the callback was registered in the table, false otherwise
+         */
+        template <typename Key, typename T>
+        bool unregisterKeyed(std::atomic<const KeyedSnapshot<Key, T>*>& current,
+                             std::vector<std::unique_ptr<const KeyedSnapshot<Key, T>>>& retired,
+                             std::unordered_map<uint64_t, std::shared_ptr<const T>>& targets, uint64_t callbackId);
+
+        /**
+         * @brief Free retired snapshots if no dispatch is in progress, registrationMutex_ must be held
+         */
+        void reclaim();
+
+        /**
+         * @brief Select the worker of a schedule, registrationMutex_ must be held
+         * @param schedule The schedule
+         * @return The worker, nullptr to run on the event thread
+         */
+        Worker* selectWorker(const CallbackSchedule& schedule) const;
+
+        /**
+         * @brief Republish all snapshots with the workers selected again, registrationMutex_ must be held
+         */
+        void rebindWorkers();
+
+        /**
+         * @brief Wait until every dispatch that started before the call has finished
+         */
+        void waitForReaders() const;
+
+        /**
+         * @brief Track a batch subscription, starting the flush thread for the first one with a delay
+         * @param callbackId The callback ID of its collecting callback
+         * @param batch The subscription
+         */
+        void addBatch(uint64_t callbackId, std::shared_ptr<Batch> batch);
+
+        /**
+         * @brief Stop tracking a batch subscription and deliver its pending events
+         * @param callbackId The callback ID of its collecting callback
+         */
+        void removeBatch(uint64_t callbackId);
+
+        /**
+         * @brief Wake the flush thread if a new batch expires before its next wake-up
+         * @param deadlineNs The CLOCK_MONOTONIC expiry of the new batch in nanoseconds
+         */
+        void scheduleFlush(uint64_t deadlineNs);
+
+        /**
+         * @brief Flush thread body, delivers expired batches
+         */
+        void runFlusher();
+
+        std::atomic<const GPIOSnapshot*> gpioSnapshot_;
+        std::atomic<const TimerSnapshot*> timerSnapshot_;
+        std::atomic<const EventSnapshot*> eventSnapshot_;
+        std::array<ReaderSlot, READER_SLOTS> readerSlots_;
+        std::atomic<size_t> nextReaderSlot_{0};
+
+        // Serializes registration, the maps are the source the snapshots are built from
+        mutable std::mutex registrationMutex_;
+        std::unordered_map<uint64_t, std::shared_ptr<const GPIOTarget>> gpioTargets_;
+        std::unordered_map<uint64_t, std::shared_ptr<const TimerTarget>> timerTargets_;
+        std::unordered_map<uint64_t, std::shared_ptr<const EventTarget>> eventTargets_;
+        std::vector<std::unique_ptr<const GPIOSnapshot>> retiredGpio_;
+        std::vector<std::unique_ptr<const TimerSnapshot>> retiredTimer_;
+        std::vector<std::unique_ptr<const EventSnapshot>> retiredEvent_;
+        std::array<CallbackSchedule, 256> pinSchedules_{};
+        std::vector<std::unique_ptr<Worker>> workers_;
 
-        std::unordered_map<uint64_t, GPIOCallbackInfo> gpioCallbacks_;
-        std::unordered_map<uint8_t, std::vector<uint64_t>> gpioCallbacksByPin_;
+        // Serializes executor start and stop, which wait for readers outside registrationMutex_
+        std::mutex executorMutex_;
 
-        std::unordered_map<uint64_t, TimerCallbackInfo> timerCallbacks_;
-        std::unordered_map<uint32_t, std::vector<uint64_t>> timerCallbacksById_;
+        // Batch subscriptions with a delay bound and the thread delivering them once expired
+        mutable std::mutex batchMutex_;
+        std::condition_variable batchWakeup_;
+        std::unordered_map<uint64_t, std::shared_ptr<Batch>> batches_;
+        std::atomic<uint64_t> nextFlushNs_{UINT64_MAX};
+        bool flusherStop_ = false;
+        std::thread flusherThread_;
 
         std::atomic<uint64_t> nextCallbackId_{1};
     };
@@ -16,6 +16,13 @@ namespace mex_hal
         INVALID
     };
 
+    /// @brief GPIO backend enumeration \enum GPIOBackend
+    enum class GPIOBackend
+    {
+        SYSFS,
+        CDEV
+    };
+
     /// @brief Real-time scheduling policies enumeration \enum RealTimePolicy
     enum class RealTimePolicy
     {
@@ -88,7 +95,38 @@ namespace mex_hal
 
         /// @brief Create GPIO interface
         virtual std::unique_ptr<GPIOInterface> createGPIO() = 0;
+
+        /**
+         * @brief Create GPIO interface on a specific kernel backend
+         * @param backend SYSFS for /sys/class/gpio, CDEV for the /dev/gpiochip0 character device
+         * @return A GPIO interface instance
+         */
+        virtual std::unique_ptr<GPIOInterface> createGPIO(GPIOBackend backend) = 0;
+
+        /**
+         * @brief Bit-bang SPI on GPIO lines when the board has no spidev bus
+         * @param pins The SCLK, MOSI, MISO and chip select lines
+         * @param backend The GPIO backend, CDEV moves a clock edge and its data with one ioctl
+         */
+        virtual void setSoftSPIPins(const SoftSPIPins& pins, GPIOBackend backend = GPIOBackend::CDEV) = 0;
+
+        /**
+         * @brief Bit-bang I2C on GPIO lines when the board has no i2c-dev bus
+         * @param pins The SCL and SDA lines
+         * @param backend The GPIO backend driving the lines
+         */
+        virtual void setSoftI2CPins(const SoftI2CPins& pins, GPIOBackend backend = GPIOBackend::CDEV) = 0;
+
+        /**
+         * @brief Create SPI interface
+         * @return The spidev implementation, or the bit-banged one if soft pins are set and no spidev node exists
+         */
         virtual std::unique_ptr<SPIInterface> createSPI() = 0;
+
+        /**
+         * @brief Create I2C interface
+         * @return The i2c-dev implementation, or the bit-banged one if soft pins are set and no i2c-dev node exists
+         */
         virtual std::unique_ptr<I2CInterface> createI2C() = 0;
         virtual std::unique_ptr<UARTInterface> createUART() = 0;
         virtual std::unique_ptr<PWMInterface> createPWM() = 0;
@@ -2,6 +2,7 @@
 #define MEX_HAL_GPIO_H
 
 #include "types.h"
+#include "gpio_event_queue.h"
 #include <functional>
 
 /// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
@@ -33,12 +34,49 @@ namespace mex_hal
         virtual bool write(uint8_t pin, PinValue value) = 0;
 
         /**
-         * @brief Read the value of a GPIO pin
+         * @brief Read the value of a GPIO pin, outputs are served from the last written value
          * @param pin The GPIO pin number
          * @return The current value of the pin (HIGH or LOW)
          */
         virtual PinValue read(uint8_t pin) = 0;
 
+        /**
+         * @brief Read the level of a GPIO pin from hardware, bypassing the output shadow
+         * @param pin The GPIO pin number
+         * @return The current value of the pin (HIGH or LOW)
+         */
+        virtual PinValue readback(uint8_t pin) = 0;
+
+        /**
+         * @brief Invert an output pin from its shadow value with a single write
+         * @param pin The GPIO pin number
+         * @return A true if the pin was toggled, false if it is not a configured output
+         */
+        virtual bool toggle(uint8_t pin) = 0;
+
+        /**
+         * @brief Set the direction of several GPIO pins as one batch
+         * @param mask The pins to configure
+         * @param direction The direction to set (INPUT or OUTPUT)
+         * @return A true if every selected pin was configured, false otherwise
+         */
+        virtual bool setDirectionMask(const PinMask& mask, PinDirection direction) = 0;
+
+        /**
+         * @brief Write several GPIO pins as one batch
+         * @param mask The pins to update
+         * @param values The values for the selected pins (set bit = HIGH)
+         * @return A true if all selected pins were written, false otherwise
+         */
+        virtual bool writeMask(const PinMask& mask, const PinMask& values) = 0;
+
+        /**
+         * @brief Read several GPIO pins as one batch
+         * @param mask The pins to sample
+         * @return The sampled values, bits outside mask are cleared (set bit = HIGH)
+         */
+        virtual PinMask readMask(const PinMask& mask) = 0;
+
         /**
          * @brief Set up an interrupt on a GPIO pin
          * @param pin The GPIO pin number
@@ -48,6 +86,30 @@ namespace mex_hal
          */
         virtual bool setInterrupt(uint8_t pin, EdgeTrigger edge, InterruptCallback callback) = 0;
 
+        /**
+         * @brief Set up a rate limited interrupt on a GPIO pin
+         * @param pin The GPIO pin number
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @param callback The callback function to invoke on interrupt
+         * @param limit The maximum edge rate and the handling of excess edges
+         * @return A true if the interrupt was successfully set, false otherwise
+         */
+        virtual bool setInterrupt(uint8_t pin, EdgeTrigger edge, InterruptCallback callback, const EdgeRateLimit& limit) = 0;
+
+        /**
+         * @brief Get the rate limit counters of a GPIO pin, e.g. how often it stormed
+         * @param pin The GPIO pin number
+         * @return The counters since the interrupt was last set
+         */
+        [[nodiscard]] virtual EdgeRateStats getEdgeRateStats(uint8_t pin) const = 0;
+
+        /**
+         * @brief Get the ResourceManager ID of a GPIO pin, e.g. to record a dependency on it
+         * @param pin The GPIO pin number
+         * @return The resource ID, 0 if the pin is not in use
+         */
+        [[nodiscard]] virtual uint64_t getResourceId(uint8_t pin) const = 0;
+
         /**
          * @brief Remove an interrupt from a GPIO pin
          * @param pin The GPIO pin number
@@ -55,6 +117,20 @@ namespace mex_hal
          */
         virtual bool removeInterrupt(uint8_t pin) = 0;
 
+        /**
+         * @brief Set up edge detection on a GPIO pin that feeds the edge event queue instead of a callback
+         * @param pin The GPIO pin number
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @return A true if edge events were enabled, false otherwise; removeInterrupt() disables them
+         */
+        virtual bool enableEdgeEvents(uint8_t pin, EdgeTrigger edge) = 0;
+
+        /**
+         * @brief Get the timestamped edge event queue of this controller
+         * @return The queue, may be drained from any number of threads
+         */
+        virtual GPIOEventQueue& getEdgeEventQueue() = 0;
+
         /**
          * @brief Set debounce time for a GPIO pin
          * @param pin The GPIO pin number
@@ -63,10 +139,26 @@ namespace mex_hal
          */
         virtual bool setDebounce(uint8_t pin, uint32_t debounceTimeMs) = 0;
 
+        /**
+         * @brief Set the scheduling priority of the interrupt dispatch thread
+         * @param priority 0 for SCHED_OTHER, otherwise the SCHED_FIFO priority
+         * @return A true if the priority is valid and was applied, false otherwise
+         */
+        virtual bool setInterruptThreadPriority(int32_t priority) = 0;
+
+        /**
+         * @brief Pin the interrupt dispatch thread to a CPU
+         * @param cpu The CPU index, -1 to allow all CPUs
+         * @return A true if the affinity is valid and was applied, false otherwise
+         */
+        virtual bool setInterruptThreadAffinity(int32_t cpu) = 0;
+
     protected:
+        inline static const std::string SYS_CLASS_GPIO_ROOT = "/sys/class/gpio";
         inline static const std::string SYS_CLASS_GPIO = "/sys/class/gpio/gpio";
         inline static const std::string SYS_CLASS_GPIO_EXPORT = "/sys/class/gpio/export";
         inline static const std::string SYS_CLASS_GPIO_UNEXPORT = "/sys/class/gpio/unexport";
+        inline static const std::string DEV_GPIOCHIP = "/dev/gpiochip";
     };
 }
 
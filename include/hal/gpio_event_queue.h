@@ -0,0 +1,108 @@
+#ifndef MEX_HAL_GPIO_EVENT_QUEUE_H
+#define MEX_HAL_GPIO_EVENT_QUEUE_H
+
+#include "types.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /// @brief Timestamped GPIO edge record \struct GPIOEdgeEvent
+    struct GPIOEdgeEvent
+    {
+        uint8_t pin = 0;
+        PinValue value = PinValue::LOW;
+        uint64_t timestampNs = 0;   // CLOCK_MONOTONIC
+        uint64_t sequence = 0;      // per-queue edge counter, gaps mark dropped events
+        uint32_t coalesced = 0;     // earlier edges folded into this one by a COALESCE rate limit
+    };
+
+    /**
+     * @brief Bounded single-producer/multi-consumer lock-free ring of GPIO edge events
+     *
+     * The GPIO dispatch thread is the only producer. Any number of threads may drain
+     * the queue concurrently, every event is delivered to exactly one consumer.
+     * When the ring is full the newest event is dropped and counted, so the producer
+     * never blocks.
+     */
+    class GPIOEventQueue
+    {
+    public:
+        static constexpr size_t DEFAULT_CAPACITY = 1024;
+
+        /**
+         * @brief Constructor
+         * @param capacity The number of slots, rounded up to a power of two
+         */
+        explicit GPIOEventQueue(size_t capacity = DEFAULT_CAPACITY);
+
+        /// @brief Prevent copying, producers and consumers hold references
+        GPIOEventQueue(const GPIOEventQueue&) = delete;
+        GPIOEventQueue& operator=(const GPIOEventQueue&) = delete;
+
+        /**
+         * @brief Append an edge event, producer thread only
+         * @param pin The GPIO pin number
+         * @param value The pin value after the edge
+         * @param timestampNs The CLOCK_MONOTONIC timestamp of the edge in nanoseconds
+         * @param coalesced The number of earlier edges the rate limiter folded into this one
+         * @return A true if the event was queued, false if it was dropped on overflow
+         */
+        bool push(uint8_t pin, PinValue value, uint64_t timestampNs, uint32_t coalesced = 0) noexcept;
+
+        /**
+         * @brief Remove up to maxEvents events in one batch
+         * @param events The output buffer
+         * @param maxEvents The capacity of the output buffer
+         * @return The number of events written to the buffer
+         */
+        size_t drain(GPIOEdgeEvent* events, size_t maxEvents) noexcept;
+
+        /**
+         * @brief Remove a single event
+         * @param event The event to populate
+         * @return A true if an event was removed, false if the queue was empty
+         */
+        bool pop(GPIOEdgeEvent& event) noexcept;
+
+        /**
+         * @brief Get the approximate number of queued events
+         * @return The number of events not yet drained
+         */
+        [[nodiscard]] size_t size() const noexcept;
+
+        /**
+         * @brief Get the number of slots
+         * @return The queue capacity
+         */
+        [[nodiscard]] size_t capacity() const noexcept;
+
+        /**
+         * @brief Get the number of events dropped because the queue was full
+         * @return The overflow count
+         */
+        [[nodiscard]] uint64_t getOverflowCount() const noexcept;
+
+    private:
+        /// @brief Ring slot, turn tells producer and consumers whose move it is \struct Cell
+        struct Cell
+        {
+            std::atomic<uint64_t> turn{0};
+            GPIOEdgeEvent event;
+        };
+
+        std::unique_ptr<Cell[]> cells_;
+        size_t mask_;
+
+        // Consumers and the producer advance on separate cache lines
+        alignas(64) std::atomic<uint64_t> head_{0};
+        alignas(64) std::atomic<uint64_t> tail_{0};
+        uint64_t sequence_ = 0;
+        std::atomic<uint64_t> overflowCount_{0};
+    };
+}
+
+#endif //MEX_HAL_GPIO_EVENT_QUEUE_H
@@ -0,0 +1,164 @@
+#ifndef MEX_HAL_GPIO_PATTERN_PLAYER_H
+#define MEX_HAL_GPIO_PATTERN_PLAYER_H
+
+#include "gpio.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /// @brief One step of a GPIO pattern, applied with a single writeMask() \struct GPIOPatternStep
+    struct GPIOPatternStep
+    {
+        uint64_t timeOffsetNs = 0;  // from the start of the cycle
+        PinMask mask;               // pins changed by this step
+        PinMask values;             // levels of the selected pins (set bit = HIGH)
+    };
+
+    /// @brief Lateness of one pattern step over all plays \struct GPIOPatternStepStats
+    struct GPIOPatternStepStats
+    {
+        uint64_t plays = 0;
+        uint64_t meanLatenessNs = 0;
+        uint64_t maxLatenessNs = 0;
+    };
+
+    /// @brief Aggregate statistics of a pattern player \struct GPIOPatternStats
+    struct GPIOPatternStats
+    {
+        uint64_t cycles = 0;            // completed passes over the pattern
+        uint64_t steps = 0;             // steps played
+        uint64_t writeErrors = 0;       // steps whose writeMask() failed
+        uint64_t meanLatenessNs = 0;
+        uint64_t maxLatenessNs = 0;
+    };
+
+    /**
+     * @brief Plays a precomputed GPIO waveform on a dedicated thread
+     *
+     * Every step is due at an absolute CLOCK_MONOTONIC deadline (start time plus
+     * cycle offset plus step offset) and is applied with one writeMask() call, so
+     * timing errors never accumulate across steps or loops. Lateness is measured
+     * from the deadline to the completion of the write. Long gaps are slept in
+     * bounded slices so stop() returns promptly; the final sleep always targets
+     * the exact deadline.
+     */
+    class GPIOPatternPlayer
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param gpio The GPIO controller driving the pattern, must outlive the player
+         */
+        explicit GPIOPatternPlayer(GPIOInterface& gpio);
+
+        /**
+         * @brief Destructor, stops playback
+         */
+        ~GPIOPatternPlayer();
+
+        /// @brief Prevent copying, the player thread references this object
+        GPIOPatternPlayer(const GPIOPatternPlayer&) = delete;
+        GPIOPatternPlayer& operator=(const GPIOPatternPlayer&) = delete;
+
+        /**
+         * @brief Load a pattern, only while stopped
+         * @param steps The steps, ordered by non-decreasing time offset
+         * @param cycleNs The length of one pass, 0 ends the cycle at the last step
+         * @return A true if the pattern is valid and was loaded, false otherwise
+         */
+        bool load(std::vector<GPIOPatternStep> steps, uint64_t cycleNs = 0);
+
+        /**
+         * @brief Start playback from the first step, resets the statistics
+         * @param loop Repeat the pattern every cycle until stop() is called
+         * @return A true if playback started, false otherwise
+         */
+        bool start(bool loop = false);
+
+        /**
+         * @brief Stop playback and join the player thread
+         * @return A true if the player was running, false otherwise
+         */
+        bool stop();
+
+        /**
+         * @brief Check if the pattern is still playing
+         * @return A true if the player thread is active, false otherwise
+         */
+        [[nodiscard]] bool isRunning() const;
+
+        /**
+         * @brief Set the scheduling priority of the player thread
+         * @param priority 0 for SCHED_OTHER, otherwise the SCHED_FIFO priority
+         * @return A true if the priority is valid and was applied, false otherwise
+         */
+        bool setThreadPriority(int32_t priority);
+
+        /**
+         * @brief Pin the player thread to a CPU
+         * @param cpu The CPU index, -1 to allow all CPUs
+         * @return A true if the affinity is valid and was applied, false otherwise
+         */
+        bool setThreadAffinity(int32_t cpu);
+
+        /**
+         * @brief Get the aggregate playback statistics since the last start()
+         * @return The statistics
+         */
+        [[nodiscard]] GPIOPatternStats getStats() const;
+
+        /**
+         * @brief Get the lateness statistics of one step since the last start()
+         * @param index The step index in the loaded pattern
+         * @return The statistics, all zero for an invalid index
+         */
+        [[nodiscard]] GPIOPatternStepStats getStepStats(size_t index) const;
+
+    private:
+        /// @brief Lateness counters of one step, written by the player thread only \struct StepCounters
+        struct StepCounters
+        {
+            std::atomic<uint64_t> plays{0};
+            std::atomic<uint64_t> totalLatenessNs{0};
+            std::atomic<uint64_t> maxLatenessNs{0};
+        };
+
+        GPIOInterface& gpio_;
+
+        // Guards the pattern, thread handle and schedule against concurrent control calls
+        mutable std::mutex controlMutex_;
+        std::vector<GPIOPatternStep> steps_;
+        std::unique_ptr<StepCounters[]> counters_;
+        uint64_t cycleNs_ = 0;
+        bool loop_ = false;
+        int32_t priority_ = 0;
+        int32_t cpu_ = -1;
+        std::thread thread_;
+
+        std::atomic<bool> running_{false};
+        std::atomic<bool> stopRequested_{false};
+        std::atomic<uint64_t> cycles_{0};
+        std::atomic<uint64_t> writeErrors_{0};
+
+        /**
+         * @brief Player thread body
+         * @param startNs The CLOCK_MONOTONIC time of the first cycle in nanoseconds
+         */
+        void playLoop(uint64_t startNs);
+
+        /**
+         * @brief Sleep until an absolute deadline or a stop request
+         * @param deadlineNs The CLOCK_MONOTONIC deadline in nanoseconds
+         * @return A true if the deadline was reached, false if stop() was requested
+         */
+        bool sleepUntil(uint64_t deadlineNs) const;
+    };
+}
+
+#endif //MEX_HAL_GPIO_PATTERN_PLAYER_H
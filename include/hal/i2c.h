@@ -63,6 +63,12 @@ namespace mex_hal
          */
         virtual bool setSpeed(uint32_t speed) = 0;
 
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] virtual uint64_t getResourceId() const = 0;
+
     protected:
         inline static const std::string SYS_CALL_I2C_ADAPTERS = "/sys/class/i2c-adapter/i2c-";
     };
@@ -0,0 +1,191 @@
+#ifndef MEX_HAL_INPLACE_FUNCTION_H
+#define MEX_HAL_INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    // Room for eight captured pointers or references
+    constexpr size_t CALLBACK_CAPACITY = 64;
+
+    template <typename Signature, size_t Capacity = CALLBACK_CAPACITY>
+    class InplaceFunction;
+
+    /**
+     * @brief Move-only callable stored in a fixed buffer inside the object, never allocates
+     *
+     * A callable whose captures exceed Capacity, or that needs a stricter alignment than
+     * std::max_align_t, is rejected at compile time. Capture large state by reference or
+     * through a pointer instead. Like std::function, calling an empty function throws
+     * std::bad_function_call.
+     */
+    template <typename R, typename... Args, size_t Capacity>
+    class InplaceFunction<R(Args...), Capacity>
+    {
+    public:
+        /**
+         * @brief Construct an empty function
+         */
+        InplaceFunction() noexcept = default;
+
+        /**
+         * @brief Construct an empty function
+         */
+        InplaceFunction(std::nullptr_t) noexcept {}
+
+        /**
+         * @brief Construct from a callable, stored in place
+         * @param callable The callable, a null function pointer gives an empty function
+         */
+        template <typename F,
+                  typename T = std::decay_t<F>,
+                  typename = std::enable_if_t<!std::is_same_v<T, InplaceFunction> &&
+                                              std::is_invocable_r_v<R, T&, Args...>>>
+        InplaceFunction(F&& callable)
+        {
+            static_assert(sizeof(T) <= Capacity,
+                          "callback captures exceed the inplace capacity, capture large state by reference");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "callback captures are over-aligned");
+            static_assert(std::is_nothrow_move_constructible_v<T>, "callback captures must be nothrow movable");
+
+            if constexpr (std::is_pointer_v<T> || std::is_member_pointer_v<T>)
+            {
+                if (callable == nullptr)
+                {
+                    return;
+                }
+            }
+
+            ::new (static_cast<void*>(&storage_)) T(std::forward<F>(callable));
+            ops_ = &opsFor<T>;
+        }
+
+        /**
+         * @brief Move constructor, the source becomes empty
+         * @param other The function to move from
+         */
+        InplaceFunction(InplaceFunction&& other) noexcept
+        {
+            moveFrom(other);
+        }
+
+        /**
+         * @brief Move assignment, the source becomes empty
+         * @param other The function to move from
+         * @return Reference to this function
+         */
+        InplaceFunction& operator=(InplaceFunction&& other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Destroy the stored callable
+         * @return Reference to this function
+         */
+        InplaceFunction& operator=(std::nullptr_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        /// @brief Prevent copying, captures may own resources
+        InplaceFunction(const InplaceFunction&) = delete;
+        InplaceFunction& operator=(const InplaceFunction&) = delete;
+
+        /**
+         * @brief Destructor
+         */
+        ~InplaceFunction()
+        {
+            reset();
+        }
+
+        /**
+         * @brief Check whether a callable is stored
+         * @return A true if the function can be called, false otherwise
+         */
+        explicit operator bool() const noexcept
+        {
+            return ops_ != nullptr;
+        }
+
+        /**
+         * @brief Call the stored callable
+         * @param args The arguments
+         * @return The result of the callable
+         */
+        R operator()(Args... args) const
+        {
+            if (ops_ == nullptr)
+            {
+                throw std::bad_function_call();
+            }
+            return ops_->invoke(&storage_, std::forward<Args>(args)...);
+        }
+
+    private:
+        /// @brief Type-erased operations of the stored callable \struct Ops
+        struct Ops
+        {
+            R (*invoke)(void* storage, Args&&... args);
+            void (*move)(void* destination, void* source) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template <typename T>
+        static constexpr Ops opsFor{
+            [](void* storage, Args&&... args) -> R {
+                return std::invoke(*static_cast<T*>(storage), std::forward<Args>(args)...);
+            },
+            [](void* destination, void* source) noexcept {
+                ::new (destination) T(std::move(*static_cast<T*>(source)));
+                static_cast<T*>(source)->~T();
+            },
+            [](void* storage) noexcept {
+                static_cast<T*>(storage)->~T();
+            }};
+
+        /**
+         * @brief Take over the callable of another function, this one must be empty
+         * @param other The function to move from
+         */
+        void moveFrom(InplaceFunction& other) noexcept
+        {
+            if (other.ops_ != nullptr)
+            {
+                other.ops_->move(&storage_, &other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+
+        /**
+         * @brief Destroy the stored callable, if any
+         */
+        void reset() noexcept
+        {
+            if (ops_ != nullptr)
+            {
+                ops_->destroy(&storage_);
+                ops_ = nullptr;
+            }
+        }
+
+        // Mutable like the target of std::function, a const function calls a non-const operator()
+        mutable std::aligned_storage_t<Capacity, alignof(std::max_align_t)> storage_;
+        const Ops* ops_ = nullptr;
+    };
+}
+
+#endif //MEX_HAL_INPLACE_FUNCTION_H
@@ -77,6 +77,12 @@ namespace mex_hal
          */
         [[nodiscard]] virtual bool isEnabled() const = 0;
 
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] virtual uint64_t getResourceId() const = 0;
+
     protected:
         inline static const std::string SYS_CLASS_PWM = "/sys/class/pwm/pwmchip";
     };
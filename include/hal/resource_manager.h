@@ -1,12 +1,16 @@
 #ifndef MEX_HAL_RESOURCE_MANAGER_H
 #define MEX_HAL_RESOURCE_MANAGER_H
 
+#include "inplace_function.h"
+#include <array>
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 #include <string>
 #include <atomic>
+#include <unordered_map>
+#include <vector>
 
 /// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
 namespace mex_hal
@@ -31,19 +35,68 @@ namespace mex_hal
      */
     struct ResourceInfo
     {
-        ResourceType type;
+        // Set in refCount when the resource is unregistered, later references fail
+        static constexpr uint32_t RETIRED = 1u << 31;
+
+        ResourceType type = ResourceType::FILE_DESCRIPTOR;
         std::string name;
-        void* handle;
+        void* handle = nullptr;
         std::atomic<uint32_t> refCount{0};
         std::atomic<bool> inUse{false};
     };
 
+    /// @brief Copy of a registered resource \struct ResourceState
+    struct ResourceState
+    {
+        uint64_t id = 0;
+        ResourceType type = ResourceType::FILE_DESCRIPTOR;
+        std::string name;
+        void* handle = nullptr;
+        uint32_t refCount = 0;
+        bool inUse = false;
+        std::vector<uint64_t> dependencies;     // copied by snapshot(), left empty by getResourceInfo()
+    };
+
+    /// @brief I/O counters of a resource, summed over all threads \struct ResourceIoStats
+    struct ResourceIoStats
+    {
+        uint64_t operations = 0;
+        uint64_t bytes = 0;
+        uint64_t errors = 0;
+        uint64_t totalLatencyNs = 0;
+        uint64_t maxLatencyNs = 0;
+    };
+
+    // Called once per resource during teardown, possibly on several threads at once
+    using ResourceReleaseCallback = InplaceFunction<void(const ResourceState& resource)>;
+
     /**
      * @brief Thread-safe resource manager with allocation tracking and reference counting
      * 
      * Implements singleton pattern for centralized resource management.
      * Provides thread-safe allocation tracking and reference counting for
      * all hardware resources used by the HAL.
+     *
+     * Resources live in a generational slot map: chunks of slots that never move,
+     * and an ID holds the slot index plus one in its low and the slot's generation
+     * in its high 32 bits. Unregistering bumps the generation, so a stale ID is
+     * detected and never reaches a later resource in the same slot.
+     *
+     * Only registration takes the lock. Reference counting by ID marks the thread's
+     * reader slot, which other threads may share, checks the generation of the
+     * indexed slot and changes the count: three atomic operations. Through a held
+     * resource (acquire(), ResourceGuard::share(), addRef(ResourceInfo&) and
+     * release(ResourceInfo&)) it is one atomic operation on the count. Plain
+     * queries only check the generation before and after reading. Unregistered slots are reused by a later registration
+     * once no reader slot is marked and no reference taken with acquire() is left.
+     *
+     * A resource may depend on others, e.g. a bit-banged bus on its GPIO pins. The
+     * edges are kept under the registration lock and never form a cycle, teardown()
+     * releases every resource after all resources that depend on it.
+     *
+     * Device I/O is counted per resource in a shard of the calling thread, only
+     * that thread writes it. getIoStats() sums the shards, so counting costs no
+     * atomic read-modify-write and no cache line shared between threads.
      */
     class ResourceManager
     {
@@ -58,10 +111,21 @@ namespace mex_hal
          * @param type Resource type
          * @param name Resource name/identifier
          * @param handle Pointer to resource handle
-         * @return Resource ID for future reference
+         * @return Resource ID for future reference, 0 if MAX_RESOURCES are registered
          */
         uint64_t registerResource(ResourceType type, const std::string& name, void* handle);
 
+        /**
+         * @brief Register a resource that depends on registered resources
+         * @param type Resource type
+         * @param name Resource name/identifier
+         * @param handle Pointer to resource handle
+         * @param dependencies The resources it uses, released after it on teardown
+         * @return Resource ID for future reference, 0 if a dependency is not registered or MAX_RESOURCES are registered
+         */
+        uint64_t registerResource(ResourceType type, const std::string& name, void* handle,
+                                  const std::vector<uint64_t>& dependencies);
+
         /**
          * @brief Unregister a resource
          * @param resourceId Resource ID returned from registerResource
@@ -69,6 +133,56 @@ namespace mex_hal
          */
         bool unregisterResource(uint64_t resourceId);
 
+        /**
+         * @brief Record that a resource depends on another
+         * @param resourceId The dependent resource
+         * @param dependencyId The resource it uses
+         * @return A true if both are registered and the edge closes no cycle, false otherwise
+         */
+        bool addDependency(uint64_t resourceId, uint64_t dependencyId);
+
+        /**
+         * @brief Remove a dependency recorded with addDependency() or registerResource()
+         * @param resourceId The dependent resource
+         * @param dependencyId The resource it uses
+         * @return A true if the edge was recorded, false otherwise
+         */
+        bool removeDependency(uint64_t resourceId, uint64_t dependencyId);
+
+        /**
+         * @brief Get the resources a resource depends on
+         * @param resourceId Resource ID
+         * @return The dependency IDs in the order they were added
+         */
+        [[nodiscard]] std::vector<uint64_t> getDependencies(uint64_t resourceId) const;
+
+        /**
+         * @brief Get the resources that depend on a resource
+         * @param resourceId Resource ID
+         * @return The dependent IDs in the order they were added
+         */
+        [[nodiscard]] std::vector<uint64_t> getDependents(uint64_t resourceId) const;
+
+        /**
+         * @brief Sort the registered resources so every resource comes before its dependencies
+         * @param order Receives the resource IDs, ties in slot order
+         * @return A true if the dependencies form no cycle, false otherwise
+         */
+        bool getTeardownOrder(std::vector<uint64_t>& order) const;
+
+        /**
+         * @brief Release and unregister all resources, dependents before their dependencies
+         *
+         * The release of a resource starts once the releases of all its dependents
+         * have returned. Independent subtrees are released on up to threads threads,
+         * the calling thread is one of them. References still held are treated as
+         * by clearAll().
+         * @param release Called once per resource, without any lock held
+         * @param threads The number of threads releasing at once
+         * @return A true if all resources were released, false if the dependencies form a cycle and none was
+         */
+        bool teardown(const ResourceReleaseCallback& release, size_t threads = 1);
+
         /**
          * @brief Increment reference count for a resource
          * @param resourceId Resource ID
@@ -83,6 +197,27 @@ namespace mex_hal
          */
         uint32_t release(uint64_t resourceId);
 
+        /**
+         * @brief Add a reference and get the resource, so it can be released without a lookup
+         * @param resourceId Resource ID
+         * @return The resource, valid until the reference is released, nullptr if not registered
+         */
+        ResourceInfo* acquire(uint64_t resourceId);
+
+        /**
+         * @brief Add a reference to a resource already held, one atomic operation without a lookup
+         * @param info The resource returned by acquire(), a reference to it must be held
+         * @return New reference count, 0 if the resource was unregistered meanwhile
+         */
+        static uint32_t addRef(ResourceInfo& info);
+
+        /**
+         * @brief Drop a reference taken with acquire() or addRef(ResourceInfo&)
+         * @param info The resource returned by acquire()
+         * @return New reference count
+         */
+        static uint32_t release(ResourceInfo& info);
+
         /**
          * @brief Get current reference count
          * @param resourceId Resource ID
@@ -105,11 +240,48 @@ namespace mex_hal
         void setInUse(uint64_t resourceId, bool inUse);
 
         /**
-         * @brief Get resource info
+         * @brief Get a copy of a resource
          * @param resourceId Resource ID
-         * @return Pointer to resource info, nullptr if not found
+         * @param state Receives the resource
+         * @return A true if the resource is registered, false otherwise
+         */
+        bool getResourceInfo(uint64_t resourceId, ResourceState& state) const;
+
+        /**
+         * @brief Copy all registered resources
+         *
+         * Holds only the registration lock, reference counting and the device I/O
+         * paths never wait for it. The set of resources and their dependencies is
+         * consistent, each count and flag is read once while it may still change.
+         * @param resources Receives the resources in slot order, its strings and capacity are reused
          */
-        const ResourceInfo* getResourceInfo(uint64_t resourceId) const;
+        void snapshot(std::vector<ResourceState>& resources) const;
+
+        /**
+         * @brief Copy all registered resources
+         * @return The resources in slot order
+         */
+        [[nodiscard]] std::vector<ResourceState> snapshot() const;
+
+        /**
+         * @brief Count one device operation of a resource in the calling thread's shard
+         * @param resourceId Resource ID, an invalid ID is ignored
+         * @param bytes The bytes transferred
+         * @param latencyNs The duration of the operation
+         * @param success A false counts the operation as an error
+         */
+        void recordIo(uint64_t resourceId, size_t bytes, uint64_t latencyNs, bool success);
+
+        /**
+         * @brief Sum the I/O counters of a resource over all threads
+         *
+         * Each counter is read once while it may still change, the counters of
+         * an operation in progress may be partly included.
+         * @param resourceId Resource ID
+         * @param stats Receives the counters since the resource was registered
+         * @return A true if the resource is registered, false otherwise
+         */
+        bool getIoStats(uint64_t resourceId, ResourceIoStats& stats) const;
 
         /**
          * @brief Get total count of registered resources
@@ -122,6 +294,10 @@ namespace mex_hal
          */
         void clearAll();
 
+        static constexpr size_t CHUNK_SLOTS = 256;
+        static constexpr size_t MAX_CHUNKS = 1024;
+        static constexpr size_t MAX_RESOURCES = CHUNK_SLOTS * MAX_CHUNKS;
+
         // Prevent copying and assignment
         ResourceManager(const ResourceManager&) = delete;
         ResourceManager& operator=(const ResourceManager&) = delete;
@@ -129,18 +305,177 @@ namespace mex_hal
         ResourceManager& operator=(ResourceManager&&) = delete;
 
     private:
-        ResourceManager() = default;
-        ~ResourceManager() = default;
+        ResourceManager();
+        ~ResourceManager();
+
+        // Threads are spread over the slots, a shared slot only costs contention
+        static constexpr size_t READER_SLOTS = 32;
+
+        /// @brief Lookup-in-progress counter on its own cache line \struct ReaderSlot
+        struct alignas(64) ReaderSlot
+        {
+            std::atomic<uint32_t> active{0};
+        };
+
+        /// @brief Marks the calling thread's reader slot for the lifetime of a lookup \class ReadGuard
+        class ReadGuard
+        {
+        public:
+            explicit ReadGuard(ReaderSlot& slot);
+            ~ReadGuard();
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+        private:
+            ReaderSlot& slot_;
+        };
+
+        /// @brief Slot of the slot map, its generation counts the unregistrations \struct Slot
+        struct Slot
+        {
+            std::atomic<uint32_t> generation{0};
+            ResourceInfo info;
+        };
+
+        // Generation of counters not yet used for any resource
+        static constexpr uint32_t NO_GENERATION = ~0u;
+
+        /// @brief I/O counters of one resource written by one thread \struct IoCounters
+        struct IoCounters
+        {
+            std::atomic<uint32_t> generation{NO_GENERATION};
+            std::atomic<uint64_t> operations{0};
+            std::atomic<uint64_t> bytes{0};
+            std::atomic<uint64_t> errors{0};
+            std::atomic<uint64_t> totalLatencyNs{0};
+            std::atomic<uint64_t> maxLatencyNs{0};
+        };
+
+        /// @brief Counters of one thread, indexed like the slot map and allocated by chunk \struct IoShard
+        struct IoShard
+        {
+            std::array<std::atomic<IoCounters*>, MAX_CHUNKS> chunks{};
+            std::atomic<bool> leased{false};    // a shard of an exited thread is handed to the next new one
+
+            IoShard() = default;
+            ~IoShard();
+            IoShard(const IoShard&) = delete;
+            IoShard& operator=(const IoShard&) = delete;
+        };
+
+        /// @brief Returns the calling thread's shard when the thread exits \struct IoLease
+        struct IoLease
+        {
+            IoShard* shard = nullptr;
+            ~IoLease();
+        };
+
+        /// @brief Copy of the registered resources with their edges as positions in it \struct Graph
+        struct Graph
+        {
+            std::vector<ResourceState> resources;
+            std::vector<uint32_t> dependents;                   // count per resource
+            std::vector<std::vector<size_t>> dependencies;      // positions per resource
+        };
+
+        /**
+         * @brief Get the reader slot of the calling thread
+         * @return The slot
+         */
+        ReaderSlot& readerSlot() const;
+
+        /**
+         * @brief Get the I/O shard of the calling thread, leasing one on first use
+         * @return The shard, written only by the calling thread
+         */
+        IoShard& ioShard();
+
+        /**
+         * @brief Find the slot of a registered resource
+         *
+         * Without a ReadGuard or resourceMutex_ the slot may be reused meanwhile, reads
+         * then check its generation again.
+         * @param resourceId Resource ID
+         * @return The slot, nullptr if the ID is invalid, stale or unregistered
+         */
+        Slot* find(uint64_t resourceId) const;
+
+        /**
+         * @brief Retire the slot of a resource that is no longer registered, resourceMutex_ must be held
+         * @param index The slot index
+         */
+        void retire(uint32_t index);
+
+        /**
+         * @brief Free retired slots if no lookup is in progress, resourceMutex_ must be held
+         */
+        void reclaim();
+
+        /**
+         * @brief Register a resource, resourceMutex_ must be held
+         * @param type Resource type
+         * @param name Resource name/identifier
+         * @param handle Pointer to resource handle
+         * @return Resource ID, 0 if MAX_RESOURCES are registered
+         */
+        uint64_t add(ResourceType type, const std::string& name, void* handle);
+
+        /**
+         * @brief Copy all registered resources, resourceMutex_ must be held
+         * @param resources Receives the resources in slot order
+         */
+        void collect(std::vector<ResourceState>& resources) const;
+
+        /**
+         * @brief Copy the registered resources and their dependency edges, resourceMutex_ must be held
+         * @param graph Receives the resources in slot order
+         */
+        void buildGraph(Graph& graph) const;
+
+        /**
+         * @brief Sort a graph so every resource comes before its dependencies
+         * @param graph The graph
+         * @param order Receives the positions of the resources
+         * @return A true if the graph has no cycle, false otherwise
+         */
+        static bool sortGraph(const Graph& graph, std::vector<size_t>& order);
+
+        /**
+         * @brief Drop the dependency edges of a resource, resourceMutex_ must be held
+         * @param resourceId Resource ID
+         */
+        void eraseDependencies(uint64_t resourceId);
+
+        /**
+         * @brief Check if a resource depends on another, directly or through others, resourceMutex_ must be held
+         * @param resourceId The dependent resource
+         * @param dependencyId The resource it may use
+         * @return A true if a path of dependencies leads from resourceId to dependencyId, false otherwise
+         */
+        bool dependsOn(uint64_t resourceId, uint64_t dependencyId) const;
 
         mutable std::mutex resourceMutex_;
-        std::unordered_map<uint64_t, std::unique_ptr<ResourceInfo>> resources_;
-        std::atomic<uint64_t> nextResourceId_{1};
+        std::array<std::atomic<Slot*>, MAX_CHUNKS> chunks_{};
+        uint32_t slotCount_ = 0;                // slots handed out so far, in index order
+        size_t liveCount_ = 0;
+        std::vector<uint32_t> freeSlots_;       // reused last in, first out
+        std::vector<uint32_t> retiredSlots_;    // waiting for lookups and acquired references
+        std::unordered_map<uint64_t, std::vector<uint64_t>> dependencies_;  // edges by dependent
+        std::unordered_map<uint64_t, std::vector<uint64_t>> dependents_;    // the same edges by dependency
+
+        mutable std::mutex ioMutex_;
+        std::vector<std::unique_ptr<IoShard>> ioShards_;   // never shrinks, a reader may sum a shard at any time
+
+        mutable std::array<ReaderSlot, READER_SLOTS> readerSlots_;
+        mutable std::atomic<size_t> nextReaderSlot_{0};
     };
 
     /**
      * @brief RAII wrapper for resource management
      * 
-     * Automatically manages reference counting through RAII pattern.
+     * Automatically manages reference counting through RAII pattern. The guard
+     * keeps the resource it acquired: construction by ID is a guarded lookup,
+     * share() and destruction are one atomic operation each.
      */
     class ResourceGuard
     {
@@ -168,9 +503,52 @@ namespace mex_hal
          */
         [[nodiscard]] uint64_t getResourceId() const { return resourceId_; }
 
+        /**
+         * @brief Take another reference to the guarded resource without a lookup
+         * @return A guard of the same resource, holding nothing if this guard holds nothing
+         */
+        [[nodiscard]] ResourceGuard share() const;
+
+    private:
+        /**
+         * @brief Adopt a reference already taken
+         * @param resourceId The resource ID
+         * @param info The referenced resource, nullptr for none
+         */
+        ResourceGuard(uint64_t resourceId, ResourceInfo* info);
+
+        uint64_t resourceId_;
+        ResourceInfo* info_;    // nullptr if moved from or not registered
+    };
+
+    /**
+     * @brief Times one device operation and counts it for a resource
+     *
+     * Started before the system call, finished once with its outcome.
+     */
+    class ResourceIoTimer
+    {
+    public:
+        /**
+         * @brief Start timing an operation
+         * @param resourceId The resource the operation is counted for, 0 to count nothing
+         */
+        explicit ResourceIoTimer(const uint64_t resourceId)
+            : resourceId_(resourceId)
+            , start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        /**
+         * @brief Count the operation
+         * @param bytes The bytes transferred
+         * @param success A false counts the operation as an error
+         */
+        void finish(size_t bytes, bool success) const;
+
     private:
         uint64_t resourceId_;
-        bool valid_;
+        std::chrono::steady_clock::time_point start_;
     };
 
 } // namespace mex_hal
@@ -1,6 +1,8 @@
 #ifndef MEX_HAL_RESOURCE_VISUALIZER_H
 #define MEX_HAL_RESOURCE_VISUALIZER_H
 
+#include "callback_manager.h"
+#include "resource_manager.h"
 #include <string>
 #include <cstdint>
 #include <vector>
@@ -23,6 +25,9 @@ namespace mex_hal
         double cpuPercent;
         size_t memoryBytes;
         size_t openFDs;
+
+        // Device I/O, summed over the threads' shards when gathered
+        ResourceIoStats io;
     };
 
     /// @brief Resource graph node structure \struct ResourceNode
@@ -63,6 +68,18 @@ namespace mex_hal
          */
         void gatherResourceData();
 
+        /**
+         * @brief Get the resource usage of the last gatherResourceData()
+         * @return The usage of every registered resource
+         */
+        [[nodiscard]] std::vector<ResourceUsage> getResourceUsages() const;
+
+        /**
+         * @brief Get the resource graph of the last buildResourceGraph()
+         * @return A node per registered resource with its dependencies
+         */
+        [[nodiscard]] std::vector<ResourceNode> getResourceGraph() const;
+
         /**
          * @brief Build resource dependency graph
          */
@@ -78,6 +95,24 @@ namespace mex_hal
          */
         void printResourceGraph() const;
 
+        /**
+         * @brief Gather the callback profiles, ranked by total execution time
+         */
+        void gatherCallbackData();
+
+        /**
+         * @brief Get the callbacks that used the most execution time
+         * @param count The maximum number of callbacks
+         * @return The profiles of the top callbacks, most expensive first
+         */
+        [[nodiscard]] std::vector<CallbackProfile> getTopCallbacks(size_t count) const;
+
+        /**
+         * @brief Print the callbacks that used the most execution time
+         * @param count The maximum number of callbacks
+         */
+        void printCallbackUsage(size_t count = 10) const;
+
     private:
         mutable std::mutex mutex_;
         std::atomic<bool> running_{false};
@@ -85,9 +120,11 @@ namespace mex_hal
 
         std::vector<ResourceUsage> resourceUsages_;
         std::vector<ResourceNode> resourceGraph_;
+        std::vector<CallbackProfile> callbackProfiles_;
+        std::vector<ResourceState> resourceStates_;     // reused by every gather
 
         /**
-         * @brief Gather process metrics for a resource
+         * @brief Gather process metrics, shared by all resources
          * @param usage Reference to ResourceUsage struct to populate
          */
         static void gatherProcessMetrics(ResourceUsage& usage);
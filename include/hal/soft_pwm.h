@@ -0,0 +1,332 @@
+#ifndef MEX_HAL_SOFT_PWM_H
+#define MEX_HAL_SOFT_PWM_H
+
+#include "gpio.h"
+#include "pwm.h"
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    class SoftPWM;
+
+    /// @brief Edge timing statistics of software PWM \struct SoftPWMStats
+    struct SoftPWMStats
+    {
+        uint64_t edges = 0;             // edges driven
+        uint64_t writes = 0;            // writeMask() calls, coinciding edges share one
+        uint64_t writeErrors = 0;       // writeMask() calls that failed
+        uint64_t missedPeriods = 0;     // periods skipped because the thread fell behind
+        uint64_t meanJitterNs = 0;      // mean lateness of an edge behind its deadline
+        uint64_t maxJitterNs = 0;
+    };
+
+    /**
+     * @brief Drives any number of software PWM channels from one thread
+     *
+     * Every pending edge is an entry of a list sorted by its absolute
+     * CLOCK_MONOTONIC deadline. The thread sleeps until the earliest deadline,
+     * pops every edge that is due and applies them with a single writeMask(), so
+     * channels whose edges coincide cost one GPIO call. A channel starts on the
+     * next multiple of its period, so channels with equal periods rise together,
+     * and then stays on that grid; when the thread falls so far behind that a whole
+     * active phase has passed, the missed periods are skipped and counted, so a
+     * rise whose fall is already due is never written as a runt pulse. Jitter
+     * is the time from the deadline to the completion of the write.
+     * Configuration changes reschedule the affected channel and wake the thread.
+     */
+    class SoftPWMScheduler
+    {
+    public:
+        // Shorter periods would keep the thread permanently busy
+        static constexpr uint32_t MIN_PERIOD_NS = 10000;
+
+        /**
+         * @brief Constructor
+         * @param gpio The GPIO controller driving the lines, may be shared with other users
+         */
+        explicit SoftPWMScheduler(std::shared_ptr<GPIOInterface> gpio);
+
+        /**
+         * @brief Destructor, stops the thread, channels must be destroyed first
+         */
+        ~SoftPWMScheduler();
+
+        /// @brief Prevent copying, the thread references this object
+        SoftPWMScheduler(const SoftPWMScheduler&) = delete;
+        SoftPWMScheduler& operator=(const SoftPWMScheduler&) = delete;
+
+        /**
+         * @brief Create a PWM channel driven by this scheduler
+         * @return The channel, init() selects its GPIO line, must not outlive the scheduler
+         */
+        std::unique_ptr<SoftPWM> createChannel();
+
+        /**
+         * @brief Claim a GPIO line as an output for a new channel
+         * @param pin The GPIO line
+         * @return The channel index, -1 if the line is taken or cannot be configured
+         */
+        int32_t addChannel(uint8_t pin);
+
+        /**
+         * @brief Stop a channel, drive its line inactive and release it
+         * @param channel The channel index
+         */
+        void removeChannel(int32_t channel);
+
+        /**
+         * @brief Apply a channel configuration, takes effect at the next edge
+         * @param channel The channel index
+         * @param periodNs The period in nanoseconds, at least MIN_PERIOD_NS while toggling
+         * @param dutyNs The active time per period, 0 and periodNs hold a constant level
+         * @param inverted A true if the active level is LOW
+         * @param enabled A false drives the line inactive
+         * @return A true if the configuration is valid and was applied, false otherwise
+         */
+        bool configureChannel(int32_t channel, uint32_t periodNs, uint32_t dutyNs, bool inverted, bool enabled);
+
+        /**
+         * @brief Set the scheduling priority of the PWM thread
+         * @param priority 0 for SCHED_OTHER, otherwise the SCHED_FIFO priority
+         * @return A true if the priority is valid and was applied, false otherwise
+         */
+        bool setThreadPriority(int32_t priority);
+
+        /**
+         * @brief Pin the PWM thread to a CPU
+         * @param cpu The CPU index, -1 to allow all CPUs
+         * @return A true if the affinity is valid and was applied, false otherwise
+         */
+        bool setThreadAffinity(int32_t cpu);
+
+        /**
+         * @brief Get the edge statistics of one channel since it was added
+         * @param channel The channel index
+         * @return The statistics, all zero for an invalid index
+         */
+        [[nodiscard]] SoftPWMStats getChannelStats(int32_t channel) const;
+
+        /**
+         * @brief Get the statistics over all channels since construction
+         * @return The statistics
+         */
+        [[nodiscard]] SoftPWMStats getStats() const;
+
+    private:
+        /// @brief Lateness accumulator \struct JitterCounters
+        struct JitterCounters
+        {
+            uint64_t edges = 0;
+            uint64_t missedPeriods = 0;
+            uint64_t totalJitterNs = 0;
+            uint64_t maxJitterNs = 0;
+        };
+
+        /// @brief State of one channel \struct Channel
+        struct Channel
+        {
+            uint8_t pin = 0;
+            bool used = false;
+            uint32_t periodNs = 0;
+            uint32_t dutyNs = 0;
+            bool inverted = false;
+            bool enabled = false;
+
+            bool toggling = false;          // an edge of this channel is in the event list
+            bool active = false;            // current logical level
+            uint64_t periodStartNs = 0;
+            uint64_t generation = 0;        // bumped on every reschedule, stale events are dropped
+            JitterCounters counters;
+        };
+
+        /// @brief One pending edge \struct Event
+        struct Event
+        {
+            uint64_t deadlineNs;
+            int32_t channel;
+            uint64_t generation;
+        };
+
+        /**
+         * @brief Check a channel index
+         * @param channel The channel index
+         * @return A true if the index refers to a claimed channel, false otherwise
+         */
+        [[nodiscard]] bool isValidChannel(int32_t channel) const;
+
+        /**
+         * @brief Insert an edge into the event list, kept sorted latest first
+         * @param event The edge
+         */
+        void pushEvent(const Event& event);
+
+        /**
+         * @brief Restart a channel after a configuration change, mutex_ must be held
+         * @param index The channel index
+         * @param nowNs The current CLOCK_MONOTONIC time in nanoseconds
+         * @return A true if the constant level write succeeded or the channel toggles, false otherwise
+         */
+        bool reschedule(int32_t index, uint64_t nowNs);
+
+        /**
+         * @brief Start the PWM thread if it is not running, mutex_ must be held
+         * @return A true if the thread is running, false otherwise
+         */
+        bool ensureThread();
+
+        /**
+         * @brief PWM thread body
+         */
+        void run();
+
+        std::shared_ptr<GPIOInterface> gpio_;
+
+        // Guards the channels, the event list and the GPIO writes of the thread
+        mutable std::mutex mutex_;
+        std::condition_variable wakeup_;
+        std::vector<Channel> channels_;
+        std::vector<Event> events_;
+        PinMask claimedPins_;
+        JitterCounters total_;
+        uint64_t writes_ = 0;
+        uint64_t writeErrors_ = 0;
+        bool stopRequested_ = false;
+        int32_t priority_ = 0;
+        int32_t cpu_ = -1;
+        std::thread thread_;
+    };
+
+    /**
+     * @brief PWM channel on a GPIO line, driven by a SoftPWMScheduler \class SoftPWM
+     *
+     * init() takes the GPIO line as the channel number, the chip number is ignored.
+     * Period and duty cycle follow the PWMLinux rules: the duty cycle never exceeds
+     * the period.
+     */
+    class SoftPWM final : public PWMInterface
+    {
+    private:
+        SoftPWMScheduler& scheduler_;
+        int32_t channel_ = -1;
+        uint32_t periodNs_ = 0;
+        uint32_t dutyCycleNs_ = 0;
+        bool inverted_ = false;
+        bool enabled_ = false;
+        uint8_t line_ = 0;
+        uint64_t resourceId_ = 0;
+        mutable std::mutex pwmMutex_;
+
+        /**
+         * @brief Push a candidate configuration to the scheduler and keep it on success
+         * @param periodNs The period in nanoseconds
+         * @param dutyNs The duty cycle in nanoseconds
+         * @param inverted The polarity
+         * @param enabled The enable state
+         * @return A true if the scheduler accepted the configuration, false otherwise
+         */
+        bool apply(uint32_t periodNs, uint32_t dutyNs, bool inverted, bool enabled);
+
+        /**
+         * @brief Release the channel lock and publish an accepted configuration on the event bus
+         *
+         * Rejected configurations are not published, write errors of the thread are counted in the statistics.
+         * @param lock The held channel lock
+         * @param result The result of apply()
+         * @return The result
+         */
+        bool finishChange(std::unique_lock<std::mutex>& lock, bool result) const;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param scheduler The scheduler driving this channel, must outlive the channel
+         */
+        explicit SoftPWM(SoftPWMScheduler& scheduler);
+
+        /**
+         * @brief Destructor, drives the line inactive and releases it
+         */
+        ~SoftPWM() override;
+
+        /**
+         * @brief Claim the GPIO line of the channel
+         * @param chip Ignored
+         * @param channel The GPIO line
+         * @return A true if initialization was successful, false otherwise
+         */
+        bool init(uint8_t chip, uint8_t channel) override;
+
+        /**
+         * @brief Enable or disable the PWM output
+         * @param enabled True to enable, false to disable
+         * @return A true if the operation was successful, false otherwise
+         */
+        bool enable(bool enabled) override;
+
+        /**
+         * @brief Set the PWM period
+         * @param periodNs The period in nanoseconds
+         * @return A true if the period was successfully set, false otherwise
+         */
+        bool setPeriod(uint32_t periodNs) override;
+
+        /**
+         * @brief Set the PWM duty cycle
+         * @param dutyCycleNs The duty cycle in nanoseconds
+         * @return A true if the duty cycle was successfully set, false otherwise
+         */
+        bool setDutyCycle(uint32_t dutyCycleNs) override;
+
+        /**
+         * @brief Set the PWM duty cycle as a percentage
+         * @param percent The duty cycle percentage (0.0 to 100.0)
+         * @return A true if the duty cycle was successfully set, false otherwise
+         */
+        bool setDutyCyclePercent(float percent) override;
+
+        /**
+         * @brief Set the PWM polarity
+         * @param invertPolarity True to invert polarity, false for normal
+         * @return A true if the polarity was successfully set, false otherwise
+         */
+        bool setPolarity(bool invertPolarity) override;
+
+        /**
+         * @brief Get the current PWM period
+         * @return The period in nanoseconds
+         */
+        [[nodiscard]] uint32_t getPeriod() const override;
+
+        /**
+         * @brief Get the current PWM duty cycle
+         * @return The duty cycle in nanoseconds
+         */
+        [[nodiscard]] uint32_t getDutyCycle() const override;
+
+        /**
+         * @brief Check if PWM output is enabled
+         * @return A true if enabled, false otherwise
+         */
+        [[nodiscard]] bool isEnabled() const override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
+
+        /**
+         * @brief Get the edge statistics of this channel
+         * @return The statistics since init()
+         */
+        [[nodiscard]] SoftPWMStats getStats() const;
+    };
+}
+
+#endif //MEX_HAL_SOFT_PWM_H
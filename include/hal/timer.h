@@ -15,6 +15,27 @@ namespace mex_hal
         PERIODIC
     };
 
+    /// @brief A periodic tick whose callback finished after its budget \struct TimerOverrun
+    struct TimerOverrun
+    {
+        uint64_t tick = 0;              // index of the tick, from 0 since start()
+        uint64_t responseNs = 0;        // from the scheduled tick to the end of the callback
+        uint64_t budgetNs = 0;
+        uint64_t missedPeriods = 0;     // ticks skipped because the callback ran past them
+    };
+
+    /// @brief Deadline statistics of a periodic timer since start() \struct TimerDeadlineStats
+    struct TimerDeadlineStats
+    {
+        uint64_t ticks = 0;
+        uint64_t overruns = 0;
+        uint64_t missedPeriods = 0;
+        uint64_t maxResponseNs = 0;
+    };
+
+    /// @brief Called on the timer thread after an overrunning tick \typedef TimerOverrunCallback
+    using TimerOverrunCallback = InplaceFunction<void(const TimerOverrun& overrun)>;
+
     /// @brief Timer callback type \typedef TimerCallback
     class TimerInterface
     {
@@ -81,6 +102,24 @@ namespace mex_hal
          * @return The current time in microseconds
          */
         [[nodiscard]] virtual uint64_t getCurrentTimeUs() const = 0;
+
+        /**
+         * @brief Set the execution budget of periodic callbacks, only while the timer is stopped
+         *
+         * A tick overruns when its callback ends more than budgetUs after the scheduled
+         * tick. Ticks the callback ran past are skipped and counted as missed instead of
+         * firing back-to-back, also when a budget longer than the interval allowed the run.
+         * @param budgetUs The budget in microseconds, 0 = the interval
+         * @param handler Called with each overrun, may be empty
+         * @return A true if the budget was set, false if the timer is running
+         */
+        virtual bool setDeadlineBudget(uint64_t budgetUs, TimerOverrunCallback handler) = 0;
+
+        /**
+         * @brief Get the deadline statistics of periodic callbacks
+         * @return The statistics since the last start()
+         */
+        [[nodiscard]] virtual TimerDeadlineStats getDeadlineStats() const = 0;
     };
 }
 
@@ -1,7 +1,9 @@
 #ifndef MEX_HAL_TYPES_H
 #define MEX_HAL_TYPES_H
 
+#include <bitset>
 #include <cstdint>
+#include "inplace_function.h"
 #include <functional>
 #include <memory>
 #include <string>
@@ -32,6 +34,9 @@ namespace mex_hal
         HIGH
     };
 
+    /// @brief Pin mask type, bit N selects GPIO pin N \typedef PinMask
+    using PinMask = std::bitset<256>;
+
     /// @brief Logic level enumeration \enum LogicLevel
     enum class LogicLevel
     {
@@ -47,6 +52,33 @@ namespace mex_hal
         BOTH
     };
 
+    /// @brief Handling of edges beyond a pin's rate limit \enum EdgeRateMode
+    enum class EdgeRateMode
+    {
+        DROP,       // excess edges are discarded
+        COALESCE    // excess edges fold into one delivery of the latest value at the end of the window
+    };
+
+    /// @brief Per-pin interrupt rate limit, a zero maxEvents or windowMs disables limiting \struct EdgeRateLimit
+    struct EdgeRateLimit
+    {
+        uint32_t maxEvents = 0;             // edges delivered per window
+        uint32_t windowMs = 0;
+        EdgeRateMode mode = EdgeRateMode::DROP;
+        bool disableDuringStorm = false;    // turn edge detection off once the limit is exceeded
+        uint32_t rearmMs = 0;               // time edge detection stays off, 0 = one window
+    };
+
+    /// @brief Rate limit counters of one pin \struct EdgeRateStats
+    struct EdgeRateStats
+    {
+        uint64_t storms = 0;        // episodes in which a window exceeded the limit
+        uint64_t dropped = 0;       // edges discarded
+        uint64_t coalesced = 0;     // edges folded into a later delivery
+        bool stormActive = false;   // the current storm has not yet been followed by a window within the limit
+        bool disabled = false;      // edge detection is off until the re-arm deadline
+    };
+
     /// @brief SPI mode enumeration \enum SPIMode
     enum class SPIMode
     {
@@ -56,6 +88,23 @@ namespace mex_hal
         MODE_3  // CPOL=1, CPHA=1
     };
 
+    /// @brief GPIO lines of a bit-banged SPI bus \struct SoftSPIPins
+    struct SoftSPIPins
+    {
+        uint8_t sclk = 0;
+        uint8_t mosi = 0;
+        uint8_t miso = 0;
+        uint8_t cs = 0;     // active low
+    };
+
+    /// @brief GPIO lines of a bit-banged I2C bus \struct SoftI2CPins
+    struct SoftI2CPins
+    {
+        uint8_t scl = 0;
+        uint8_t sda = 0;
+        uint32_t stretchTimeoutUs = 1000;   // 0 skips the SCL readback, no clock stretching
+    };
+
     /// @brief UART configuration structure \struct UARTConfig
     struct UARTConfig
     {
@@ -66,26 +115,26 @@ namespace mex_hal
         bool evenParity;
     };
 
-    /// @brief Callback type definitions
-    using InterruptCallback = std::function<void(uint8_t pin, PinValue value)>;
-    using TimerCallback = std::function<void()>;
-    using ADCReadCallback = std::function<void(uint16_t value)>;
-    using UARTReadCallback = std::function<void(const uint8_t* data, size_t length)>;
-    using UARTWriteCallback = std::function<void(const uint8_t* data, size_t length)>;
-    using SPIReadCallback = std::function<void(const uint8_t* data, size_t length)>;
-    using SPIWriteCallback = std::function<void(const uint8_t* data, size_t length)>;
-    using I2CReadCallback = std::function<void(const uint8_t* data, size_t length)>;
-    using I2CWriteCallback = std::function<void(const uint8_t* data, size_t length)>;
-    using PWMCallback = std::function<void(uint8_t channel, uint16_t dutyCycle)>;
-    using ADCChannelCallback = std::function<void(uint8_t channel, uint16_t value)>;
-
-    using TimerEventCallback = std::function<void(uint32_t eventId)>;
-    using UARTEventCallback = std::function<void(uint32_t eventId)>;
-    using SPIEventCallback = std::function<void(uint32_t eventId)>;
-    using I2CEventCallback = std::function<void(uint32_t eventId)>;
-    using GPIOEventCallback = std::function<void(uint32_t eventId)>;
-    using PWMEventCallback = std::function<void(uint32_t eventId)>;
-    using ADCEventCallback = std::function<void(uint32_t eventId)>;
+    /// @brief Callback type definitions, move-only and stored without heap allocation
+    using InterruptCallback = InplaceFunction<void(uint8_t pin, PinValue value)>;
+    using TimerCallback = InplaceFunction<void()>;
+    using ADCReadCallback = InplaceFunction<void(uint16_t value)>;
+    using UARTReadCallback = InplaceFunction<void(const uint8_t* data, size_t length)>;
+    using UARTWriteCallback = InplaceFunction<void(const uint8_t* data, size_t length)>;
+    using SPIReadCallback = InplaceFunction<void(const uint8_t* data, size_t length)>;
+    using SPIWriteCallback = InplaceFunction<void(const uint8_t* data, size_t length)>;
+    using I2CReadCallback = InplaceFunction<void(const uint8_t* data, size_t length)>;
+    using I2CWriteCallback = InplaceFunction<void(const uint8_t* data, size_t length)>;
+    using PWMCallback = InplaceFunction<void(uint8_t channel, uint16_t dutyCycle)>;
+    using ADCChannelCallback = InplaceFunction<void(uint8_t channel, uint16_t value)>;
+
+    using TimerEventCallback = InplaceFunction<void(uint32_t eventId)>;
+    using UARTEventCallback = InplaceFunction<void(uint32_t eventId)>;
+    using SPIEventCallback = InplaceFunction<void(uint32_t eventId)>;
+    using I2CEventCallback = InplaceFunction<void(uint32_t eventId)>;
+    using GPIOEventCallback = InplaceFunction<void(uint32_t eventId)>;
+    using PWMEventCallback = InplaceFunction<void(uint32_t eventId)>;
+    using ADCEventCallback = InplaceFunction<void(uint32_t eventId)>;
 
     /// @brief HAL error structure \struct HALError
     struct HALError
@@ -59,6 +59,12 @@ namespace mex_hal
          * @return A true if the configuration was successfully set, false otherwise
          */
         virtual bool setConfig(const UARTConfig& config) = 0;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] virtual uint64_t getResourceId() const = 0;
     };
 }
 
@@ -1,4 +1,5 @@
 #include "adc_linux.h"
+#include "../../include/hal/callback_manager.h"
 #include <chrono>
 #include <thread>
 
@@ -25,21 +26,24 @@ std::string ADCLinux::getDevicePath(const uint8_t channel) const
 
 uint16_t ADCLinux::readRaw(const uint8_t channel) const
 {
-    std::lock_guard<std::mutex> lock(adcMutex_);
+    std::unique_lock<std::mutex> lock(adcMutex_);
     
     const std::string path = getDevicePath(channel);
+    const ResourceIoTimer timer(resourceId_);
     std::ifstream file(path);
     
-    if (!file.is_open())
-    {
-        return 0;
-    }
-    
-    uint16_t value;
-    file >> value;
+    uint16_t value = 0;
+    const bool result = file.is_open() && static_cast<bool>(file >> value);
     file.close();
-    
-    return value;
+    timer.finish(result ? sizeof(value) : 0, result);
+
+    const uint64_t resourceId = resourceId_;
+    lock.unlock();
+
+    CallbackManager::getInstance().publishEvent(ResourceType::ADC_CHANNEL, resourceId,
+                                                result ? HALEventKind::SAMPLE : HALEventKind::IO_ERROR,
+                                                result ? value : 0, channel);
+    return result ? value : 0;
 }
 
 bool ADCLinux::init(uint8_t device, const ADCConfig& config)
@@ -140,7 +144,7 @@ void ADCLinux::continuousReadLoop()
     continuousRunning_.store(false, std::memory_order_release);
 }
 
-bool ADCLinux::startContinuous(const uint8_t channel, const ADCReadCallback callback)
+bool ADCLinux::startContinuous(const uint8_t channel, ADCReadCallback callback)
 {
     if (continuousRunning_.load(std::memory_order_acquire))
     {
@@ -151,7 +155,7 @@ bool ADCLinux::startContinuous(const uint8_t channel, const ADCReadCallback call
     
     {
         std::lock_guard<std::mutex> lock(callbackMutex_);
-        continuousCallback_ = callback;
+        continuousCallback_ = std::move(callback);
     }
     
     shouldStopContinuous_.store(false, std::memory_order_release);
@@ -213,3 +217,9 @@ float ADCLinux::readVoltage(const uint8_t channel, const float referenceVoltage)
     
     return (static_cast<float>(rawValue) / static_cast<float>(maxValue)) * referenceVoltage;
 }
+
+uint64_t ADCLinux::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(adcMutex_);
+    return resourceId_;
+}
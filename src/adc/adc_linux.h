@@ -129,6 +129,12 @@ namespace mex_hal
          * @return The voltage value as a float
          */
         float readVoltage(uint8_t channel, float referenceVoltage) override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
     };
 }
 
@@ -0,0 +1,41 @@
+#include "bitbang_clock.h"
+#include "../monotonic_clock/monotonic_clock.h"
+#include <ctime>
+
+using namespace mex_hal;
+
+void BitBangClock::setFrequency(const uint32_t hz)
+{
+    // Rounded up so the bus never runs faster than requested
+    halfPeriodNs_ = hz != 0 ? (1000000000ULL + 2ULL * hz - 1) / (2ULL * hz) : 0;
+}
+
+void BitBangClock::start()
+{
+    if (halfPeriodNs_ != 0) phaseStartNs_ = monotonicNs();
+}
+
+void BitBangClock::waitHalfPeriod()
+{
+    if (halfPeriodNs_ == 0) return;
+
+    const uint64_t deadlineNs = phaseStartNs_ + halfPeriodNs_;
+    uint64_t nowNs = monotonicNs();
+    if (nowNs >= deadlineNs)
+    {
+        phaseStartNs_ = nowNs;
+        return;
+    }
+
+    if (deadlineNs - nowNs > kSpinThresholdNs)
+    {
+        const uint64_t wakeNs = deadlineNs - kSpinThresholdNs;
+        timespec wake{};
+        wake.tv_sec = static_cast<time_t>(wakeNs / 1000000000ULL);
+        wake.tv_nsec = static_cast<long>(wakeNs % 1000000000ULL);
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr);
+    }
+
+    while (nowNs < deadlineNs) nowNs = monotonicNs();
+    phaseStartNs_ = nowNs;
+}
@@ -0,0 +1,53 @@
+#ifndef MEX_HAL_BITBANG_CLOCK_H
+#define MEX_HAL_BITBANG_CLOCK_H
+
+#include <cstdint>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief Paces the half periods of a bit-banged bus clock
+     *
+     * Each phase lasts at least half a clock period, measured from the end of the
+     * previous phase on CLOCK_MONOTONIC. A phase that already took longer because
+     * the GPIO call was slow is not waited for and the next phase starts from now,
+     * so a late edge never shortens the following pulse. Waits longer than the spin
+     * threshold sleep on an absolute deadline, the remainder is spun.
+     * A frequency of 0 runs the bus as fast as the GPIO backend can toggle it.
+     */
+    class BitBangClock
+    {
+    public:
+        /**
+         * @brief Set the clock frequency
+         * @param hz The frequency in Hz, 0 for no pacing
+         */
+        void setFrequency(uint32_t hz);
+
+        /**
+         * @brief Get the length of one clock phase
+         * @return The half period in nanoseconds, 0 without pacing
+         */
+        [[nodiscard]] uint64_t getHalfPeriodNs() const { return halfPeriodNs_; }
+
+        /**
+         * @brief Start the first phase now
+         */
+        void start();
+
+        /**
+         * @brief Wait for the end of the current phase and start the next one
+         */
+        void waitHalfPeriod();
+
+    private:
+        // Below this the scheduler wakeup latency exceeds the wait, spinning is more precise
+        static constexpr uint64_t kSpinThresholdNs = 50000;
+
+        uint64_t halfPeriodNs_ = 0;
+        uint64_t phaseStartNs_ = 0;
+    };
+}
+
+#endif //MEX_HAL_BITBANG_CLOCK_H
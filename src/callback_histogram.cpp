@@ -0,0 +1,65 @@
+#include "../include/hal/callback_histogram.h"
+#include <algorithm>
+
+using namespace mex_hal;
+
+uint64_t CallbackHistogram::bucketUpperBound(const size_t index) noexcept
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    const size_t shift = index / SUB_BUCKETS - 1;
+    const uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + index % SUB_BUCKETS) << shift;
+    return lower + ((uint64_t{1} << shift) - 1);
+}
+
+HistogramSummary CallbackHistogram::summary() const noexcept
+{
+    std::array<uint64_t, BUCKETS> counts{};
+    uint64_t count = 0;
+    for (size_t i = 0; i < BUCKETS; ++i)
+    {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        count += counts[i];
+    }
+
+    HistogramSummary summary;
+    if (count == 0)
+    {
+        return summary;
+    }
+
+    summary.count = count;
+    summary.totalNs = total_.load(std::memory_order_relaxed);
+    summary.meanNs = summary.totalNs / count;
+    summary.maxNs = max_.load(std::memory_order_relaxed);
+
+    // Walk the buckets once, each percentile is the first bucket that reaches its rank
+    const std::array<double, 4> quantiles{0.5, 0.9, 0.99, 0.999};
+    std::array<uint64_t*, 4> results{&summary.p50Ns, &summary.p90Ns, &summary.p99Ns, &summary.p999Ns};
+    size_t next = 0;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS && next < quantiles.size(); ++i)
+    {
+        seen += counts[i];
+        while (next < quantiles.size() && static_cast<double>(seen) >= quantiles[next] * static_cast<double>(count))
+        {
+            *results[next] = std::min(bucketUpperBound(i), summary.maxNs);
+            ++next;
+        }
+    }
+
+    return summary;
+}
+
+void CallbackHistogram::reset() noexcept
+{
+    for (auto& bucket : buckets_)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
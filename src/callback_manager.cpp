@@ -1,165 +1,1517 @@
 #include "../include/hal/callback_manager.h"
+#include "../include/hal/file_descriptor.h"
+#include "thread_config/thread_config.h"
+#include "monotonic_clock/monotonic_clock.h"
 #include <algorithm>
+#include <chrono>
+#include <thread>
+#include <type_traits>
+#include <ctime>
+#include <sys/eventfd.h>
 
 using namespace mex_hal;
 
+namespace
+{
+    // Event time of the callback running on this thread, read by the GPIO batch collectors
+    thread_local uint64_t dispatchEventNs = 0;
+
+    // Coalesced edge count of the GPIO edge whose callback runs on this thread, carried across the worker hop
+    thread_local uint32_t dispatchCoalesced = 0;
+
+    // Batch subscription whose delivery runs on this thread, a nested flush of it would deadlock
+    thread_local const void* deliveringBatch = nullptr;
+
+    /**
+     * @brief Run a registered callback, recording its latency and execution time when profiling
+     * @param target The registered callback
+     * @param eventNs The CLOCK_MONOTONIC time of the event in nanoseconds
+     * @param coalesced The coalesced edge count of a GPIO edge, 0 for other events
+     * @param args The callback arguments
+     */
+    template <typename Target, typename... Args>
+    void runTarget(const Target& target, const uint64_t eventNs, const uint32_t coalesced, Args... args)
+    {
+        dispatchEventNs = eventNs;
+        dispatchCoalesced = coalesced;
+#ifdef HAL_CALLBACK_PROFILING
+        if (!target.profiled)
+        {
+            target.callback(args...);
+            return;
+        }
+
+        const uint64_t startNs = monotonicNs();
+        target.latency.record(startNs > eventNs ? startNs - eventNs : 0);
+        target.callback(args...);
+        const uint64_t executionNs = monotonicNs() - startNs;
+        target.execution.record(executionNs);
+#else
+        if (target.budgetNs == 0)
+        {
+            target.callback(args...);
+            return;
+        }
+
+        const uint64_t startNs = monotonicNs();
+        target.callback(args...);
+        const uint64_t executionNs = monotonicNs() - startNs;
+#endif
+        if (target.budgetNs != 0 && executionNs > target.budgetNs)
+        {
+            target.overruns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Run or queue the callbacks of one dispatch list
+     * @param entries The snapshot entries
+     * @param eventNs The CLOCK_MONOTONIC time of the event in nanoseconds
+     * @param coalesced The coalesced edge count of a GPIO edge, 0 for other events
+     * @param args The callback arguments
+     */
+    template <typename Entries, typename... Args>
+    void dispatch(const Entries& entries, const uint64_t eventNs, const uint32_t coalesced, const Args&... args)
+    {
+        for (const auto& entry : entries)
+        {
+            if (!entry.target->callback)
+            {
+                continue;
+            }
+
+            if (entry.worker != nullptr)
+            {
+                entry.worker->push(entry.target, eventNs, coalesced, args...);
+            }
+            else
+            {
+                runTarget(*entry.target, eventNs, coalesced, args...);
+            }
+        }
+    }
+
+    /**
+     * @brief Find the dispatch list of a key in a sorted snapshot
+     * @param byKey The sorted key lists of the snapshot
+     * @param key The key
+     * @return The list, nullptr if nothing is registered for the key
+     */
+    template <typename ByKey, typename Key>
+    const auto* findEntries(const ByKey& byKey, const Key& key)
+    {
+        const auto it = std::lower_bound(byKey.begin(), byKey.end(), key,
+                                         [](const auto& entry, const Key& k) { return entry.first < k; });
+        return it != byKey.end() && it->first == key ? &it->second : nullptr;
+    }
+
+    /**
+     * @brief Fill a profile from a registered callback
+     * @param target The registered callback
+     * @param profile Receives the histogram summaries and the overrun count
+     */
+    template <typename Target>
+    void summarize(const Target& target, CallbackProfile& profile)
+    {
+        profile.overruns = target.overruns.load(std::memory_order_relaxed);
+#ifdef HAL_CALLBACK_PROFILING
+        profile.latency = target.latency.summary();
+        profile.execution = target.execution.summary();
+#endif
+    }
+}
+
+/**
+ * @brief Executor worker thread with a bounded multi-producer/single-consumer lock-free queue
+ *
+ * Producers claim a slot with a CAS on the tail and publish it through the slot turn,
+ * the worker is the only consumer. A full queue drops the event and counts it, so the
+ * dispatching I/O thread never blocks. An idle worker sleeps on an eventfd that
+ * producers only write while it sleeps.
+ */
+class CallbackManager::Worker
+{
+public:
+    /**
+     * @brief Constructor
+     * @param config The worker configuration
+     */
+    explicit Worker(const CallbackWorkerConfig& config);
+
+    /**
+     * @brief Destructor, stops the thread
+     */
+    ~Worker();
+
+    /**
+     * @brief Start the thread and apply its schedule
+     * @return A true if the thread is running, false otherwise
+     */
+    bool start();
+
+    /**
+     * @brief Run the queued callbacks and join the thread
+     */
+    void stop();
+
+    /**
+     * @brief Queue a GPIO callback, called by any thread
+     * @param target The callback
+     * @param eventNs The time of the event in nanoseconds
+     * @param coalesced The edges a COALESCE rate limit folded into this one
+     * @param pin The GPIO pin number
+     * @param value The pin value
+     */
+    void push(const std::shared_ptr<const GPIOTarget>& target, uint64_t eventNs, uint32_t coalesced, uint8_t pin,
+              PinValue value) noexcept;
+
+    /**
+     * @brief Queue a timer callback, called by any thread
+     * @param target The callback
+     * @param eventNs The time of the expiry in nanoseconds
+     * @param coalesced Unused, timers have no coalesced edges
+     */
+    void push(const std::shared_ptr<const TimerTarget>& target, uint64_t eventNs, uint32_t coalesced) noexcept;
+
+    /**
+     * @brief Queue an event callback, called by any thread
+     * @param target The callback
+     * @param eventNs The time of the event in nanoseconds
+     * @param coalesced Unused, events have no coalesced edges
+     * @param event The event
+     */
+    void push(const std::shared_ptr<const EventTarget>& target, uint64_t eventNs, uint32_t coalesced,
+              const HALEvent& event) noexcept;
+
+    /**
+     * @brief Get the worker counters
+     * @return The counters
+     */
+    [[nodiscard]] CallbackWorkerStats getStats() const;
+
+    const CallbackWorkerConfig config;
+
+private:
+    /// @brief Queued callback and its event \struct Task
+    struct Task
+    {
+        std::shared_ptr<const GPIOTarget> gpio;
+        std::shared_ptr<const TimerTarget> timer;
+        std::shared_ptr<const EventTarget> event;
+        uint8_t pin = 0;
+        PinValue value = PinValue::LOW;
+        HALEvent payload;
+        uint64_t eventNs = 0;
+        uint32_t coalesced = 0;
+    };
+
+    /// @brief Ring slot, turn tells producers and the worker whose move it is \struct Cell
+    struct Cell
+    {
+        std::atomic<uint64_t> turn{0};
+        Task task;
+    };
+
+    /**
+     * @brief Claim a slot and fill it
+     * @param fill Writes the task into the slot
+     */
+    template <typename Fill>
+    void enqueue(Fill&& fill) noexcept;
+
+    /**
+     * @brief Take the oldest task, worker thread only
+     * @param task Receives the task
+     * @return A true if a task was taken, false if the queue was empty
+     */
+    bool pop(Task& task) noexcept;
+
+    /**
+     * @brief Worker thread body
+     */
+    void run();
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) std::atomic<uint64_t> head_{0};
+    std::atomic<bool> sleeping_{false};
+    std::atomic<bool> stopRequested_{false};
+    std::atomic<uint64_t> executed_{0};
+    std::atomic<uint64_t> dropped_{0};
+    bool scheduleApplied_ = false;
+    FileDescriptor wakeFd_;
+    std::thread thread_;
+};
+
+CallbackManager::Worker::Worker(const CallbackWorkerConfig& workerConfig)
+    : config(workerConfig)
+{
+    size_t slots = 2;
+    while (slots < config.queueCapacity)
+    {
+        slots <<= 1;
+    }
+
+    cells_ = std::make_unique<Cell[]>(slots);
+    mask_ = slots - 1;
+
+    // Slot i is free for the producer at position i
+    for (size_t i = 0; i < slots; ++i)
+    {
+        cells_[i].turn.store(i, std::memory_order_relaxed);
+    }
+}
+
+CallbackManager::Worker::~Worker()
+{
+    stop();
+}
+
+bool CallbackManager::Worker::start()
+{
+    wakeFd_.reset(eventfd(0, EFD_CLOEXEC));
+    if (!wakeFd_.isValid())
+    {
+        return false;
+    }
+
+    thread_ = std::thread(&Worker::run, this);
+    scheduleApplied_ = ThreadConfig::apply(thread_.native_handle(), ThreadSchedule{config.priority, config.cpu});
+    return true;
+}
+
+void CallbackManager::Worker::stop()
+{
+    if (!thread_.joinable())
+    {
+        return;
+    }
+
+    stopRequested_.store(true, std::memory_order_release);
+    const uint64_t one = 1;
+    (void)::write(wakeFd_.get(), &one, sizeof(one));
+    thread_.join();
+}
+
+template <typename Fill>
+void CallbackManager::Worker::enqueue(Fill&& fill) noexcept
+{
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells_[tail & mask_];
+        const uint64_t turn = cell.turn.load(std::memory_order_acquire);
+
+        if (turn == tail)
+        {
+            if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+            {
+                fill(cell.task);
+                cell.turn.store(tail + 1, std::memory_order_release);
+                break;
+            }
+        }
+        else if (turn < tail)
+        {
+            // The worker has not taken the slot of the previous lap yet
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            tail = tail_.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Pairs with the fence of the worker going to sleep, one of both sees the other
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed))
+    {
+        const uint64_t one = 1;
+        (void)::write(wakeFd_.get(), &one, sizeof(one));
+    }
+}
+
+void CallbackManager::Worker::push(const std::shared_ptr<const GPIOTarget>& target, const uint64_t eventNs,
+                                   const uint32_t coalesced, const uint8_t pin, const PinValue value) noexcept
+{
+    enqueue([&](Task& task) {
+        task.gpio = target;
+        task.pin = pin;
+        task.value = value;
+        task.eventNs = eventNs;
+        task.coalesced = coalesced;
+    });
+}
+
+void CallbackManager::Worker::push(const std::shared_ptr<const TimerTarget>& target, const uint64_t eventNs,
+                                   uint32_t) noexcept
+{
+    enqueue([&](Task& task) {
+        task.timer = target;
+        task.eventNs = eventNs;
+    });
+}
+
+void CallbackManager::Worker::push(const std::shared_ptr<const EventTarget>& target, const uint64_t eventNs,
+                                   uint32_t, const HALEvent& event) noexcept
+{
+    enqueue([&](Task& task) {
+        task.event = target;
+        task.payload = event;
+        task.eventNs = eventNs;
+    });
+}
+
+bool CallbackManager::Worker::pop(Task& task) noexcept
+{
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[head & mask_];
+    if (cell.turn.load(std::memory_order_acquire) != head + 1)
+    {
+        return false;
+    }
+
+    task = std::move(cell.task);
+    cell.turn.store(head + mask_ + 1, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_relaxed);
+    return true;
+}
+
+void CallbackManager::Worker::run()
+{
+    Task task;
+    for (;;)
+    {
+        if (pop(task))
+        {
+            if (task.gpio)
+            {
+                runTarget(*task.gpio, task.eventNs, task.coalesced, task.pin, task.value);
+            }
+            else if (task.timer)
+            {
+                runTarget(*task.timer, task.eventNs, 0);
+            }
+            else if (task.event)
+            {
+                runTarget(*task.event, task.eventNs, 0, task.payload);
+            }
+            task = Task{};
+            executed_.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        // Queued callbacks still run after stop() was requested
+        if (stopRequested_.load(std::memory_order_acquire))
+        {
+            break;
+        }
+
+        sleeping_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint64_t head = head_.load(std::memory_order_relaxed);
+        if (cells_[head & mask_].turn.load(std::memory_order_acquire) == head + 1 ||
+            stopRequested_.load(std::memory_order_acquire))
+        {
+            sleeping_.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        uint64_t count = 0;
+        (void)::read(wakeFd_.get(), &count, sizeof(count));
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+}
+
+CallbackWorkerStats CallbackManager::Worker::getStats() const
+{
+    CallbackWorkerStats stats;
+    stats.executed = executed_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    stats.queued = tail > head ? static_cast<size_t>(tail - head) : 0;
+    stats.scheduleApplied = scheduleApplied_;
+    return stats;
+}
+
+/**
+ * @brief Pending events of a batch subscription, as seen by the flush thread
+ */
+class CallbackManager::Batch
+{
+public:
+    /**
+     * @brief Constructor
+     * @param batchConfig The batch size and delay bounds, at least one event per batch
+     * @param budgetUs The execution budget of one delivery, 0 = unbounded
+     */
+    Batch(const BatchConfig& batchConfig, const uint32_t budgetUs)
+        : config{std::max<size_t>(batchConfig.maxEvents, 1), batchConfig.maxDelayUs}
+        , budgetNs(static_cast<uint64_t>(budgetUs) * 1000)
+    {
+    }
+
+    virtual ~Batch() = default;
+
+    /**
+     * @brief Deliver the pending events once no other delivery is in flight, does nothing within the delivery of this batch
+     */
+    virtual void flush() = 0;
+
+    /**
+     * @brief Get the expiry of the pending events
+     * @return The CLOCK_MONOTONIC expiry in nanoseconds, 0 if nothing is pending
+     */
+    [[nodiscard]] uint64_t deadlineNs() const
+    {
+        return deadlineNs_.load(std::memory_order_seq_cst);
+    }
+
+    const BatchConfig config;
+    const uint64_t budgetNs;
+    std::atomic<uint64_t> overruns{0};  // deliveries longer than budgetNs
+    std::atomic<uint64_t> dropped{0};   // events added while the buffer was full
+
+#ifdef HAL_CALLBACK_PROFILING
+    // Per delivered batch: from its oldest event to the start of the delivery, and the delivery
+    CallbackHistogram latency;
+    CallbackHistogram execution;
+#endif
+
+protected:
+    std::atomic<uint64_t> deadlineNs_{0};
+};
+
+/**
+ * @brief Batch subscription collecting events of one type
+ *
+ * Two buffers of a full batch each, allocated once. A producer reserves a slot
+ * of the active buffer with one fetch_add on the state word, copies its event
+ * and commits it; it never locks, allocates or waits. An event added to a full
+ * buffer is dropped and counted. A delivery exchanges the active buffer, waits
+ * for the reserved slots to be committed and calls the subscriber.
+ *
+ * Deliveries are serialized by an atomic flag. A producer that fills the buffer
+ * delivers it only if the flag is free; otherwise the delivering thread sees the
+ * full buffer once it clears the flag and delivers it next.
+ */
+template <typename Event, typename Callback>
+class CallbackManager::EventBatch final : public Batch
+{
+public:
+    /**
+     * @brief Constructor
+     * @param manager The manager running the flush thread
+     * @param callback The subscriber
+     * @param batchConfig The batch size and delay bounds
+     * @param budgetUs The execution budget of one delivery, 0 = unbounded
+     */
+    EventBatch(CallbackManager& manager, Callback callback, const BatchConfig& batchConfig, const uint32_t budgetUs)
+        : Batch(batchConfig, budgetUs)
+        , manager_(manager)
+        , callback_(std::move(callback))
+        , threshold_(config.maxDelayUs == 0 ? 1 : config.maxEvents)
+    {
+        buffers_[0].resize(config.maxEvents);
+        buffers_[1].resize(config.maxEvents);
+    }
+
+    /**
+     * @brief Append an event, delivering the batch if it is full and no delivery is in flight
+     * @param event The event, its timestamp starts the delay of a new batch
+     */
+    void add(const Event& event)
+    {
+        const uint64_t state = state_.fetch_add(1, std::memory_order_seq_cst);
+        const size_t buffer = state >> BUFFER_SHIFT;
+        const uint64_t slot = state & SLOT_MASK;
+
+        if (slot < config.maxEvents)
+        {
+            buffers_[buffer][slot] = event;
+            committed_[buffer].fetch_add(1, std::memory_order_release);
+
+            if (slot == 0 && threshold_ > 1)
+            {
+                const uint64_t deadlineNs = event.timestampNs + static_cast<uint64_t>(config.maxDelayUs) * 1000;
+                deadlineNs_.store(deadlineNs, std::memory_order_seq_cst);
+                manager_.scheduleFlush(deadlineNs);
+            }
+        }
+
+        // Dropped events are counted by the delivery from the reservations beyond the buffer
+        if (slot + 1 >= threshold_)
+        {
+            deliverDue();
+        }
+    }
+
+    void flush() override
+    {
+        if (deliveringBatch == this)
+        {
+            return;
+        }
+
+        // Only the flush thread and unregistration wait, never a producer
+        while (delivering_.exchange(true, std::memory_order_seq_cst))
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        deliver();
+        delivering_.store(false, std::memory_order_seq_cst);
+        deliverDue();
+    }
+
+private:
+    static constexpr unsigned BUFFER_SHIFT = 63;
+    static constexpr uint64_t SLOT_MASK = (uint64_t{1} << BUFFER_SHIFT) - 1;
+
+    /**
+     * @brief Deliver full buffers as long as no other delivery is in flight
+     *
+     * The reservation and the flag are both seq_cst, so of a producer filling the
+     * buffer and a delivery clearing the flag at least one sees the other.
+     */
+    void deliverDue()
+    {
+        while ((state_.load(std::memory_order_seq_cst) & SLOT_MASK) >= threshold_ &&
+               deliveringBatch != this && !delivering_.exchange(true, std::memory_order_seq_cst))
+        {
+            deliver();
+            delivering_.store(false, std::memory_order_seq_cst);
+        }
+    }
+
+    /**
+     * @brief Deliver the active buffer, delivering_ must be held
+     */
+    void deliver()
+    {
+        if ((state_.load(std::memory_order_seq_cst) & SLOT_MASK) == 0)
+        {
+            return;
+        }
+
+        // Cleared before the exchange, the first event of the next buffer sets it again
+        deadlineNs_.store(0, std::memory_order_seq_cst);
+        const uint64_t active = state_.load(std::memory_order_relaxed) & ~SLOT_MASK;
+        const uint64_t state = state_.exchange(active ^ (uint64_t{1} << BUFFER_SHIFT), std::memory_order_seq_cst);
+        const size_t buffer = state >> BUFFER_SHIFT;
+        const uint64_t reserved = state & SLOT_MASK;
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(reserved, config.maxEvents));
+
+        // A producer between its reservation and its commit finishes within a few instructions
+        while (committed_[buffer].load(std::memory_order_acquire) != count)
+        {
+            std::this_thread::yield();
+        }
+
+        Event* events = buffers_[buffer].data();
+        if constexpr (std::is_same_v<Event, GPIOEdgeEvent>)
+        {
+            // Dropped events leave a gap in the sequence
+            for (size_t i = 0; i < count; ++i)
+            {
+                events[i].sequence = sequence_ + i;
+            }
+        }
+        sequence_ += reserved;
+        if (reserved > count)
+        {
+            dropped.fetch_add(reserved - count, std::memory_order_relaxed);
+        }
+
+        deliveringBatch = this;
+#ifdef HAL_CALLBACK_PROFILING
+        const uint64_t startNs = monotonicNs();
+        const uint64_t oldestNs = events[0].timestampNs;
+        latency.record(startNs > oldestNs ? startNs - oldestNs : 0);
+        callback_(events, count);
+        const uint64_t executionNs = monotonicNs() - startNs;
+        execution.record(executionNs);
+#else
+        uint64_t executionNs = 0;
+        if (budgetNs == 0)
+        {
+            callback_(events, count);
+        }
+        else
+        {
+            const uint64_t startNs = monotonicNs();
+            callback_(events, count);
+            executionNs = monotonicNs() - startNs;
+        }
+#endif
+        if (budgetNs != 0 && executionNs > budgetNs)
+        {
+            overruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        deliveringBatch = nullptr;
+
+        // The buffer becomes active again only with a later exchange by the holder of delivering_
+        committed_[buffer].store(0, std::memory_order_relaxed);
+    }
+
+    CallbackManager& manager_;
+    Callback callback_;
+    const uint64_t threshold_;                  // reserved slots that make the buffer due
+    std::atomic<uint64_t> state_{0};            // active buffer in the top bit, reserved slots below
+    std::atomic<bool> delivering_{false};       // held by the delivering thread
+    std::array<std::vector<Event>, 2> buffers_;
+    std::array<std::atomic<size_t>, 2> committed_{};
+    uint64_t sequence_ = 0;                     // written only while delivering_ is held
+};
+
+CallbackManager::ReadGuard::ReadGuard(ReaderSlot& slot)
+    : slot_(slot)
+{
+    // Ordered before the snapshot load, a writer that sees the slot clear knows this dispatch loads the new snapshot
+    slot_.active.fetch_add(1, std::memory_order_seq_cst);
+}
+
+CallbackManager::ReadGuard::~ReadGuard()
+{
+    slot_.active.fetch_sub(1, std::memory_order_release);
+}
+
+CallbackManager::CallbackManager()
+    : gpioSnapshot_(new GPIOSnapshot())
+    , timerSnapshot_(new TimerSnapshot())
+    , eventSnapshot_(new EventSnapshot())
+{
+}
+
+CallbackManager::~CallbackManager()
+{
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        flusherStop_ = true;
+    }
+    batchWakeup_.notify_all();
+    if (flusherThread_.joinable())
+    {
+        flusherThread_.join();
+    }
+
+    for (auto& worker : workers_)
+    {
+        worker->stop();
+    }
+    delete gpioSnapshot_.load(std::memory_order_relaxed);
+    delete timerSnapshot_.load(std::memory_order_relaxed);
+    delete eventSnapshot_.load(std::memory_order_relaxed);
+}
+
 CallbackManager &CallbackManager::getInstance()
 {
     static CallbackManager instance;
     return instance;
 }
 
-uint64_t CallbackManager::registerGPIOCallback(const uint8_t pin, InterruptCallback callback)
+CallbackManager::ReaderSlot& CallbackManager::readerSlot()
+{
+    thread_local const size_t index = nextReaderSlot_.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+    return readerSlots_[index];
+}
+
+template <typename Snapshot>
+void CallbackManager::publish(std::atomic<const Snapshot*>& current,
+                              std::vector<std::unique_ptr<const Snapshot>>& retired,
+                              std::unique_ptr<Snapshot> snapshot)
 {
-    std::unique_lock<std::shared_mutex> lock(gpioCallbackMutex_);
+    const Snapshot* previous = current.exchange(snapshot.release(), std::memory_order_seq_cst);
+    retired.emplace_back(previous);
+    reclaim();
+}
 
+template <typename Key, typename T, typename Callback>
+uint64_t CallbackManager::registerKeyed(std::atomic<const KeyedSnapshot<Key, T>*>& current,
+                                        std::vector<std::unique_ptr<const KeyedSnapshot<Key, T>>>& retired,
+                                        std::unordered_map<uint64_t, std::shared_ptr<const T>>& targets,
+                                        const Key& key, Callback callback, const CallbackSchedule& schedule,
+                                        const bool profiled)
+{
     const uint64_t callbackId = nextCallbackId_.fetch_add(1, std::memory_order_relaxed);
 
-    GPIOCallbackInfo info;
-    info.pin = pin;
-    info.callback = std::move(callback);
+    auto snapshot = std::make_unique<KeyedSnapshot<Key, T>>(*current.load(std::memory_order_relaxed));
+    auto &byKey = snapshot->byKey;
+    auto keyIt = std::lower_bound(byKey.begin(), byKey.end(), key,
+                                  [](const auto& entry, const Key& k) { return entry.first < k; });
+    if (keyIt == byKey.end() || keyIt->first != key)
+    {
+        keyIt = byKey.insert(keyIt, {key, {}});
+    }
+
+    // The histograms are not movable, the target is built in place
+    auto target = std::make_shared<T>();
+    target->callback = std::move(callback);
+    target->key = key;
+    target->budgetNs = profiled ? static_cast<uint64_t>(schedule.budgetUs) * 1000 : 0;
+#ifdef HAL_CALLBACK_PROFILING
+    target->profiled = profiled;
+#else
+    (void)profiled;
+#endif
+    keyIt->second.push_back({callbackId, target, schedule, selectWorker(schedule)});
+    publish(current, retired, std::move(snapshot));
 
-    gpioCallbacks_[callbackId] = std::move(info);
-    gpioCallbacksByPin_[pin].push_back(callbackId);
+    targets[callbackId] = std::move(target);
 
     return callbackId;
 }
 
-bool CallbackManager::unregisterGPIOCallback(uint64_t callbackId)
+template <typename Key, typename T>
+bool CallbackManager::unregisterKeyed(std::atomic<const KeyedSnapshot<Key, T>*>& current,
+                                      std::vector<std::unique_ptr<const KeyedSnapshot<Key, T>>>& retired,
+                                      std::unordered_map<uint64_t, std::shared_ptr<const T>>& targets,
+                                      const uint64_t callbackId)
 {
-    std::unique_lock<std::shared_mutex> lock(gpioCallbackMutex_);
-
-    const auto it = gpioCallbacks_.find(callbackId);
-    if (it == gpioCallbacks_.end())
+    const auto it = targets.find(callbackId);
+    if (it == targets.end())
     {
         return false;
     }
 
-    const uint8_t pin = it->second.pin;
-    gpioCallbacks_.erase(it);
+    const Key key = it->second->key;
+    targets.erase(it);
 
-    // Remove from pin-specific list
-    auto &callbacks = gpioCallbacksByPin_[pin];
-    callbacks.erase(std::remove(callbacks.begin(), callbacks.end(), callbackId), callbacks.end());
-
-    if (callbacks.empty())
+    auto snapshot = std::make_unique<KeyedSnapshot<Key, T>>(*current.load(std::memory_order_relaxed));
+    auto &byKey = snapshot->byKey;
+    const auto keyIt = std::lower_bound(byKey.begin(), byKey.end(), key,
+                                        [](const auto& entry, const Key& k) { return entry.first < k; });
+    if (keyIt != byKey.end() && keyIt->first == key)
     {
-        gpioCallbacksByPin_.erase(pin);
+        auto &callbacks = keyIt->second;
+        callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                       [callbackId](const Entry<T>& entry) { return entry.id == callbackId; }),
+                        callbacks.end());
+
+        if (callbacks.empty())
+        {
+            byKey.erase(keyIt);
+        }
     }
+    publish(current, retired, std::move(snapshot));
 
     return true;
 }
 
-void CallbackManager::invokeGPIOCallback(const uint8_t pin, const PinValue value)
+void CallbackManager::reclaim()
 {
-    std::shared_lock<std::shared_mutex> lock(gpioCallbackMutex_);
+    // A dispatch that marked its slot after the exchange loads the new snapshot, so clear slots end every grace period
+    for (const ReaderSlot& slot : readerSlots_)
+    {
+        if (slot.active.load(std::memory_order_seq_cst) != 0)
+        {
+            return;
+        }
+    }
+
+    retiredGpio_.clear();
+    retiredTimer_.clear();
+    retiredEvent_.clear();
+}
 
-    const auto it = gpioCallbacksByPin_.find(pin);
-    if (it == gpioCallbacksByPin_.end())
+CallbackManager::Worker* CallbackManager::selectWorker(const CallbackSchedule& schedule) const
+{
+    if (schedule.priority < 0)
     {
-        return;
+        return nullptr;
     }
 
-    // Create a copy of callback IDs to prevent deadlock if callback modifies callbacks
-    const std::vector<uint64_t> callbackIds = it->second;
-    lock.unlock();
+    // The band of a worker reaches up to the next higher worker priority
+    Worker* selected = nullptr;
+    for (const auto& worker : workers_)
+    {
+        if (worker->config.priority > schedule.priority)
+        {
+            continue;
+        }
 
-    // Invoke callbacks without holding the lock
-    for (uint64_t callbackId: callbackIds)
+        if (selected == nullptr || worker->config.priority > selected->config.priority ||
+            (worker->config.priority == selected->config.priority && schedule.cpu >= 0 &&
+             worker->config.cpu == schedule.cpu && selected->config.cpu != schedule.cpu))
+        {
+            selected = worker.get();
+        }
+    }
+
+    return selected;
+}
+
+void CallbackManager::rebindWorkers()
+{
+    auto gpio = std::make_unique<GPIOSnapshot>(*gpioSnapshot_.load(std::memory_order_relaxed));
+    for (auto& callbacks : gpio->byPin)
     {
-        std::shared_lock<std::shared_mutex> callbackLock(gpioCallbackMutex_);
-        auto callbackIt = gpioCallbacks_.find(callbackId);
-        if (callbackIt != gpioCallbacks_.end() && callbackIt->second.callback)
+        for (auto& entry : callbacks)
         {
-            // Copy the callback to invoke outside the lock
-            auto callback = callbackIt->second.callback;
-            callbackLock.unlock();
-            callback(pin, value);
+            entry.worker = selectWorker(entry.schedule);
         }
     }
+    publish(gpioSnapshot_, retiredGpio_, std::move(gpio));
+
+    auto timer = std::make_unique<TimerSnapshot>(*timerSnapshot_.load(std::memory_order_relaxed));
+    for (auto& callbacks : timer->byKey)
+    {
+        for (auto& entry : callbacks.second)
+        {
+            entry.worker = selectWorker(entry.schedule);
+        }
+    }
+    publish(timerSnapshot_, retiredTimer_, std::move(timer));
+
+    auto event = std::make_unique<EventSnapshot>(*eventSnapshot_.load(std::memory_order_relaxed));
+    for (auto& callbacks : event->byKey)
+    {
+        for (auto& entry : callbacks.second)
+        {
+            entry.worker = selectWorker(entry.schedule);
+        }
+    }
+    publish(eventSnapshot_, retiredEvent_, std::move(event));
 }
 
-uint64_t CallbackManager::registerTimerCallback(const uint32_t timerId, TimerCallback callback)
+void CallbackManager::waitForReaders() const
 {
-    std::unique_lock<std::shared_mutex> lock(timerCallbackMutex_);
+    for (const ReaderSlot& slot : readerSlots_)
+    {
+        while (slot.active.load(std::memory_order_seq_cst) != 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
 
-    const uint64_t callbackId = nextCallbackId_.fetch_add(1, std::memory_order_relaxed);
+void CallbackManager::addBatch(const uint64_t callbackId, std::shared_ptr<Batch> batch)
+{
+    std::lock_guard<std::mutex> lock(batchMutex_);
 
-    TimerCallbackInfo info;
-    info.timerId = timerId;
-    info.callback = std::move(callback);
+    const bool delayed = batch->config.maxDelayUs != 0 && batch->config.maxEvents > 1;
+    batches_[callbackId] = std::move(batch);
 
-    timerCallbacks_[callbackId] = std::move(info);
-    timerCallbacksById_[timerId].push_back(callbackId);
+    if (delayed && !flusherThread_.joinable())
+    {
+        flusherThread_ = std::thread(&CallbackManager::runFlusher, this);
+    }
+    batchWakeup_.notify_one();
+}
 
-    return callbackId;
+void CallbackManager::removeBatch(const uint64_t callbackId)
+{
+    std::shared_ptr<Batch> batch;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        const auto it = batches_.find(callbackId);
+        if (it == batches_.end())
+        {
+            return;
+        }
+        batch = std::move(it->second);
+        batches_.erase(it);
+    }
+
+    batch->flush();
 }
 
-bool CallbackManager::unregisterTimerCallback(const uint64_t callbackId)
+void CallbackManager::flushBatches()
 {
-    std::unique_lock<std::shared_mutex> lock(timerCallbackMutex_);
+    std::vector<std::shared_ptr<Batch>> batches;
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        batches.reserve(batches_.size());
+        for (const auto& [id, batch] : batches_)
+        {
+            batches.push_back(batch);
+        }
+    }
+
+    for (const auto& batch : batches)
+    {
+        batch->flush();
+    }
+}
 
-    const auto it = timerCallbacks_.find(callbackId);
-    if (it == timerCallbacks_.end())
+void CallbackManager::scheduleFlush(const uint64_t deadlineNs)
+{
+    // Pairs with the flush thread publishing its wake-up time before scanning the deadlines
+    if (deadlineNs < nextFlushNs_.load(std::memory_order_seq_cst))
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        batchWakeup_.notify_one();
+    }
+}
+
+void CallbackManager::runFlusher()
+{
+    std::vector<std::shared_ptr<Batch>> due;
+    std::unique_lock<std::mutex> lock(batchMutex_);
+
+    while (!flusherStop_)
+    {
+        // Producers starting a batch during the scan see no wake-up time and notify
+        nextFlushNs_.store(UINT64_MAX, std::memory_order_seq_cst);
+
+        const uint64_t nowNs = monotonicNs();
+        uint64_t nextNs = UINT64_MAX;
+        for (const auto& [id, batch] : batches_)
+        {
+            const uint64_t deadlineNs = batch->deadlineNs();
+            if (deadlineNs == 0)
+            {
+                continue;
+            }
+
+            if (deadlineNs <= nowNs)
+            {
+                due.push_back(batch);
+            }
+            else
+            {
+                nextNs = std::min(nextNs, deadlineNs);
+            }
+        }
+
+        if (!due.empty())
+        {
+            lock.unlock();
+            for (const auto& batch : due)
+            {
+                batch->flush();
+            }
+            due.clear();
+            lock.lock();
+            continue;
+        }
+
+        nextFlushNs_.store(nextNs, std::memory_order_seq_cst);
+        if (nextNs == UINT64_MAX)
+        {
+            batchWakeup_.wait(lock);
+        }
+        else
+        {
+            // steady_clock is CLOCK_MONOTONIC, the wait targets the absolute deadline
+            batchWakeup_.wait_until(lock, std::chrono::steady_clock::time_point{std::chrono::nanoseconds(nextNs)});
+        }
+    }
+}
+
+bool CallbackManager::startExecutor(const std::vector<CallbackWorkerConfig>& workers)
+{
+    std::lock_guard<std::mutex> executorLock(executorMutex_);
+
+    if (workers.empty())
     {
         return false;
     }
 
-    const uint32_t timerId = it->second.timerId;
-    timerCallbacks_.erase(it);
+    for (const CallbackWorkerConfig& config : workers)
+    {
+        if (!ThreadConfig::isValid(ThreadSchedule{config.priority, config.cpu}) || config.queueCapacity == 0)
+        {
+            return false;
+        }
+    }
 
-    // Remove from timer-specific list
-    auto &callbacks = timerCallbacksById_[timerId];
-    callbacks.erase(std::remove(callbacks.begin(), callbacks.end(), callbackId), callbacks.end());
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    if (!workers_.empty())
+    {
+        return false;
+    }
 
-    if (callbacks.empty())
+    std::vector<std::unique_ptr<Worker>> started;
+    for (const CallbackWorkerConfig& config : workers)
     {
-        timerCallbacksById_.erase(timerId);
+        started.push_back(std::make_unique<Worker>(config));
+        if (!started.back()->start())
+        {
+            return false;
+        }
     }
 
+    workers_ = std::move(started);
+    rebindWorkers();
     return true;
 }
 
+void CallbackManager::stopExecutor()
+{
+    std::lock_guard<std::mutex> executorLock(executorMutex_);
+
+    std::vector<std::unique_ptr<Worker>> stopped;
+    {
+        std::lock_guard<std::mutex> lock(registrationMutex_);
+        stopped = std::move(workers_);
+        workers_.clear();
+        rebindWorkers();
+    }
+
+    // A dispatch that loaded an older snapshot may still queue to the workers, callbacks may register meanwhile
+    waitForReaders();
+    for (auto& worker : stopped)
+    {
+        worker->stop();
+    }
+}
+
+size_t CallbackManager::getExecutorWorkerCount() const
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    return workers_.size();
+}
+
+CallbackWorkerStats CallbackManager::getExecutorStats(const size_t worker) const
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    if (worker >= workers_.size())
+    {
+        return {};
+    }
+
+    return workers_[worker]->getStats();
+}
+
+void CallbackManager::setGPIOCallbackSchedule(const uint8_t pin, const CallbackSchedule& schedule)
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    pinSchedules_[pin] = schedule;
+}
+
+uint64_t CallbackManager::registerGPIOCallback(const uint8_t pin, InterruptCallback callback)
+{
+    CallbackSchedule schedule;
+    {
+        std::lock_guard<std::mutex> lock(registrationMutex_);
+        schedule = pinSchedules_[pin];
+    }
+
+    return registerGPIOCallback(pin, std::move(callback), schedule);
+}
+
+uint64_t CallbackManager::registerGPIOCallback(const uint8_t pin, InterruptCallback callback,
+                                               const CallbackSchedule& schedule)
+{
+    return registerGPIOTarget(pin, std::move(callback), schedule, true);
+}
+
+uint64_t CallbackManager::registerGPIOTarget(const uint8_t pin, InterruptCallback callback,
+                                             const CallbackSchedule& schedule, const bool profiled)
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+
+    const uint64_t callbackId = nextCallbackId_.fetch_add(1, std::memory_order_relaxed);
+
+    auto target = std::make_shared<GPIOTarget>();
+    target->callback = std::move(callback);
+    target->key = pin;
+    target->budgetNs = profiled ? static_cast<uint64_t>(schedule.budgetUs) * 1000 : 0;
+#ifdef HAL_CALLBACK_PROFILING
+    target->profiled = profiled;
+#else
+    (void)profiled;
+#endif
+
+    auto snapshot = std::make_unique<GPIOSnapshot>(*gpioSnapshot_.load(std::memory_order_relaxed));
+    snapshot->byPin[pin].push_back({callbackId, target, schedule, selectWorker(schedule)});
+    publish(gpioSnapshot_, retiredGpio_, std::move(snapshot));
+
+    gpioTargets_[callbackId] = std::move(target);
+
+    return callbackId;
+}
+
+bool CallbackManager::unregisterGPIOCallback(uint64_t callbackId)
+{
+    {
+        std::lock_guard<std::mutex> lock(registrationMutex_);
+
+        const auto it = gpioTargets_.find(callbackId);
+        if (it == gpioTargets_.end())
+        {
+            return false;
+        }
+
+        const uint8_t pin = it->second->key;
+        gpioTargets_.erase(it);
+
+        // Callbacks are shared between snapshots, only the list of the pin changes
+        auto snapshot = std::make_unique<GPIOSnapshot>(*gpioSnapshot_.load(std::memory_order_relaxed));
+        auto &callbacks = snapshot->byPin[pin];
+        callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                       [callbackId](const Entry<GPIOTarget>& entry) { return entry.id == callbackId; }),
+                        callbacks.end());
+        publish(gpioSnapshot_, retiredGpio_, std::move(snapshot));
+    }
+
+    // The pending edges of a batch subscription are delivered on this thread
+    removeBatch(callbackId);
+    return true;
+}
+
+uint64_t CallbackManager::registerGPIOBatchCallback(const uint8_t pin, GPIOBatchCallback callback,
+                                                    const BatchConfig& config, const CallbackSchedule& schedule)
+{
+    auto batch = std::make_shared<EventBatch<GPIOEdgeEvent, GPIOBatchCallback>>(*this, std::move(callback), config,
+                                                                               schedule.budgetUs);
+
+    const uint64_t callbackId = registerGPIOTarget(pin, [batch](const uint8_t edgePin, const PinValue value) {
+        GPIOEdgeEvent event;
+        event.pin = edgePin;
+        event.value = value;
+        event.timestampNs = dispatchEventNs != 0 ? dispatchEventNs : monotonicNs();
+        event.coalesced = dispatchCoalesced;
+        batch->add(event);
+    }, schedule, false);
+
+    addBatch(callbackId, std::move(batch));
+    return callbackId;
+}
+
+void CallbackManager::invokeGPIOCallback(const uint8_t pin, const PinValue value)
+{
+#ifdef HAL_CALLBACK_PROFILING
+    invokeGPIOCallback(pin, value, monotonicNs());
+#else
+    invokeGPIOCallback(pin, value, 0);
+#endif
+}
+
+void CallbackManager::invokeGPIOCallback(const uint8_t pin, const PinValue value, const uint64_t eventNs,
+                                         const uint32_t coalesced)
+{
+    ReadGuard guard(readerSlot());
+    const GPIOSnapshot* snapshot = gpioSnapshot_.load(std::memory_order_seq_cst);
+
+    // The snapshot stays alive until the guard is released, callbacks may register and unregister freely
+    dispatch(snapshot->byPin[pin], eventNs, coalesced, pin, value);
+}
+
+uint64_t CallbackManager::registerTimerCallback(const uint32_t timerId, TimerCallback callback)
+{
+    return registerTimerCallback(timerId, std::move(callback), CallbackSchedule{});
+}
+
+uint64_t CallbackManager::registerTimerCallback(const uint32_t timerId, TimerCallback callback,
+                                                const CallbackSchedule& schedule)
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    return registerKeyed(timerSnapshot_, retiredTimer_, timerTargets_, timerId, std::move(callback), schedule, true);
+}
+
+bool CallbackManager::unregisterTimerCallback(const uint64_t callbackId)
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    return unregisterKeyed(timerSnapshot_, retiredTimer_, timerTargets_, callbackId);
+}
+
 void CallbackManager::invokeTimerCallback(const uint32_t timerId)
 {
-    std::shared_lock<std::shared_mutex> lock(timerCallbackMutex_);
+#ifdef HAL_CALLBACK_PROFILING
+    invokeTimerCallback(timerId, monotonicNs());
+#else
+    invokeTimerCallback(timerId, 0);
+#endif
+}
+
+void CallbackManager::invokeTimerCallback(const uint32_t timerId, const uint64_t eventNs)
+{
+    ReadGuard guard(readerSlot());
+    const TimerSnapshot* snapshot = timerSnapshot_.load(std::memory_order_seq_cst);
 
-    const auto it = timerCallbacksById_.find(timerId);
-    if (it == timerCallbacksById_.end())
+    if (const auto* callbacks = findEntries(snapshot->byKey, timerId))
     {
-        return;
+        dispatch(*callbacks, eventNs, 0);
     }
+}
+
+uint64_t CallbackManager::registerEventCallback(const ResourceType type, const uint64_t source,
+                                                EventCallback callback)
+{
+    return registerEventCallback(type, source, std::move(callback), CallbackSchedule{});
+}
 
-    // Create a copy of callback IDs to prevent deadlock
-    const std::vector<uint64_t> callbackIds = it->second;
-    lock.unlock();
+uint64_t CallbackManager::registerEventCallback(const ResourceType type, const uint64_t source,
+                                                EventCallback callback, const CallbackSchedule& schedule)
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    return registerKeyed(eventSnapshot_, retiredEvent_, eventTargets_, EventKey{type, source}, std::move(callback),
+                         schedule, true);
+}
 
-    // Invoke callbacks without holding the lock
-    for (uint64_t callbackId: callbackIds)
+bool CallbackManager::unregisterEventCallback(const uint64_t callbackId)
+{
     {
-        std::shared_lock<std::shared_mutex> callbackLock(timerCallbackMutex_);
-        auto callbackIt = timerCallbacks_.find(callbackId);
-        if (callbackIt != timerCallbacks_.end() && callbackIt->second.callback)
+        std::lock_guard<std::mutex> lock(registrationMutex_);
+        if (!unregisterKeyed(eventSnapshot_, retiredEvent_, eventTargets_, callbackId))
         {
-            auto callback = callbackIt->second.callback;
-            callbackLock.unlock();
-            callback();
+            return false;
         }
     }
+
+    removeBatch(callbackId);
+    return true;
+}
+
+uint64_t CallbackManager::registerEventBatchCallback(const ResourceType type, const uint64_t source,
+                                                     EventBatchCallback callback, const BatchConfig& config,
+                                                     const CallbackSchedule& schedule)
+{
+    auto batch = std::make_shared<EventBatch<HALEvent, EventBatchCallback>>(*this, std::move(callback), config,
+                                                                           schedule.budgetUs);
+
+    uint64_t callbackId = 0;
+    {
+        std::lock_guard<std::mutex> lock(registrationMutex_);
+        callbackId = registerKeyed(eventSnapshot_, retiredEvent_, eventTargets_, EventKey{type, source},
+                                   EventCallback([batch](const HALEvent& event) { batch->add(event); }), schedule,
+                                   false);
+    }
+
+    addBatch(callbackId, std::move(batch));
+    return callbackId;
+}
+
+void CallbackManager::publishEvent(const ResourceType type, const uint64_t source, const HALEventKind kind,
+                                   const uint64_t value, const uint32_t channel)
+{
+    ReadGuard guard(readerSlot());
+    const EventSnapshot* snapshot = eventSnapshot_.load(std::memory_order_seq_cst);
+
+    // Devices publish on every transfer, an unobserved event costs no more than the lookups
+    if (snapshot->byKey.empty())
+    {
+        return;
+    }
+
+    const auto* device = findEntries(snapshot->byKey, EventKey{type, source});
+    const auto* anySource = source != EventKey::ANY_SOURCE
+                                ? findEntries(snapshot->byKey, EventKey{type, EventKey::ANY_SOURCE})
+                                : nullptr;
+    if (device == nullptr && anySource == nullptr)
+    {
+        return;
+    }
+
+    HALEvent event;
+    event.type = type;
+    event.source = source;
+    event.kind = kind;
+    event.channel = channel;
+    event.value = value;
+    event.timestampNs = monotonicNs();
+
+    if (device != nullptr)
+    {
+        dispatch(*device, event.timestampNs, 0, event);
+    }
+    if (anySource != nullptr)
+    {
+        dispatch(*anySource, event.timestampNs, 0, event);
+    }
 }
 
 void CallbackManager::clearAll()
 {
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+
+    gpioTargets_.clear();
+    timerTargets_.clear();
+    eventTargets_.clear();
+    pinSchedules_.fill(CallbackSchedule{});
+    publish(gpioSnapshot_, retiredGpio_, std::make_unique<GPIOSnapshot>());
+    publish(timerSnapshot_, retiredTimer_, std::make_unique<TimerSnapshot>());
+    publish(eventSnapshot_, retiredEvent_, std::make_unique<EventSnapshot>());
+
+    // Pending batches are discarded with their subscriptions
+    std::lock_guard<std::mutex> batchLock(batchMutex_);
+    batches_.clear();
+}
+
+std::vector<CallbackProfile> CallbackManager::getCallbackProfiles() const
+{
+    std::vector<CallbackProfile> profiles;
+    if (!PROFILING_ENABLED)
     {
-        std::unique_lock<std::shared_mutex> lock(gpioCallbackMutex_);
-        gpioCallbacks_.clear();
-        gpioCallbacksByPin_.clear();
+        return profiles;
     }
 
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    profiles.reserve(gpioTargets_.size() + timerTargets_.size() + eventTargets_.size());
+
+    for (const auto& [id, target] : gpioTargets_)
     {
-        std::unique_lock<std::shared_mutex> lock(timerCallbackMutex_);
-        timerCallbacks_.clear();
-        timerCallbacksById_.clear();
+        CallbackProfile profile;
+        profile.callbackId = id;
+        profile.source = target->key;
+        summarize(*target, profile);
+        profiles.push_back(profile);
     }
+
+    for (const auto& [id, target] : timerTargets_)
+    {
+        CallbackProfile profile;
+        profile.callbackId = id;
+        profile.kind = CallbackKind::TIMER;
+        profile.source = target->key;
+        summarize(*target, profile);
+        profiles.push_back(profile);
+    }
+
+    for (const auto& [id, target] : eventTargets_)
+    {
+        CallbackProfile profile;
+        profile.callbackId = id;
+        profile.kind = CallbackKind::EVENT;
+        profile.resourceType = target->key.type;
+        profile.source = target->key.source;
+        summarize(*target, profile);
+        profiles.push_back(profile);
+    }
+
+    std::sort(profiles.begin(), profiles.end(),
+              [](const CallbackProfile& a, const CallbackProfile& b) { return a.callbackId < b.callbackId; });
+    for (CallbackProfile& profile : profiles)
+    {
+        summarizeBatch(profile);
+    }
+    return profiles;
+}
+
+bool CallbackManager::getCallbackProfile(const uint64_t callbackId, CallbackProfile& profile) const
+{
+    if (!PROFILING_ENABLED)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    profile = CallbackProfile{};
+    profile.callbackId = callbackId;
+
+    if (const auto it = gpioTargets_.find(callbackId); it != gpioTargets_.end())
+    {
+        profile.source = it->second->key;
+        summarize(*it->second, profile);
+        summarizeBatch(profile);
+        return true;
+    }
+
+    if (const auto it = timerTargets_.find(callbackId); it != timerTargets_.end())
+    {
+        profile.kind = CallbackKind::TIMER;
+        profile.source = it->second->key;
+        summarize(*it->second, profile);
+        return true;
+    }
+
+    if (const auto it = eventTargets_.find(callbackId); it != eventTargets_.end())
+    {
+        profile.kind = CallbackKind::EVENT;
+        profile.resourceType = it->second->key.type;
+        profile.source = it->second->key.source;
+        summarize(*it->second, profile);
+        summarizeBatch(profile);
+        return true;
+    }
+
+    return false;
+}
+
+void CallbackManager::summarizeBatch(CallbackProfile& profile) const
+{
+    std::lock_guard<std::mutex> lock(batchMutex_);
+    const auto it = batches_.find(profile.callbackId);
+    if (it != batches_.end())
+    {
+        profile.overruns = it->second->overruns.load(std::memory_order_relaxed);
+#ifdef HAL_CALLBACK_PROFILING
+        profile.latency = it->second->latency.summary();
+        profile.execution = it->second->execution.summary();
+#endif
+    }
+}
+
+uint64_t CallbackManager::getCallbackOverruns(const uint64_t callbackId) const
+{
+    {
+        std::lock_guard<std::mutex> lock(batchMutex_);
+        if (const auto it = batches_.find(callbackId); it != batches_.end())
+        {
+            return it->second->overruns.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+
+    if (const auto it = gpioTargets_.find(callbackId); it != gpioTargets_.end())
+    {
+        return it->second->overruns.load(std::memory_order_relaxed);
+    }
+    if (const auto it = timerTargets_.find(callbackId); it != timerTargets_.end())
+    {
+        return it->second->overruns.load(std::memory_order_relaxed);
+    }
+    if (const auto it = eventTargets_.find(callbackId); it != eventTargets_.end())
+    {
+        return it->second->overruns.load(std::memory_order_relaxed);
+    }
+    return 0;
+}
+
+uint64_t CallbackManager::getBatchDrops(const uint64_t callbackId) const
+{
+    std::lock_guard<std::mutex> lock(batchMutex_);
+    const auto it = batches_.find(callbackId);
+    return it != batches_.end() ? it->second->dropped.load(std::memory_order_relaxed) : 0;
 }
 
+void CallbackManager::resetCallbackProfiles()
+{
+    std::lock_guard<std::mutex> lock(registrationMutex_);
+    for (const auto& [id, target] : gpioTargets_)
+    {
+        target->overruns.store(0, std::memory_order_relaxed);
+    }
+    for (const auto& [id, target] : timerTargets_)
+    {
+        target->overruns.store(0, std::memory_order_relaxed);
+    }
+    for (const auto& [id, target] : eventTargets_)
+    {
+        target->overruns.store(0, std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> batchLock(batchMutex_);
+    for (const auto& [id, batch] : batches_)
+    {
+        batch->overruns.store(0, std::memory_order_relaxed);
+#ifdef HAL_CALLBACK_PROFILING
+        batch->latency.reset();
+        batch->execution.reset();
+#endif
+    }
+
+#ifdef HAL_CALLBACK_PROFILING
+    for (const auto& [id, target] : gpioTargets_)
+    {
+        target->latency.reset();
+        target->execution.reset();
+    }
+    for (const auto& [id, target] : timerTargets_)
+    {
+        target->latency.reset();
+        target->execution.reset();
+    }
+    for (const auto& [id, target] : eventTargets_)
+    {
+        target->latency.reset();
+        target->execution.reset();
+    }
+#endif
+}
@@ -1,20 +1,31 @@
 #include "../include/hal/core.h"
 #include "gpio/gpio_linux.h"
+#include "gpio/gpio_cdev.h"
 #include "spi/spi_linux.h"
+#include "spi/spi_bitbang.h"
 #include "i2c/i2c_linux.h"
+#include "i2c/i2c_bitbang.h"
 #include "uart/uart_linux.h"
 #include "pwm/pwm_linux.h"
 #include "adc/adc_linux.h"
 #include "timer/timer_linux.h"
+#include "device_config/device_config.h"
 #include <sched.h>
 #include <sys/mman.h>
 #include <stdexcept>
 #include <cstdio>
+#include <optional>
 
 using namespace mex_hal;
 
 class HALLinux : public HAL
 {
+private:
+    std::optional<SoftSPIPins> softSpiPins_;
+    GPIOBackend softSpiBackend_ = GPIOBackend::CDEV;
+    std::optional<SoftI2CPins> softI2cPins_;
+    GPIOBackend softI2cBackend_ = GPIOBackend::CDEV;
+
 public:
     HALLinux() = default;
     ~HALLinux() override = default;
@@ -138,8 +149,55 @@ public:
     }
 
     std::unique_ptr<GPIOInterface> createGPIO() override { return std::make_unique<GPIOLinux>(); }
-    std::unique_ptr<SPIInterface> createSPI() override { return std::make_unique<SPILinux>(); }
-    std::unique_ptr<I2CInterface> createI2C() override { return std::make_unique<I2CLinux>(); }
+    std::unique_ptr<GPIOInterface> createGPIO(const GPIOBackend backend) override
+    {
+        if (backend == GPIOBackend::CDEV)
+        {
+            return std::make_unique<GPIOCdev>();
+        }
+        return std::make_unique<GPIOLinux>();
+    }
+    void setSoftSPIPins(const SoftSPIPins& pins, const GPIOBackend backend) override
+    {
+        softSpiPins_ = pins;
+        softSpiBackend_ = backend;
+    }
+
+    void setSoftI2CPins(const SoftI2CPins& pins, const GPIOBackend backend) override
+    {
+        softI2cPins_ = pins;
+        softI2cBackend_ = backend;
+    }
+
+    std::unique_ptr<SPIInterface> createSPI() override
+    {
+        if (softSpiPins_)
+        {
+            // Only the SPI nodes decide the backend, a full scan would also walk the GPIO sysfs tree
+            DeviceConfig& config = DeviceConfig::getInstance();
+            config.refreshSPI();
+            if (config.getSpiInfos().empty())
+            {
+                return std::make_unique<SPIBitBang>(createGPIO(softSpiBackend_), *softSpiPins_);
+            }
+        }
+        return std::make_unique<SPILinux>();
+    }
+
+    std::unique_ptr<I2CInterface> createI2C() override
+    {
+        if (softI2cPins_)
+        {
+            DeviceConfig& config = DeviceConfig::getInstance();
+            config.refreshI2C();
+            if (config.getI2cInfos().empty())
+            {
+                return std::make_unique<I2CBitBang>(createGPIO(softI2cBackend_), *softI2cPins_);
+            }
+        }
+        return std::make_unique<I2CLinux>();
+    }
+
     std::unique_ptr<UARTInterface> createUART() override { return std::make_unique<UARTLinux>(); }
     std::unique_ptr<PWMInterface> createPWM() override { return std::make_unique<PWMLinux>(); }
     std::unique_ptr<TimerInterface> createTimer() override { return std::make_unique<TimerLinux>(); }
@@ -4,6 +4,7 @@
 #include <regex>
 #include <iostream>
 #include <mutex>
+#include <system_error>
 
 namespace fs = std::filesystem;
 
@@ -24,9 +25,25 @@ void DeviceConfig::scan()
     scanUART();
 }
 
+void DeviceConfig::refreshSPI()
+{
+    std::lock_guard<std::mutex> lock(scanMutex_);
+    spiDevices_.clear();
+    scanSPI();
+}
+
+void DeviceConfig::refreshI2C()
+{
+    std::lock_guard<std::mutex> lock(scanMutex_);
+    i2cDevices_.clear();
+    scanI2C();
+}
+
 void DeviceConfig::scanSPI()
 {
-    for (const auto& entry : fs::directory_iterator("/dev"))
+    // A missing directory means no devices of that kind, not an error
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator("/dev", ec))
     {
         if (entry.path().string().find("spidev") != std::string::npos)
         {
@@ -46,7 +63,8 @@ void DeviceConfig::scanSPI()
 
 void DeviceConfig::scanI2C()
 {
-    for (const auto& entry : fs::directory_iterator("/dev"))
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator("/dev", ec))
     {
         if (entry.path().string().find("i2c-") != std::string::npos)
         {
@@ -66,8 +84,9 @@ void DeviceConfig::scanI2C()
 void DeviceConfig::scanGPIO()
 {
     const std::string base = "/sys/class/gpio";
+    std::error_code ec;
 
-    for (const auto& entry : fs::directory_iterator(base))
+    for (const auto& entry : fs::directory_iterator(base, ec))
     {
         if (entry.path().filename().string().rfind("gpio", 0) == 0 &&
             entry.path().filename().string() != "gpiochip0")
@@ -98,7 +117,8 @@ void DeviceConfig::scanGPIO()
 
 void DeviceConfig::scanUART()
 {
-    for (const auto& entry : fs::directory_iterator("/dev"))
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator("/dev", ec))
     {
         std::string name = entry.path().filename();
         if (name.find("ttyS") == 0 ||
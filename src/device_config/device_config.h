@@ -3,7 +3,7 @@
 
 #include <vector>
 #include <mutex>
-#include "../include/hal/device_infos_types.h"
+#include "../../include/hal/device_infos_types.h"
 
 /// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
 namespace mex_hal
@@ -60,6 +60,16 @@ namespace mex_hal
          */
         void scan();
 
+        /**
+         * @brief Rescan only the SPI devices, the other device lists are kept
+         */
+        void refreshSPI();
+
+        /**
+         * @brief Rescan only the I2C devices, the other device lists are kept
+         */
+        void refreshI2C();
+
         /**
          * @brief Print information about all detected devices
          */
@@ -0,0 +1,931 @@
+#include "gpio_cdev.h"
+#include "../../include/hal/callback_manager.h"
+#include "../monotonic_clock/monotonic_clock.h"
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/timerfd.h>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+using namespace mex_hal;
+
+int GPIOCdevIo::openChip(const std::string& path)
+{
+    return ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+}
+
+int GPIOCdevIo::ioctl(const int fd, const unsigned long request, void* arg)
+{
+    return ::ioctl(fd, request, arg);
+}
+
+GPIOCdev::GPIOCdev(std::string chipPath, std::shared_ptr<GPIOCdevIo> io)
+    : chipPath_(std::move(chipPath))
+    , io_(io ? std::move(io) : std::make_shared<GPIOCdevIo>())
+{
+    chipFd_.reset(io_->openChip(chipPath_));
+    wakeFd_.reset(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    timerFd_.reset(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK));
+}
+
+GPIOCdev::~GPIOCdev()
+{
+    stopEventThread();
+
+    std::lock_guard<std::mutex> lock(lineMutex_);
+    for (const auto& [pin, line] : lines_)
+    {
+        if (line->callbackId != 0)
+        {
+            CallbackManager::getInstance().unregisterGPIOCallback(line->callbackId);
+        }
+        if (line->resourceId != 0)
+        {
+            ResourceManager::getInstance().setInUse(line->resourceId, false);
+            ResourceManager::getInstance().unregisterResource(line->resourceId);
+        }
+    }
+
+    requestFd_.close();
+    chipFd_.close();
+}
+
+bool GPIOCdev::buildConfig(gpio_v2_line_config& config) const
+{
+    std::memset(&config, 0, sizeof(config));
+
+    std::vector<std::pair<uint64_t, uint64_t>> flagGroups;
+    std::vector<std::pair<uint32_t, uint64_t>> debounceGroups;
+    uint64_t outputMask = 0;
+    uint64_t outputBits = 0;
+
+    for (size_t index = 0; index < requestOffsets_.size(); ++index)
+    {
+        const LineInfo& line = *lines_.at(requestOffsets_[index]);
+        const uint64_t bit = 1ULL << index;
+
+        uint64_t flags;
+        if (line.direction == PinDirection::OUTPUT)
+        {
+            flags = GPIO_V2_LINE_FLAG_OUTPUT;
+            outputMask |= bit;
+            if (line.outputValue == PinValue::HIGH) outputBits |= bit;
+        }
+        else
+        {
+            flags = GPIO_V2_LINE_FLAG_INPUT;
+            if (line.edgeRising && !line.stormDisabled) flags |= GPIO_V2_LINE_FLAG_EDGE_RISING;
+            if (line.edgeFalling && !line.stormDisabled) flags |= GPIO_V2_LINE_FLAG_EDGE_FALLING;
+
+            if (line.debounceUs != 0)
+            {
+                auto it = std::find_if(debounceGroups.begin(), debounceGroups.end(),
+                    [&line](const auto& group) { return group.first == line.debounceUs; });
+                if (it == debounceGroups.end()) debounceGroups.emplace_back(line.debounceUs, bit);
+                else it->second |= bit;
+            }
+        }
+
+        auto it = std::find_if(flagGroups.begin(), flagGroups.end(),
+            [flags](const auto& group) { return group.first == flags; });
+        if (it == flagGroups.end()) flagGroups.emplace_back(flags, bit);
+        else it->second |= bit;
+    }
+
+    // The largest group becomes the default flags, every other group costs one attribute
+    const auto base = std::max_element(flagGroups.begin(), flagGroups.end(),
+        [](const auto& a, const auto& b) { return __builtin_popcountll(a.second) < __builtin_popcountll(b.second); });
+    if (base != flagGroups.end())
+    {
+        config.flags = base->first;
+    }
+
+    uint32_t attrCount = 0;
+    const auto addAttr = [&config, &attrCount](const uint32_t id, const uint64_t value, const uint64_t mask)
+    {
+        if (attrCount >= GPIO_V2_LINE_NUM_ATTRS_MAX) return false;
+
+        gpio_v2_line_config_attribute& attr = config.attrs[attrCount++];
+        attr.attr.id = id;
+        switch (id)
+        {
+            case GPIO_V2_LINE_ATTR_ID_FLAGS:
+                attr.attr.flags = value;
+                break;
+            case GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES:
+                attr.attr.values = value;
+                break;
+            default:
+                attr.attr.debounce_period_us = static_cast<uint32_t>(value);
+                break;
+        }
+        attr.mask = mask;
+        return true;
+    };
+
+    for (auto it = flagGroups.begin(); it != flagGroups.end(); ++it)
+    {
+        if (it != base && !addAttr(GPIO_V2_LINE_ATTR_ID_FLAGS, it->first, it->second)) return false;
+    }
+    if (outputMask != 0 && !addAttr(GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES, outputBits, outputMask)) return false;
+    for (const auto& [periodUs, mask] : debounceGroups)
+    {
+        if (!addAttr(GPIO_V2_LINE_ATTR_ID_DEBOUNCE, periodUs, mask)) return false;
+    }
+
+    config.num_attrs = attrCount;
+    return true;
+}
+
+bool GPIOCdev::applyConfig(std::unique_lock<std::mutex>& lock, const bool linesChanged)
+{
+    if (!chipFd_.isValid()) return false;
+
+    gpio_v2_line_config config{};
+    if (!buildConfig(config)) return false;
+
+    if (!linesChanged && requestFd_.isValid())
+    {
+        return io_->ioctl(requestFd_.get(), GPIO_V2_LINE_SET_CONFIG_IOCTL, &config) >= 0;
+    }
+
+    // Recreating the request closes the descriptor the event thread polls, so park it first
+    const bool park = eventThread_.joinable() && eventThread_.get_id() != std::this_thread::get_id();
+    if (park)
+    {
+        reconfigCv_.wait(lock, [this] { return !reconfigRequested_; });
+        reconfigRequested_ = true;
+        const uint64_t one = 1;
+        ::write(wakeFd_.get(), &one, sizeof(one));
+        reconfigCv_.wait(lock, [this] { return eventThreadParked_; });
+    }
+
+    requestFd_.close();
+
+    bool result = true;
+    if (!requestOffsets_.empty())
+    {
+        gpio_v2_line_request request{};
+        std::copy(requestOffsets_.begin(), requestOffsets_.end(), request.offsets);
+        std::strncpy(request.consumer, "mex-hal", sizeof(request.consumer) - 1);
+        request.config = config;
+        request.num_lines = static_cast<uint32_t>(requestOffsets_.size());
+
+        result = io_->ioctl(chipFd_.get(), GPIO_V2_GET_LINE_IOCTL, &request) >= 0 && request.fd >= 0;
+        if (result)
+        {
+            requestFd_.reset(request.fd);
+        }
+    }
+
+    if (park)
+    {
+        reconfigRequested_ = false;
+        reconfigCv_.notify_all();
+    }
+
+    return result;
+}
+
+GPIOCdev::LineInfo* GPIOCdev::findOrAddLine(const uint8_t pin, bool& added)
+{
+    added = false;
+
+    const auto it = lines_.find(pin);
+    if (it != lines_.end())
+    {
+        return it->second.get();
+    }
+
+    if (requestOffsets_.size() >= GPIO_V2_LINES_MAX)
+    {
+        return nullptr;
+    }
+
+    auto line = std::make_unique<LineInfo>();
+    line->requestIndex = static_cast<uint32_t>(requestOffsets_.size());
+    requestOffsets_.push_back(pin);
+
+    added = true;
+    return (lines_[pin] = std::move(line)).get();
+}
+
+void GPIOCdev::dropLine(const uint8_t pin)
+{
+    lines_.erase(pin);
+    requestOffsets_.erase(std::remove(requestOffsets_.begin(), requestOffsets_.end(), pin), requestOffsets_.end());
+
+    for (uint32_t index = 0; index < requestOffsets_.size(); ++index)
+    {
+        lines_[requestOffsets_[index]]->requestIndex = index;
+    }
+}
+
+bool GPIOCdev::setValues(const uint64_t bits, const uint64_t mask) const
+{
+    if (!requestFd_.isValid()) return false;
+
+    gpio_v2_line_values values{};
+    values.bits = bits;
+    values.mask = mask;
+    return io_->ioctl(requestFd_.get(), GPIO_V2_LINE_SET_VALUES_IOCTL, &values) >= 0;
+}
+
+bool GPIOCdev::getValues(const uint64_t mask, uint64_t& bits) const
+{
+    if (!requestFd_.isValid()) return false;
+
+    gpio_v2_line_values values{};
+    values.mask = mask;
+    if (io_->ioctl(requestFd_.get(), GPIO_V2_LINE_GET_VALUES_IOCTL, &values) < 0) return false;
+
+    bits = values.bits;
+    return true;
+}
+
+void GPIOCdev::eventLoop()
+{
+    gpio_v2_line_event events[16];
+
+    while (!shutdownRequested_.load(std::memory_order_acquire))
+    {
+        int requestFd;
+        {
+            std::unique_lock<std::mutex> lock(lineMutex_);
+            if (reconfigRequested_)
+            {
+                eventThreadParked_ = true;
+                reconfigCv_.notify_all();
+                reconfigCv_.wait(lock, [this] { return !reconfigRequested_; });
+                eventThreadParked_ = false;
+            }
+            requestFd = requestFd_.get();
+        }
+
+        pollfd fds[3]{};
+        fds[0].fd = wakeFd_.get();
+        fds[0].events = POLLIN;
+        fds[1].fd = timerFd_.get();
+        fds[1].events = POLLIN;
+        fds[2].fd = requestFd;
+        fds[2].events = POLLIN;
+
+        if (poll(fds, requestFd >= 0 ? 3 : 2, -1) <= 0)
+        {
+            continue;
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            uint64_t counter;
+            ::read(wakeFd_.get(), &counter, sizeof(counter));
+            continue;
+        }
+
+        if (fds[1].revents & POLLIN)
+        {
+            uint64_t expirations;
+            ::read(timerFd_.get(), &expirations, sizeof(expirations));
+
+            std::unique_lock<std::mutex> lock(lineMutex_);
+            settleLimiter(lock, monotonicNs());
+        }
+
+        const ssize_t len = (fds[2].revents & POLLIN) ? ::read(requestFd, events, sizeof(events)) : 0;
+        const size_t count = len > 0 ? static_cast<size_t>(len) / sizeof(gpio_v2_line_event) : 0;
+        if (count != 0)
+        {
+            std::unique_lock<std::mutex> lock(lineMutex_);
+            bool disable = false;
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto pin = static_cast<uint8_t>(events[i].offset);
+                const auto it = lines_.find(pin);
+                if (it == lines_.end())
+                {
+                    continue;
+                }
+
+                LineInfo& line = *it->second;
+                line.lastEventTimestampNs.store(events[i].timestamp_ns, std::memory_order_release);
+
+                Delivery delivery;
+                delivery.event.pin = pin;
+                delivery.event.value = events[i].id == GPIO_V2_LINE_EVENT_RISING_EDGE ? PinValue::HIGH : PinValue::LOW;
+                delivery.event.timestampNs = events[i].timestamp_ns;
+                delivery.queued = line.queueEvents;
+
+                if (rateLimiter_.isEnabled(pin))
+                {
+                    uint64_t deadlineNs;
+                    const GPIORateLimiter::Verdict verdict =
+                        rateLimiter_.onEdge(pin, delivery.event.value, delivery.event.timestampNs, deadlineNs);
+                    armLimiterTimer(deadlineNs);
+
+                    if (verdict == GPIORateLimiter::Verdict::DISABLE)
+                    {
+                        line.stormDisabled = true;
+                        disable = true;
+                    }
+                    if (verdict != GPIORateLimiter::Verdict::DELIVER)
+                    {
+                        continue;
+                    }
+
+                    // Edges folded since the last delivery that never reached the subscriber
+                    delivery.event.coalesced = rateLimiter_.takeCoalesced(pin);
+                }
+
+                deliveries_.push_back(delivery);
+            }
+
+            // Stop the storm in the kernel, SET_CONFIG keeps the request so the thread does not park
+            if (disable)
+            {
+                applyConfig(lock, false);
+            }
+        }
+
+        // Dispatch without holding the lock, callbacks may call back into this object
+        for (const Delivery& delivery : deliveries_)
+        {
+            if (delivery.queued)
+            {
+                edgeEvents_.push(delivery.event.pin, delivery.event.value, delivery.event.timestampNs,
+                                 delivery.event.coalesced);
+            }
+            else
+            {
+                CallbackManager::getInstance().invokeGPIOCallback(delivery.event.pin, delivery.event.value,
+                                                                 delivery.event.timestampNs,
+                                                                 delivery.event.coalesced);
+            }
+        }
+        deliveries_.clear();
+    }
+}
+
+void GPIOCdev::armLimiterTimer(const uint64_t deadlineNs)
+{
+    if (deadlineNs >= armedDeadlineNs_)
+    {
+        return;
+    }
+
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(deadlineNs / 1000000000ULL);
+    spec.it_value.tv_nsec = static_cast<long>(deadlineNs % 1000000000ULL);
+
+    // A deadline of 0 would disarm the timer, kernel timestamps in the past expire immediately
+    if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+    {
+        spec.it_value.tv_nsec = 1;
+    }
+
+    if (timerfd_settime(timerFd_.get(), TFD_TIMER_ABSTIME, &spec, nullptr) == 0)
+    {
+        armedDeadlineNs_ = deadlineNs;
+    }
+}
+
+void GPIOCdev::queueLimited(const GPIOEdgeEvent& event)
+{
+    const auto it = lines_.find(event.pin);
+    if (it == lines_.end())
+    {
+        return;
+    }
+
+    // Coalesced and re-armed levels may go either way, keep the requested trigger
+    const LineInfo& line = *it->second;
+    if ((event.value == PinValue::HIGH && !line.edgeRising) || (event.value == PinValue::LOW && !line.edgeFalling))
+    {
+        return;
+    }
+
+    Delivery delivery;
+    delivery.event = event;
+    delivery.queued = line.queueEvents;
+    deliveries_.push_back(delivery);
+}
+
+void GPIOCdev::settleLimiter(std::unique_lock<std::mutex>& lock, const uint64_t nowNs)
+{
+    limited_.clear();
+    PinMask rearm;
+    armedDeadlineNs_ = GPIORateLimiter::NO_DEADLINE;
+    armLimiterTimer(rateLimiter_.settle(nowNs, limited_, rearm));
+
+    for (const GPIOEdgeEvent& event : limited_)
+    {
+        queueLimited(event);
+    }
+
+    if (rearm.none())
+    {
+        return;
+    }
+
+    // Give the edge flags back to the kernel in one SET_CONFIG, then sample the re-armed lines in one GET_VALUES
+    uint64_t requestMask = 0;
+    for (const auto& [pin, line] : lines_)
+    {
+        if (rearm.test(pin) && line->stormDisabled)
+        {
+            line->stormDisabled = false;
+            requestMask |= 1ULL << line->requestIndex;
+        }
+    }
+
+    uint64_t bits = 0;
+    if (requestMask == 0 || !applyConfig(lock, false) || !getValues(requestMask, bits))
+    {
+        return;
+    }
+
+    for (const auto& [pin, line] : lines_)
+    {
+        const uint64_t bit = 1ULL << line->requestIndex;
+        if (!(requestMask & bit)) continue;
+
+        GPIOEdgeEvent event;
+        event.pin = pin;
+        event.value = (bits & bit) ? PinValue::HIGH : PinValue::LOW;
+        event.timestampNs = nowNs;
+        if (rateLimiter_.onRearm(pin, event.value))
+        {
+            event.coalesced = rateLimiter_.takeCoalesced(pin);
+            queueLimited(event);
+        }
+    }
+}
+
+void GPIOCdev::stopEventThread()
+{
+    shutdownRequested_.store(true, std::memory_order_release);
+
+    if (eventThread_.joinable())
+    {
+        const uint64_t one = 1;
+        ::write(wakeFd_.get(), &one, sizeof(one));
+        eventThread_.join();
+    }
+}
+
+bool GPIOCdev::setDirection(const uint8_t pin, const PinDirection direction)
+{
+    std::unique_lock<std::mutex> lock(lineMutex_);
+
+    bool added;
+    LineInfo* line = findOrAddLine(pin, added);
+    if (line == nullptr) return false;
+
+    line->direction = direction;
+    if (direction == PinDirection::OUTPUT)
+    {
+        line->edgeRising = false;
+        line->edgeFalling = false;
+    }
+
+    if (!applyConfig(lock, added))
+    {
+        if (added)
+        {
+            dropLine(pin);
+            applyConfig(lock, true);
+        }
+        return false;
+    }
+
+    if (added)
+    {
+        line->resourceId = ResourceManager::getInstance().registerResource(
+            ResourceType::GPIO_PIN,
+            chipPath_ + ":" + std::to_string(pin),
+            reinterpret_cast<void*>(static_cast<uintptr_t>(pin))
+        );
+    }
+
+    ResourceManager::getInstance().setInUse(line->resourceId, true);
+    return true;
+}
+
+bool GPIOCdev::setDirectionMask(const PinMask& mask, const PinDirection direction)
+{
+    std::unique_lock<std::mutex> lock(lineMutex_);
+
+    // Collect every line first so the request is recreated at most once
+    std::vector<uint8_t> addedPins;
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (!mask.test(pin)) continue;
+
+        bool added;
+        LineInfo* line = findOrAddLine(static_cast<uint8_t>(pin), added);
+        if (line == nullptr)
+        {
+            for (const uint8_t addedPin : addedPins) dropLine(addedPin);
+            if (!addedPins.empty()) applyConfig(lock, true);
+            return false;
+        }
+        if (added) addedPins.push_back(static_cast<uint8_t>(pin));
+
+        line->direction = direction;
+        if (direction == PinDirection::OUTPUT)
+        {
+            line->edgeRising = false;
+            line->edgeFalling = false;
+        }
+    }
+
+    if (!applyConfig(lock, !addedPins.empty()))
+    {
+        for (const uint8_t addedPin : addedPins) dropLine(addedPin);
+        if (!addedPins.empty()) applyConfig(lock, true);
+        return false;
+    }
+
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (!mask.test(pin)) continue;
+
+        LineInfo& line = *lines_.at(static_cast<uint8_t>(pin));
+        if (line.resourceId == 0)
+        {
+            line.resourceId = ResourceManager::getInstance().registerResource(
+                ResourceType::GPIO_PIN,
+                chipPath_ + ":" + std::to_string(pin),
+                reinterpret_cast<void*>(static_cast<uintptr_t>(pin))
+            );
+        }
+        ResourceManager::getInstance().setInUse(line.resourceId, true);
+    }
+
+    return true;
+}
+
+bool GPIOCdev::write(const uint8_t pin, const PinValue value)
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    const auto it = lines_.find(pin);
+    if (it == lines_.end())
+    {
+        return false;
+    }
+
+    const uint64_t bit = 1ULL << it->second->requestIndex;
+    if (!setValues(value == PinValue::HIGH ? bit : 0, bit))
+    {
+        return false;
+    }
+
+    it->second->outputValue = value;
+    return true;
+}
+
+PinValue GPIOCdev::read(const uint8_t pin)
+{
+    {
+        std::lock_guard<std::mutex> lock(lineMutex_);
+
+        const auto it = lines_.find(pin);
+        if (it == lines_.end())
+        {
+            return PinValue::LOW;
+        }
+
+        // Outputs read back what was last written without an ioctl
+        if (it->second->direction == PinDirection::OUTPUT)
+        {
+            return it->second->outputValue;
+        }
+    }
+
+    return readback(pin);
+}
+
+PinValue GPIOCdev::readback(const uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    const auto it = lines_.find(pin);
+    if (it == lines_.end())
+    {
+        return PinValue::LOW;
+    }
+
+    const uint64_t bit = 1ULL << it->second->requestIndex;
+    uint64_t bits = 0;
+    if (!getValues(bit, bits))
+    {
+        return PinValue::LOW;
+    }
+
+    return (bits & bit) ? PinValue::HIGH : PinValue::LOW;
+}
+
+bool GPIOCdev::toggle(const uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    const auto it = lines_.find(pin);
+    if (it == lines_.end() || it->second->direction != PinDirection::OUTPUT)
+    {
+        return false;
+    }
+
+    const PinValue next = it->second->outputValue == PinValue::HIGH ? PinValue::LOW : PinValue::HIGH;
+    const uint64_t bit = 1ULL << it->second->requestIndex;
+    if (!setValues(next == PinValue::HIGH ? bit : 0, bit))
+    {
+        return false;
+    }
+
+    it->second->outputValue = next;
+    return true;
+}
+
+bool GPIOCdev::writeMask(const PinMask& mask, const PinMask& values)
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    uint64_t bits = 0;
+    uint64_t requestMask = 0;
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (!mask.test(pin)) continue;
+
+        const auto it = lines_.find(static_cast<uint8_t>(pin));
+        if (it == lines_.end())
+        {
+            return false;
+        }
+
+        const uint64_t bit = 1ULL << it->second->requestIndex;
+        requestMask |= bit;
+        if (values.test(pin)) bits |= bit;
+    }
+
+    if (requestMask == 0)
+    {
+        return true;
+    }
+
+    // All selected lines change with a single SET_VALUES call
+    if (!setValues(bits, requestMask))
+    {
+        return false;
+    }
+
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (mask.test(pin))
+        {
+            lines_[static_cast<uint8_t>(pin)]->outputValue = values.test(pin) ? PinValue::HIGH : PinValue::LOW;
+        }
+    }
+
+    return true;
+}
+
+PinMask GPIOCdev::readMask(const PinMask& mask)
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    // Outputs come from their shadow, only inputs are sampled
+    PinMask result;
+    uint64_t requestMask = 0;
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (!mask.test(pin)) continue;
+
+        const auto it = lines_.find(static_cast<uint8_t>(pin));
+        if (it == lines_.end()) continue;
+
+        if (it->second->direction == PinDirection::OUTPUT)
+        {
+            if (it->second->outputValue == PinValue::HIGH) result.set(pin);
+        }
+        else
+        {
+            requestMask |= 1ULL << it->second->requestIndex;
+        }
+    }
+
+    uint64_t bits = 0;
+    if (requestMask == 0 || !getValues(requestMask, bits))
+    {
+        return result;
+    }
+
+    for (uint32_t index = 0; index < requestOffsets_.size(); ++index)
+    {
+        if ((requestMask & bits) & (1ULL << index))
+        {
+            result.set(requestOffsets_[index]);
+        }
+    }
+
+    return result;
+}
+
+GPIOCdev::LineInfo* GPIOCdev::armInterrupt(std::unique_lock<std::mutex>& lock, const uint8_t pin, const EdgeTrigger edge)
+{
+    bool added;
+    LineInfo* line = findOrAddLine(pin, added);
+    if (line == nullptr) return nullptr;
+
+    line->direction = PinDirection::INPUT;
+    line->stormDisabled = false;
+    line->edgeRising = edge == EdgeTrigger::RISING || edge == EdgeTrigger::BOTH;
+    line->edgeFalling = edge == EdgeTrigger::FALLING || edge == EdgeTrigger::BOTH;
+
+    if (!applyConfig(lock, added))
+    {
+        if (added)
+        {
+            dropLine(pin);
+            applyConfig(lock, true);
+        }
+        return nullptr;
+    }
+
+    if (added)
+    {
+        line->resourceId = ResourceManager::getInstance().registerResource(
+            ResourceType::GPIO_PIN,
+            chipPath_ + ":" + std::to_string(pin),
+            reinterpret_cast<void*>(static_cast<uintptr_t>(pin))
+        );
+        ResourceManager::getInstance().setInUse(line->resourceId, true);
+    }
+
+    // One thread serves every line of the request
+    if (!eventThread_.joinable())
+    {
+        shutdownRequested_.store(false, std::memory_order_release);
+        eventThread_ = std::thread(&GPIOCdev::eventLoop, this);
+        ThreadConfig::apply(eventThread_.native_handle(), eventThreadSchedule_);
+    }
+
+    return line;
+}
+
+bool GPIOCdev::setInterrupt(const uint8_t pin, const EdgeTrigger edge, InterruptCallback callback)
+{
+    return setInterrupt(pin, edge, std::move(callback), EdgeRateLimit{});
+}
+
+bool GPIOCdev::setInterrupt(const uint8_t pin, const EdgeTrigger edge, InterruptCallback callback,
+                            const EdgeRateLimit& limit)
+{
+    std::unique_lock<std::mutex> lock(lineMutex_);
+
+    rateLimiter_.configure(pin, limit);
+    LineInfo* line = armInterrupt(lock, pin, edge);
+    if (line == nullptr) return false;
+
+    // Replace any previous callback for this line
+    if (line->callbackId != 0)
+    {
+        CallbackManager::getInstance().unregisterGPIOCallback(line->callbackId);
+    }
+    line->callbackId = CallbackManager::getInstance().registerGPIOCallback(pin, std::move(callback));
+    line->queueEvents = false;
+
+    return true;
+}
+
+bool GPIOCdev::enableEdgeEvents(const uint8_t pin, const EdgeTrigger edge)
+{
+    std::unique_lock<std::mutex> lock(lineMutex_);
+
+    rateLimiter_.configure(pin, EdgeRateLimit{});
+    LineInfo* line = armInterrupt(lock, pin, edge);
+    if (line == nullptr) return false;
+
+    // Edges go to the queue, drop any callback from a previous setInterrupt
+    if (line->callbackId != 0)
+    {
+        CallbackManager::getInstance().unregisterGPIOCallback(line->callbackId);
+        line->callbackId = 0;
+    }
+    line->queueEvents = true;
+
+    return true;
+}
+
+EdgeRateStats GPIOCdev::getEdgeRateStats(const uint8_t pin) const
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+    return rateLimiter_.getStats(pin);
+}
+
+uint64_t GPIOCdev::getResourceId(const uint8_t pin) const
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+    const auto it = lines_.find(pin);
+    return it != lines_.end() ? it->second->resourceId : 0;
+}
+
+GPIOEventQueue& GPIOCdev::getEdgeEventQueue()
+{
+    return edgeEvents_;
+}
+
+bool GPIOCdev::removeInterrupt(const uint8_t pin)
+{
+    std::unique_lock<std::mutex> lock(lineMutex_);
+
+    const auto it = lines_.find(pin);
+    if (it == lines_.end() || (!it->second->edgeRising && !it->second->edgeFalling))
+    {
+        return false;
+    }
+
+    LineInfo& line = *it->second;
+    line.edgeRising = false;
+    line.edgeFalling = false;
+    line.queueEvents = false;
+
+    if (!applyConfig(lock, false))
+    {
+        return false;
+    }
+
+    if (line.callbackId != 0)
+    {
+        CallbackManager::getInstance().unregisterGPIOCallback(line.callbackId);
+        line.callbackId = 0;
+    }
+
+    return true;
+}
+
+bool GPIOCdev::setDebounce(const uint8_t pin, const uint32_t debounceTimeMs)
+{
+    std::unique_lock<std::mutex> lock(lineMutex_);
+
+    const auto it = lines_.find(pin);
+    if (it == lines_.end())
+    {
+        return false;
+    }
+
+    const uint32_t previous = it->second->debounceUs;
+    it->second->debounceUs = debounceTimeMs * 1000;
+
+    if (!applyConfig(lock, false))
+    {
+        it->second->debounceUs = previous;
+        return false;
+    }
+
+    return true;
+}
+
+bool GPIOCdev::setInterruptThreadPriority(const int32_t priority)
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    ThreadSchedule schedule = eventThreadSchedule_;
+    schedule.priority = priority;
+    if (!ThreadConfig::isValid(schedule)) return false;
+
+    eventThreadSchedule_ = schedule;
+    if (!eventThread_.joinable()) return true;
+
+    return ThreadConfig::applyPriority(eventThread_.native_handle(), priority);
+}
+
+bool GPIOCdev::setInterruptThreadAffinity(const int32_t cpu)
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    ThreadSchedule schedule = eventThreadSchedule_;
+    schedule.cpu = cpu;
+    if (!ThreadConfig::isValid(schedule)) return false;
+
+    eventThreadSchedule_ = schedule;
+    if (!eventThread_.joinable()) return true;
+
+    return ThreadConfig::applyAffinity(eventThread_.native_handle(), cpu);
+}
+
+uint64_t GPIOCdev::getLastEventTimestampNs(const uint8_t pin) const
+{
+    std::lock_guard<std::mutex> lock(lineMutex_);
+
+    const auto it = lines_.find(pin);
+    if (it == lines_.end())
+    {
+        return 0;
+    }
+
+    return it->second->lastEventTimestampNs.load(std::memory_order_acquire);
+}
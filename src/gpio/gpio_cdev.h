@@ -0,0 +1,350 @@
+#ifndef MEX_HAL_GPIO_CDEV_H
+#define MEX_HAL_GPIO_CDEV_H
+
+#include "../../include/hal/gpio.h"
+#include "../../include/hal/resource_manager.h"
+#include "../../include/hal/file_descriptor.h"
+#include "../thread_config/thread_config.h"
+#include "gpio_rate_limiter.h"
+#include <linux/gpio.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief Syscall layer used by GPIOCdev
+     *
+     * The default implementation forwards to open(2) and ioctl(2). Tests replace it
+     * with an in-memory chip so the backend can be exercised without hardware.
+     * Returned descriptors must be real, pollable file descriptors.
+     */
+    class GPIOCdevIo
+    {
+    public:
+        /**
+         * @brief Virtual destructor
+         */
+        virtual ~GPIOCdevIo() = default;
+
+        /**
+         * @brief Open a GPIO character device
+         * @param path The chip device path (e.g. /dev/gpiochip0)
+         * @return A file descriptor, negative on failure
+         */
+        virtual int openChip(const std::string& path);
+
+        /**
+         * @brief Issue an ioctl on a chip or line request descriptor
+         * @param fd The file descriptor
+         * @param request The ioctl request code
+         * @param arg The ioctl argument
+         * @return The ioctl result, negative on failure
+         */
+        virtual int ioctl(int fd, unsigned long request, void* arg);
+    };
+
+    /// @brief GPIO character device (uAPI v2) implementation class \class GPIOCdev
+    class GPIOCdev final : public GPIOInterface
+    {
+    private:
+        /// @brief Line information structure, tracks state of each requested line \struct LineInfo
+        struct LineInfo
+        {
+            uint64_t resourceId = 0;
+            PinDirection direction = PinDirection::INPUT;
+            // Shadow of an output line, applied on every reconfiguration and served by read()
+            PinValue outputValue = PinValue::LOW;
+            bool edgeRising = false;
+            bool edgeFalling = false;
+            uint32_t debounceUs = 0;
+            uint32_t requestIndex = 0;
+            uint64_t callbackId = 0;
+            bool queueEvents = false;
+            // Edge flags are withheld from the kernel until the rate limiter re-arms the line
+            bool stormDisabled = false;
+            std::atomic<uint64_t> lastEventTimestampNs{0};
+        };
+
+        /// @brief Edge ready for delivery outside lineMutex_ \struct Delivery
+        struct Delivery
+        {
+            GPIOEdgeEvent event;
+            bool queued = false;
+        };
+
+        std::string chipPath_;
+        std::shared_ptr<GPIOCdevIo> io_;
+        FileDescriptor chipFd_;
+        FileDescriptor requestFd_;
+        FileDescriptor wakeFd_;
+
+        mutable std::mutex lineMutex_;
+        std::condition_variable reconfigCv_;
+        std::unordered_map<uint8_t, std::unique_ptr<LineInfo>> lines_;
+        std::vector<uint8_t> requestOffsets_;
+
+        // Edge event thread
+        std::thread eventThread_;
+        ThreadSchedule eventThreadSchedule_;
+        std::atomic<bool> shutdownRequested_{false};
+        bool reconfigRequested_ = false;
+        bool eventThreadParked_ = false;
+        GPIOEventQueue edgeEvents_;
+        std::vector<Delivery> deliveries_;
+
+        // Rate limiting, one timerfd on the event thread's poll set flushes and re-arms lines
+        FileDescriptor timerFd_;
+        GPIORateLimiter rateLimiter_;
+        uint64_t armedDeadlineNs_ = GPIORateLimiter::NO_DEADLINE;
+        std::vector<GPIOEdgeEvent> limited_;
+
+        /**
+         * @brief Build the v2 line configuration for all requested lines
+         * @param config The configuration to populate
+         * @return A true if the configuration fits into the attribute table, false otherwise
+         */
+        bool buildConfig(gpio_v2_line_config& config) const;
+
+        /**
+         * @brief Push the current line configuration to the kernel, caller must hold lineMutex_
+         * @param lock The held lineMutex_ lock, released while the event thread parks
+         * @param linesChanged True if lines were added and the request must be recreated
+         * @return A true if the configuration was applied, false otherwise
+         */
+        bool applyConfig(std::unique_lock<std::mutex>& lock, bool linesChanged);
+
+        /**
+         * @brief Find a line or append it to the request set, caller must hold lineMutex_
+         * @param pin The line offset on the chip
+         * @param added Set to true if the line was appended
+         * @return A pointer to the LineInfo, nullptr if the request is full
+         */
+        LineInfo* findOrAddLine(uint8_t pin, bool& added);
+
+        /**
+         * @brief Remove a line from the request set, caller must hold lineMutex_
+         * @param pin The line offset on the chip
+         */
+        void dropLine(uint8_t pin);
+
+        /**
+         * @brief Set line values in request index space with one ioctl
+         * @param bits The values bitmap
+         * @param mask The lines to update
+         * @return A true if the ioctl succeeded, false otherwise
+         */
+        bool setValues(uint64_t bits, uint64_t mask) const;
+
+        /**
+         * @brief Get line values in request index space with one ioctl
+         * @param mask The lines to sample
+         * @param bits The sampled values bitmap
+         * @return A true if the ioctl succeeded, false otherwise
+         */
+        bool getValues(uint64_t mask, uint64_t& bits) const;
+
+        /**
+         * @brief Move the rate limit timer to an earlier deadline, caller must hold lineMutex_
+         * @param deadlineNs The CLOCK_MONOTONIC deadline in nanoseconds
+         */
+        void armLimiterTimer(uint64_t deadlineNs);
+
+        /**
+         * @brief Queue a rate limited edge for delivery if the line watches its direction, caller must hold lineMutex_
+         * @param event The edge
+         */
+        void queueLimited(const GPIOEdgeEvent& event);
+
+        /**
+         * @brief Flush coalesced edges and re-arm storming lines whose pause elapsed, caller must hold lineMutex_
+         * @param lock The held lineMutex_ lock
+         * @param nowNs The current CLOCK_MONOTONIC time in nanoseconds
+         */
+        void settleLimiter(std::unique_lock<std::mutex>& lock, uint64_t nowNs);
+
+        /**
+         * @brief Enable edge detection on a line and start the event thread, caller must hold lineMutex_
+         * @param lock The held lineMutex_ lock
+         * @param pin The line offset on the chip
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @return A pointer to the armed LineInfo, nullptr on failure
+         */
+        LineInfo* armInterrupt(std::unique_lock<std::mutex>& lock, uint8_t pin, EdgeTrigger edge);
+
+        /**
+         * @brief Edge event loop, reads gpio_v2_line_event records from the request
+         */
+        void eventLoop();
+
+        /**
+         * @brief Stop and join the edge event thread
+         */
+        void stopEventThread();
+
+    public:
+        /**
+         * @brief Constructor
+         * @param chipPath The GPIO character device path
+         * @param io The syscall layer, nullptr for the kernel
+         */
+        explicit GPIOCdev(std::string chipPath = DEV_GPIOCHIP + "0", std::shared_ptr<GPIOCdevIo> io = nullptr);
+
+        /**
+         * @brief Destructor
+         */
+        ~GPIOCdev() override;
+
+        /**
+         * @brief Set the direction of a GPIO line
+         * @param pin The line offset on the chip
+         * @param direction The direction to set (INPUT or OUTPUT)
+         * @return A true if the direction was successfully set, false otherwise
+         */
+        bool setDirection(uint8_t pin, PinDirection direction) override;
+
+        /**
+         * @brief Write a value to a GPIO line
+         * @param pin The line offset on the chip
+         * @param value The value to write (HIGH or LOW)
+         * @return A true if the value was successfully written, false otherwise
+         */
+        bool write(uint8_t pin, PinValue value) override;
+
+        /**
+         * @brief Read the value of a line, outputs are served from the last written value
+         * @param pin The line offset on the chip
+         * @return A PinValue representing the current value of the line (HIGH or LOW)
+         */
+        PinValue read(uint8_t pin) override;
+
+        /**
+         * @brief Read the level of a line from hardware, bypassing the output shadow
+         * @param pin The line offset on the chip
+         * @return A PinValue representing the current value of the line (HIGH or LOW)
+         */
+        PinValue readback(uint8_t pin) override;
+
+        /**
+         * @brief Invert an output line from its shadow value with a single write
+         * @param pin The line offset on the chip
+         * @return A true if the line was toggled, false if it is not a configured output
+         */
+        bool toggle(uint8_t pin) override;
+
+        /**
+         * @brief Set the direction of several GPIO lines with a single line request update
+         * @param mask The lines to configure
+         * @param direction The direction to set (INPUT or OUTPUT)
+         * @return A true if every selected line was configured, false otherwise
+         */
+        bool setDirectionMask(const PinMask& mask, PinDirection direction) override;
+
+        /**
+         * @brief Write several GPIO lines as one batch
+         * @param mask The lines to update
+         * @param values The values for the selected lines (set bit = HIGH)
+         * @return A true if all selected lines were written, false otherwise
+         */
+        bool writeMask(const PinMask& mask, const PinMask& values) override;
+
+        /**
+         * @brief Read several GPIO lines as one batch
+         * @param mask The lines to sample
+         * @return The sampled values, bits outside mask are cleared (set bit = HIGH)
+         */
+        PinMask readMask(const PinMask& mask) override;
+
+        /**
+         * @brief Set up an interrupt on a GPIO line
+         * @param pin The line offset on the chip
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @param callback The callback function to invoke on interrupt
+         * @return A true if the interrupt was successfully set, false otherwise
+         */
+        bool setInterrupt(uint8_t pin, EdgeTrigger edge, InterruptCallback callback) override;
+
+        /**
+         * @brief Set up a rate limited interrupt on a GPIO line, excess edges never reach the CallbackManager
+         * @param pin The line offset on the chip
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @param callback The callback function to invoke on interrupt
+         * @param limit The maximum edge rate and the handling of excess edges
+         * @return A true if the interrupt was successfully set, false otherwise
+         */
+        bool setInterrupt(uint8_t pin, EdgeTrigger edge, InterruptCallback callback, const EdgeRateLimit& limit) override;
+
+        /**
+         * @brief Get the rate limit counters of a GPIO line
+         * @param pin The line offset on the chip
+         * @return The counters since the interrupt was last set
+         */
+        [[nodiscard]] EdgeRateStats getEdgeRateStats(uint8_t pin) const override;
+
+        /**
+         * @brief Get the ResourceManager ID of a GPIO line
+         * @param pin The line offset on the chip
+         * @return The resource ID, 0 if the line is not requested
+         */
+        [[nodiscard]] uint64_t getResourceId(uint8_t pin) const override;
+
+        /**
+         * @brief Remove an interrupt from a GPIO line
+         * @param pin The line offset on the chip
+         * @return A true if the interrupt was successfully removed, false otherwise
+         */
+        bool removeInterrupt(uint8_t pin) override;
+
+        /**
+         * @brief Set up edge detection on a GPIO pin that feeds the edge event queue instead of a callback
+         * @param pin The GPIO pin number
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @return A true if edge events were enabled, false otherwise
+         */
+        bool enableEdgeEvents(uint8_t pin, EdgeTrigger edge) override;
+
+        /**
+         * @brief Get the timestamped edge event queue of this controller
+         * @return The queue, may be drained from any number of threads
+         */
+        GPIOEventQueue& getEdgeEventQueue() override;
+
+        /**
+         * @brief Set the kernel debounce period of a GPIO line
+         * @param pin The line offset on the chip
+         * @param debounceTimeMs The debounce time in milliseconds
+         * @return A true if the debounce time was successfully set, false otherwise
+         */
+        bool setDebounce(uint8_t pin, uint32_t debounceTimeMs) override;
+
+        /**
+         * @brief Set the scheduling priority of the edge event thread
+         * @param priority 0 for SCHED_OTHER, otherwise the SCHED_FIFO priority
+         * @return A true if the priority is valid and was applied, false otherwise
+         */
+        bool setInterruptThreadPriority(int32_t priority) override;
+
+        /**
+         * @brief Pin the edge event thread to a CPU
+         * @param cpu The CPU index, -1 to allow all CPUs
+         * @return A true if the affinity is valid and was applied, false otherwise
+         */
+        bool setInterruptThreadAffinity(int32_t cpu) override;
+
+        /**
+         * @brief Get the kernel timestamp of the last edge event seen on a line
+         * @param pin The line offset on the chip
+         * @return The CLOCK_MONOTONIC timestamp in nanoseconds, 0 if none
+         */
+        [[nodiscard]] uint64_t getLastEventTimestampNs(uint8_t pin) const;
+    };
+}
+
+#endif //MEX_HAL_GPIO_CDEV_H
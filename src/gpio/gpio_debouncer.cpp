@@ -0,0 +1,84 @@
+#include "gpio_debouncer.h"
+#include <algorithm>
+
+using namespace mex_hal;
+
+void GPIODebouncer::configure(const uint8_t pin, const uint64_t stableTimeNs, const PinValue level)
+{
+    PinState& state = states_[pin];
+    state.stableTimeNs = stableTimeNs;
+    state.settledValue = level;
+    state.pending = false;
+    pendingPins_.reset(pin);
+}
+
+bool GPIODebouncer::isEnabled(const uint8_t pin) const
+{
+    return states_[pin].stableTimeNs != 0;
+}
+
+void GPIODebouncer::cancel(const uint8_t pin)
+{
+    states_[pin].pending = false;
+    pendingPins_.reset(pin);
+}
+
+uint64_t GPIODebouncer::onEdge(const uint8_t pin, const PinValue value, const uint64_t timestampNs)
+{
+    PinState& state = states_[pin];
+
+    // A newer edge inside the window means the previous one was a bounce
+    if (state.pending)
+    {
+        ++state.suppressed;
+    }
+
+    state.pending = true;
+    state.pendingValue = value;
+    state.lastEdgeNs = timestampNs;
+    state.deadlineNs = timestampNs + state.stableTimeNs;
+    pendingPins_.set(pin);
+
+    return state.deadlineNs;
+}
+
+uint64_t GPIODebouncer::settle(const uint64_t nowNs, std::vector<GPIOEdgeEvent>& settled)
+{
+    uint64_t nextDeadline = NO_DEADLINE;
+
+    for (size_t pin = 0; pin < states_.size(); ++pin)
+    {
+        if (!pendingPins_.test(pin)) continue;
+
+        PinState& state = states_[pin];
+        if (state.deadlineNs > nowNs)
+        {
+            nextDeadline = std::min(nextDeadline, state.deadlineNs);
+            continue;
+        }
+
+        state.pending = false;
+        pendingPins_.reset(pin);
+
+        // A glitch that returned to the settled level is a bounce as well
+        if (state.pendingValue == state.settledValue)
+        {
+            ++state.suppressed;
+            continue;
+        }
+
+        state.settledValue = state.pendingValue;
+        GPIOEdgeEvent event;
+        event.pin = static_cast<uint8_t>(pin);
+        event.value = state.settledValue;
+        event.timestampNs = state.lastEdgeNs;
+        settled.push_back(event);
+    }
+
+    return nextDeadline;
+}
+
+uint64_t GPIODebouncer::getSuppressedCount(const uint8_t pin) const
+{
+    return states_[pin].suppressed;
+}
@@ -0,0 +1,91 @@
+#ifndef MEX_HAL_GPIO_DEBOUNCER_H
+#define MEX_HAL_GPIO_DEBOUNCER_H
+
+#include "../../include/hal/gpio_event_queue.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief Userspace debounce state machine for GPIO inputs
+     *
+     * Every raw edge restarts the stable window of its pin in O(1). A pin settles
+     * when no edge arrived for the stable time; the transition is reported once if
+     * the level differs from the last settled level. Edges that never settle are
+     * counted as suppressed bounces. The owner drives settle() from a single timer
+     * armed for the returned deadlines, so no thread is needed per pin.
+     * Not thread-safe, the owner serializes access.
+     */
+    class GPIODebouncer
+    {
+    public:
+        static constexpr uint64_t NO_DEADLINE = std::numeric_limits<uint64_t>::max();
+
+        /**
+         * @brief Enable debouncing on a pin, a stable time of 0 disables it
+         * @param pin The GPIO pin number
+         * @param stableTimeNs The time the level must be stable in nanoseconds
+         * @param level The current settled level of the pin
+         */
+        void configure(uint8_t pin, uint64_t stableTimeNs, PinValue level);
+
+        /**
+         * @brief Check whether a pin is debounced
+         * @param pin The GPIO pin number
+         * @return A true if edges of the pin go through the state machine, false otherwise
+         */
+        [[nodiscard]] bool isEnabled(uint8_t pin) const;
+
+        /**
+         * @brief Drop a pending transition, e.g. when the interrupt is removed
+         * @param pin The GPIO pin number
+         */
+        void cancel(uint8_t pin);
+
+        /**
+         * @brief Record a raw edge of a debounced pin
+         * @param pin The GPIO pin number
+         * @param value The pin value after the edge
+         * @param timestampNs The CLOCK_MONOTONIC timestamp of the edge in nanoseconds
+         * @return The deadline at which the pin may settle
+         */
+        uint64_t onEdge(uint8_t pin, PinValue value, uint64_t timestampNs);
+
+        /**
+         * @brief Settle every pin whose stable time has elapsed
+         * @param nowNs The current CLOCK_MONOTONIC time in nanoseconds
+         * @param settled Receives one event per settled transition, timestamped with its last edge
+         * @return The earliest remaining deadline, NO_DEADLINE if nothing is pending
+         */
+        uint64_t settle(uint64_t nowNs, std::vector<GPIOEdgeEvent>& settled);
+
+        /**
+         * @brief Get the number of raw edges suppressed as bounces on a pin
+         * @param pin The GPIO pin number
+         * @return The suppressed edge count
+         */
+        [[nodiscard]] uint64_t getSuppressedCount(uint8_t pin) const;
+
+    private:
+        /// @brief Debounce state of one pin \struct PinState
+        struct PinState
+        {
+            uint64_t stableTimeNs = 0;
+            PinValue settledValue = PinValue::LOW;
+            PinValue pendingValue = PinValue::LOW;
+            bool pending = false;
+            uint64_t lastEdgeNs = 0;
+            uint64_t deadlineNs = 0;
+            uint64_t suppressed = 0;
+        };
+
+        std::array<PinState, 256> states_{};
+        PinMask pendingPins_;
+    };
+}
+
+#endif //MEX_HAL_GPIO_DEBOUNCER_H
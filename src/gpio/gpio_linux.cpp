@@ -1,31 +1,74 @@
 #include "gpio_linux.h"
 #include "../../include/hal/callback_manager.h"
-#include <poll.h>
+#include "../monotonic_clock/monotonic_clock.h"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <array>
 #include <cstring>
+#include <ctime>
 
 using namespace mex_hal;
 
-GPIOLinux::~GPIOLinux()
+namespace
 {
-    shutdownRequested_.store(true, std::memory_order_release);
+    // epoll tokens of the wakeup eventfd and edge filter timer, pin tokens are 0..255
+    constexpr uint64_t WAKE_TOKEN = ~0ULL;
+    constexpr uint64_t TIMER_TOKEN = ~0ULL - 1;
 
-    // Wait for all interrupt threads to finish
-    for (auto& [pin, thread] : interruptThreads_)
+    const char* edgeName(const EdgeTrigger edge)
     {
-        if (thread && thread->joinable())
+        switch (edge)
         {
-            thread->join();
+            case EdgeTrigger::RISING:
+                return "rising";
+            case EdgeTrigger::FALLING:
+                return "falling";
+            case EdgeTrigger::BOTH:
+                break;
         }
+        return "both";
+    }
+}
+
+GPIOLinux::GPIOLinux()
+    : sysfsRoot_(SYS_CLASS_GPIO_ROOT)
+{
+
+}
+
+GPIOLinux::GPIOLinux(std::string sysfsRoot)
+    : sysfsRoot_(std::move(sysfsRoot))
+{
+
+}
+
+GPIOLinux::~GPIOLinux()
+{
+    shutdownRequested_.store(true, std::memory_order_release);
+
+    // Wake the dispatcher immediately instead of waiting for a poll timeout
+    if (dispatcherThread_.joinable())
+    {
+        const uint64_t one = 1;
+        ::write(wakeFd_.get(), &one, sizeof(one));
+        dispatcherThread_.join();
     }
 
     // Cleanup all pins
-    std::lock_guard<std::mutex> lock(pinMutex_);
-    for (const auto& [pin, info] : pins_)
+    std::lock_guard<std::mutex> exportLock(exportMutex_);
+    for (size_t pin = 0; pin < pins_.size(); ++pin)
     {
-        if (info.exported)
-        {
-            unexportPin(pin);
-        }
+        PinInfo& info = pins_[pin];
+        if (!info.exported.load(std::memory_order_acquire)) continue;
+
+        std::lock_guard<std::mutex> lock(info.mutex);
+        info.valueFd.close();
+        info.directionFd.close();
+        info.edgeFd.close();
+        info.irqFd.close();
+
+        unexportPin(static_cast<uint8_t>(pin));
         if (info.resourceId != 0)
         {
             ResourceManager::getInstance().unregisterResource(info.resourceId);
@@ -37,237 +80,762 @@ GPIOLinux::~GPIOLinux()
     }
 }
 
-int GPIOLinux::exportPin(const uint8_t pin)
+std::string GPIOLinux::getPinPath(const uint8_t pin) const
+{
+    return sysfsRoot_ + "/gpio" + std::to_string(pin);
+}
+
+int GPIOLinux::exportPin(const uint8_t pin) const
 {
-    std::ofstream exportFile(SYS_CLASS_GPIO_EXPORT);
+    std::ofstream exportFile(sysfsRoot_ + "/export");
     if (!exportFile.is_open()) return -1;
     exportFile << static_cast<int>(pin);
     exportFile.close();
-    
-    // Give kernel time to create the GPIO files
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
+
     return 0;
 }
 
-int GPIOLinux::unexportPin(const uint8_t pin)
+int GPIOLinux::unexportPin(const uint8_t pin) const
 {
-    std::ofstream unexportFile(SYS_CLASS_GPIO_UNEXPORT);
+    std::ofstream unexportFile(sysfsRoot_ + "/unexport");
     if (!unexportFile.is_open()) return -1;
     unexportFile << static_cast<int>(pin);
     unexportFile.close();
     return 0;
 }
 
+GPIOLinux::PinInfo* GPIOLinux::acquirePin(const uint8_t pin, const PinDirection direction)
+{
+    PinInfo& info = pins_[pin];
+    if (info.exported.load(std::memory_order_acquire)) return &info;
+
+    std::lock_guard<std::mutex> exportLock(exportMutex_);
+
+    // Another thread may have exported the pin while we waited for the lock
+    if (info.exported.load(std::memory_order_acquire)) return &info;
+
+    if (exportPin(pin) != 0) return nullptr;
+
+    // Wait for udev to create the attributes instead of sleeping a fixed time
+    if (!SysfsWait::waitForNode(getPinPath(pin) + "/value"))
+    {
+        unexportPin(pin);
+        return nullptr;
+    }
+
+    return openPin(pin, direction);
+}
+
+GPIOLinux::PinInfo* GPIOLinux::openPin(const uint8_t pin, const PinDirection direction)
+{
+    const std::string pinPath = getPinPath(pin);
+
+    // The value attribute is mandatory, direction and edge are missing on fixed or non-IRQ lines
+    const int valueFd = open((pinPath + "/value").c_str(), O_RDWR | O_CLOEXEC);
+    if (valueFd < 0)
+    {
+        unexportPin(pin);
+        return nullptr;
+    }
+
+    // Unpublished pins are not touched by other threads, no pin lock needed yet
+    PinInfo& info = pins_[pin];
+    info.direction = direction;
+    info.valueFd.reset(valueFd);
+    info.directionFd.reset(open((pinPath + "/direction").c_str(), O_WRONLY | O_CLOEXEC));
+    info.edgeFd.reset(open((pinPath + "/edge").c_str(), O_WRONLY | O_CLOEXEC));
+
+    // Register with resource manager
+    info.resourceId = ResourceManager::getInstance().registerResource(
+        ResourceType::GPIO_PIN,
+        "GPIO" + std::to_string(pin),
+        reinterpret_cast<void*>(static_cast<uintptr_t>(pin))
+    );
+
+    info.exported.store(true, std::memory_order_release);
+    return &info;
+}
+
+bool GPIOLinux::writeAttribute(const FileDescriptor& fd, const char* value)
+{
+    if (!fd.isValid()) return false;
+
+    const size_t length = std::strlen(value);
+    return pwrite(fd.get(), value, length, 0) == static_cast<ssize_t>(length);
+}
+
 bool GPIOLinux::setDirection(const uint8_t pin, const PinDirection direction)
 {
-    std::lock_guard<std::mutex> lock(pinMutex_);
+    PinInfo* info = acquirePin(pin, direction);
+    if (info == nullptr) return false;
+
+    std::lock_guard<std::mutex> lock(info->mutex);
+    info->direction = direction;
+    info->shadow.store(NO_SHADOW, std::memory_order_release);
+
+    if (!writeAttribute(info->directionFd, direction == PinDirection::OUTPUT ? "out" : "in"))
+    {
+        return false;
+    }
 
-    // Check if pin already exists
-    auto it = pins_.find(pin);
-    if (it == pins_.end())
+    // "out" drives the line low, the shadow starts from there
+    if (direction == PinDirection::OUTPUT)
     {
-        if (exportPin(pin) != 0) return false;
+        info->shadow.store(static_cast<int8_t>(PinValue::LOW), std::memory_order_release);
+    }
+
+    ResourceManager::getInstance().setInUse(info->resourceId, true);
+
+    return true;
+}
 
-        PinInfo info;
-        info.exported = true;
+bool GPIOLinux::setDirectionMask(const PinMask& mask, const PinDirection direction)
+{
+    bool success = true;
+
+    // Export every new pin first so the attribute waits overlap
+    {
+        std::lock_guard<std::mutex> exportLock(exportMutex_);
+
+        std::vector<uint8_t> exported;
+        std::vector<std::string> valuePaths;
+        for (size_t pin = 0; pin < mask.size(); ++pin)
+        {
+            if (!mask.test(pin) || pins_[pin].exported.load(std::memory_order_acquire)) continue;
+            if (exportPin(static_cast<uint8_t>(pin)) != 0) return false;
+            exported.push_back(static_cast<uint8_t>(pin));
+            valuePaths.push_back(getPinPath(static_cast<uint8_t>(pin)) + "/value");
+        }
+
+        success = SysfsWait::waitForNodes(valuePaths);
+        for (const uint8_t pin : exported)
+        {
+            if (openPin(pin, direction) == nullptr) success = false;
+        }
+    }
+
+    const char* value = direction == PinDirection::OUTPUT ? "out" : "in";
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (!mask.test(pin)) continue;
+
+        PinInfo& info = pins_[pin];
+        if (!info.exported.load(std::memory_order_acquire))
+        {
+            success = false;
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(info.mutex);
+        info.shadow.store(NO_SHADOW, std::memory_order_release);
+        if (!writeAttribute(info.directionFd, value))
+        {
+            success = false;
+            continue;
+        }
         info.direction = direction;
-        
-        // Register with resource manager
-        info.resourceId = ResourceManager::getInstance().registerResource(
-            ResourceType::GPIO_PIN,
-            "GPIO" + std::to_string(pin),
-            reinterpret_cast<void*>(static_cast<uintptr_t>(pin))
-        );
-        
-        pins_[pin] = info;
-    }
-    else
-    {
-        pins_[pin].direction = direction;
-    }
-
-    const std::string directionPath = SYS_CLASS_GPIO + std::to_string(pin) + "/direction";
-    std::ofstream directionFile(directionPath);
-    if (!directionFile.is_open()) return false;
-
-    directionFile << (direction == PinDirection::OUTPUT ? "out" : "in");
-    directionFile.close();
-    
-    ResourceManager::getInstance().setInUse(pins_[pin].resourceId, true);
-    
+        if (direction == PinDirection::OUTPUT)
+        {
+            info.shadow.store(static_cast<int8_t>(PinValue::LOW), std::memory_order_release);
+        }
+        ResourceManager::getInstance().setInUse(info.resourceId, true);
+    }
+
+    return success;
+}
+
+bool GPIOLinux::writeValue(const PinInfo& info, const PinValue value)
+{
+    const ResourceIoTimer timer(info.resourceId);
+    const bool result = writeAttribute(info.valueFd, value == PinValue::HIGH ? "1" : "0");
+    timer.finish(result ? 1 : 0, result);
+    return result;
+}
+
+bool GPIOLinux::readValue(const PinInfo& info, PinValue& value)
+{
+    char buf[2];
+    const ResourceIoTimer timer(info.resourceId);
+    const ssize_t bytesRead = pread(info.valueFd.get(), buf, sizeof(buf), 0);
+    timer.finish(bytesRead > 0 ? static_cast<size_t>(bytesRead) : 0, bytesRead > 0);
+    if (bytesRead <= 0)
+    {
+        return false;
+    }
+
+    value = (buf[0] == '1') ? PinValue::HIGH : PinValue::LOW;
     return true;
 }
 
 bool GPIOLinux::write(const uint8_t pin, const PinValue value)
 {
-    std::lock_guard<std::mutex> lock(pinMutex_);
-    
     // Verify pin is configured
-    const auto it = pins_.find(pin);
-    if (it == pins_.end() || !it->second.exported)
+    PinInfo& info = pins_[pin];
+    if (!info.exported.load(std::memory_order_acquire))
     {
         return false;
     }
 
-    const std::string valuePath = SYS_CLASS_GPIO + std::to_string(pin) + "/value";
-    std::ofstream valueFile(valuePath);
-    if (!valueFile.is_open()) return false;
+    std::lock_guard<std::mutex> lock(info.mutex);
+    if (!writeValue(info, value))
+    {
+        return false;
+    }
 
-    valueFile << (value == PinValue::HIGH ? "1" : "0");
-    valueFile.close();
+    if (info.shadow.load(std::memory_order_relaxed) != NO_SHADOW)
+    {
+        info.shadow.store(static_cast<int8_t>(value), std::memory_order_release);
+    }
     return true;
 }
 
 PinValue GPIOLinux::read(const uint8_t pin)
 {
-    std::lock_guard<std::mutex> lock(pinMutex_);
-    
     // Verify pin is configured
-    const auto it = pins_.find(pin);
-    if (it == pins_.end() || !it->second.exported)
+    const PinInfo& info = pins_[pin];
+    if (!info.exported.load(std::memory_order_acquire))
     {
         return PinValue::LOW;
     }
 
-    const std::string valuePath = SYS_CLASS_GPIO + std::to_string(pin) + "/value";
-    std::ifstream valueFile(valuePath);
-    if (!valueFile.is_open()) return PinValue::LOW;
+    // Outputs read back what was last written without a syscall
+    const int8_t shadow = info.shadow.load(std::memory_order_acquire);
+    if (shadow != NO_SHADOW)
+    {
+        return static_cast<PinValue>(shadow);
+    }
 
-    int value;
-    valueFile >> value;
-    valueFile.close();
-    return (value == 1) ? PinValue::HIGH : PinValue::LOW;
+    return readback(pin);
 }
 
-void GPIOLinux::monitorInterrupt(const uint8_t pin, uint64_t callbackId) const
+PinValue GPIOLinux::readback(const uint8_t pin)
 {
-    const std::string valuePath = SYS_CLASS_GPIO + std::to_string(pin) + "/value";
+    // Verify pin is configured
+    const PinInfo& info = pins_[pin];
+    if (!info.exported.load(std::memory_order_acquire))
+    {
+        return PinValue::LOW;
+    }
+
+    std::lock_guard<std::mutex> lock(info.mutex);
+    PinValue value = PinValue::LOW;
+    readValue(info, value);
+    return value;
+}
 
-    const int fd = open(valuePath.c_str(), O_RDONLY);
-    if (fd < 0)
+bool GPIOLinux::toggle(const uint8_t pin)
+{
+    // Verify pin is configured
+    PinInfo& info = pins_[pin];
+    if (!info.exported.load(std::memory_order_acquire))
     {
-        return;
+        return false;
     }
 
-    // Initial dummy read to clear any pending interrupts
-    char buf[3];
-    ::read(fd, buf, sizeof(buf));
+    // The shadow is only changed under the pin lock, so read-invert-write is atomic per pin
+    std::lock_guard<std::mutex> lock(info.mutex);
+    const int8_t shadow = info.shadow.load(std::memory_order_relaxed);
+    if (shadow == NO_SHADOW) return false;
+
+    const PinValue next = static_cast<PinValue>(shadow) == PinValue::HIGH ? PinValue::LOW : PinValue::HIGH;
+    if (!writeValue(info, next))
+    {
+        return false;
+    }
+
+    info.shadow.store(static_cast<int8_t>(next), std::memory_order_release);
+    return true;
+}
+
+bool GPIOLinux::writeMask(const PinMask& mask, const PinMask& values)
+{
+    // Check every pin first so an unconfigured pin does not leave the bus half written
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (mask.test(pin) && !pins_[pin].exported.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+    }
+
+    // sysfs has no multi-line attribute, holding every line lock keeps concurrent batches from interleaving
+    bool result = true;
+    lockPins(mask);
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (!mask.test(pin)) continue;
+
+        PinInfo& info = pins_[pin];
+        if (!writeValue(info, values.test(pin) ? PinValue::HIGH : PinValue::LOW))
+        {
+            result = false;
+            continue;
+        }
+
+        if (info.shadow.load(std::memory_order_relaxed) != NO_SHADOW)
+        {
+            info.shadow.store(static_cast<int8_t>(values.test(pin) ? PinValue::HIGH : PinValue::LOW),
+                              std::memory_order_release);
+        }
+    }
+    unlockPins(mask);
+
+    return result;
+}
+
+PinMask GPIOLinux::readMask(const PinMask& mask)
+{
+    PinMask exported;
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (mask.test(pin) && pins_[pin].exported.load(std::memory_order_acquire)) exported.set(pin);
+    }
 
-    pollfd pfd{};
-    pfd.fd = fd;
-    pfd.events = POLLPRI | POLLERR;
+    // All line locks are held so the sample never mixes the values of two concurrent writeMask() calls
+    PinMask result;
+    lockPins(exported);
+    for (size_t pin = 0; pin < exported.size(); ++pin)
+    {
+        if (!exported.test(pin)) continue;
+
+        const PinInfo& info = pins_[pin];
+        const int8_t shadow = info.shadow.load(std::memory_order_acquire);
+        if (shadow != NO_SHADOW)
+        {
+            if (static_cast<PinValue>(shadow) == PinValue::HIGH) result.set(pin);
+            continue;
+        }
+
+        PinValue value = PinValue::LOW;
+        if (readValue(info, value) && value == PinValue::HIGH)
+        {
+            result.set(pin);
+        }
+    }
+    unlockPins(exported);
+
+    return result;
+}
+
+void GPIOLinux::lockPins(const PinMask& mask) const
+{
+    for (size_t pin = 0; pin < mask.size(); ++pin)
+    {
+        if (mask.test(pin)) pins_[pin].mutex.lock();
+    }
+}
+
+void GPIOLinux::unlockPins(const PinMask& mask) const
+{
+    for (size_t pin = mask.size(); pin-- > 0;)
+    {
+        if (mask.test(pin)) pins_[pin].mutex.unlock();
+    }
+}
+
+void GPIOLinux::dispatchLoop()
+{
+    epoll_event events[16];
 
     while (!shutdownRequested_.load(std::memory_order_acquire))
     {
-        const int ret = poll(&pfd, 1, 100); // 100ms timeout
-        
-        if (ret > 0 && (pfd.revents & POLLPRI))
+        const int count = epoll_wait(epollFd_.get(), events, 16, -1);
+
+        // One timestamp per wakeup, taken as close to the edges as userspace can
+        const uint64_t timestampNs = monotonicNs();
+
+        for (int i = 0; i < count; ++i)
+        {
+            const uint64_t token = events[i].data.u64;
+            if (token == WAKE_TOKEN)
+            {
+                uint64_t counter;
+                ::read(wakeFd_.get(), &counter, sizeof(counter));
+                continue;
+            }
+            if (token == TIMER_TOKEN)
+            {
+                uint64_t expirations;
+                ::read(timerFd_.get(), &expirations, sizeof(expirations));
+                settleFilters(timestampNs);
+                continue;
+            }
+
+            // Read under the pin lock so removeInterrupt cannot close the descriptor underneath us
+            const auto pin = static_cast<uint8_t>(token);
+            PinInfo& info = pins_[pin];
+            std::lock_guard<std::mutex> lock(info.mutex);
+            if (!info.interruptActive.load(std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            char buf[3];
+            if (pread(info.irqFd.get(), buf, sizeof(buf), 0) <= 0)
+            {
+                continue;
+            }
+
+            const PinValue value = (buf[0] == '1') ? PinValue::HIGH : PinValue::LOW;
+            uint32_t coalesced = 0;
+            {
+                std::lock_guard<std::mutex> filterLock(filterMutex_);
+                if (rateLimiter_.isEnabled(pin))
+                {
+                    uint64_t deadlineNs;
+                    const GPIORateLimiter::Verdict verdict = rateLimiter_.onEdge(pin, value, timestampNs, deadlineNs);
+                    armFilterTimer(deadlineNs);
+
+                    // Stop the storm at its source, settleFilters() re-arms the pin
+                    if (verdict == GPIORateLimiter::Verdict::DISABLE)
+                    {
+                        writeAttribute(info.edgeFd, "none");
+                    }
+                    if (verdict != GPIORateLimiter::Verdict::DELIVER)
+                    {
+                        continue;
+                    }
+                }
+
+                if (debouncer_.isEnabled(pin))
+                {
+                    armFilterTimer(debouncer_.onEdge(pin, value, timestampNs));
+                    continue;
+                }
+
+                // Edges folded since the last delivery that never reached the subscriber
+                coalesced = rateLimiter_.takeCoalesced(pin);
+            }
+
+            Delivery delivery;
+            delivery.event.pin = pin;
+            delivery.event.value = value;
+            delivery.event.timestampNs = timestampNs;
+            delivery.event.coalesced = coalesced;
+            delivery.queued = info.queueEvents;
+            deliveries_.push_back(delivery);
+        }
+
+        // Deliver without holding any lock, callbacks may call back into this object
+        for (const Delivery& delivery : deliveries_)
         {
-            // Clear the event
-            lseek(fd, 0, SEEK_SET);
-            const int len = ::read(fd, buf, sizeof(buf));
-            
-            if (len > 0)
+            if (delivery.queued)
             {
-                // Determine pin value
-                const PinValue value = (buf[0] == '1') ? PinValue::HIGH : PinValue::LOW;
-                
-                // Invoke callback through callback manager
-                CallbackManager::getInstance().invokeGPIOCallback(pin, value);
+                edgeEvents_.push(delivery.event.pin, delivery.event.value, delivery.event.timestampNs,
+                                 delivery.event.coalesced);
             }
+            else
+            {
+                CallbackManager::getInstance().invokeGPIOCallback(delivery.event.pin, delivery.event.value,
+                                                                 delivery.event.timestampNs,
+                                                                 delivery.event.coalesced);
+            }
+        }
+        deliveries_.clear();
+    }
+}
+
+void GPIOLinux::armFilterTimer(const uint64_t deadlineNs)
+{
+    if (deadlineNs >= armedDeadlineNs_)
+    {
+        return;
+    }
+
+    itimerspec spec{};
+    spec.it_value.tv_sec = static_cast<time_t>(deadlineNs / 1000000000ULL);
+    spec.it_value.tv_nsec = static_cast<long>(deadlineNs % 1000000000ULL);
+    if (timerfd_settime(timerFd_.get(), TFD_TIMER_ABSTIME, &spec, nullptr) == 0)
+    {
+        armedDeadlineNs_ = deadlineNs;
+    }
+}
+
+void GPIOLinux::forwardLimited(const GPIOEdgeEvent& event)
+{
+    if (debouncer_.isEnabled(event.pin))
+    {
+        armFilterTimer(debouncer_.onEdge(event.pin, event.value, event.timestampNs));
+        return;
+    }
+
+    settled_.push_back(event);
+}
+
+void GPIOLinux::settleFilters(const uint64_t nowNs)
+{
+    {
+        std::lock_guard<std::mutex> filterLock(filterMutex_);
+        limited_.clear();
+        settled_.clear();
+        rearmPins_.reset();
+        armedDeadlineNs_ = GPIODebouncer::NO_DEADLINE;
+
+        // Coalesced edges pass through the debouncer like raw edges would
+        armFilterTimer(rateLimiter_.settle(nowNs, limited_, rearmPins_));
+        for (const GPIOEdgeEvent& event : limited_)
+        {
+            forwardLimited(event);
+        }
+        armFilterTimer(debouncer_.settle(nowNs, settled_));
+    }
+
+    // Pin locks are taken after filterMutex_ is released to keep the pin -> filter lock order
+    for (size_t pin = 0; pin < rearmPins_.size(); ++pin)
+    {
+        if (!rearmPins_.test(pin)) continue;
+
+        PinInfo& info = pins_[pin];
+        std::lock_guard<std::mutex> lock(info.mutex);
+        if (!info.interruptActive.load(std::memory_order_acquire) || !writeEdge(static_cast<uint8_t>(pin), info))
+        {
+            continue;
+        }
+
+        // Report the level if it changed while edge detection was off, the read also clears a stale notification
+        char buf[3];
+        if (pread(info.irqFd.get(), buf, sizeof(buf), 0) <= 0) continue;
+
+        GPIOEdgeEvent event;
+        event.pin = static_cast<uint8_t>(pin);
+        event.value = (buf[0] == '1') ? PinValue::HIGH : PinValue::LOW;
+        event.timestampNs = nowNs;
+
+        std::lock_guard<std::mutex> filterLock(filterMutex_);
+        if (rateLimiter_.onRearm(event.pin, event.value))
+        {
+            event.coalesced = rateLimiter_.takeCoalesced(event.pin);
+            forwardLimited(event);
         }
     }
 
-    ::close(fd);
+    for (const GPIOEdgeEvent& event : settled_)
+    {
+        const PinInfo& info = pins_[event.pin];
+        std::lock_guard<std::mutex> lock(info.mutex);
+        if (!info.interruptActive.load(std::memory_order_acquire))
+        {
+            continue;
+        }
+
+        // Debounced and coalesced edges may have either level, apply the requested trigger
+        if ((info.edge == EdgeTrigger::RISING && event.value != PinValue::HIGH) ||
+            (info.edge == EdgeTrigger::FALLING && event.value != PinValue::LOW))
+        {
+            continue;
+        }
+
+        Delivery delivery;
+        delivery.event = event;
+        delivery.queued = info.queueEvents;
+        deliveries_.push_back(delivery);
+    }
 }
 
-bool GPIOLinux::setInterrupt(const uint8_t pin, EdgeTrigger edge, InterruptCallback callback)
+bool GPIOLinux::startDispatcher()
 {
-    std::lock_guard<std::mutex> lock(pinMutex_);
+    if (dispatcherRunning_.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(dispatcherMutex_);
+    if (dispatcherThread_.joinable())
+    {
+        return true;
+    }
+
+    epollFd_.reset(epoll_create1(EPOLL_CLOEXEC));
+    wakeFd_.reset(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (!epollFd_.isValid() || !wakeFd_.isValid())
+    {
+        return false;
+    }
+
+    timerFd_.reset(timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK));
+    if (!timerFd_.isValid())
+    {
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = WAKE_TOKEN;
+    if (epoll_ctl(epollFd_.get(), EPOLL_CTL_ADD, wakeFd_.get(), &event) != 0)
+    {
+        return false;
+    }
+
+    event.data.u64 = TIMER_TOKEN;
+    if (epoll_ctl(epollFd_.get(), EPOLL_CTL_ADD, timerFd_.get(), &event) != 0)
+    {
+        return false;
+    }
+
+    deliveries_.reserve(256);
+    settled_.reserve(256);
+
+    dispatcherThread_ = std::thread(&GPIOLinux::dispatchLoop, this);
+    ThreadConfig::apply(dispatcherThread_.native_handle(), dispatcherSchedule_);
+    dispatcherRunning_.store(true, std::memory_order_release);
+    return true;
+}
 
-    auto it = pins_.find(pin);
-    if (it == pins_.end())
+bool GPIOLinux::writeEdge(const uint8_t pin, const PinInfo& info) const
+{
+    bool debounced;
+    bool disabled;
     {
-        if (exportPin(pin) != 0) return false;
+        std::lock_guard<std::mutex> filterLock(filterMutex_);
+        debounced = debouncer_.isEnabled(pin);
+        disabled = rateLimiter_.isDisabled(pin);
+    }
 
-        PinInfo info;
-        info.exported = true;
-        info.direction = PinDirection::INPUT;
-        info.resourceId = ResourceManager::getInstance().registerResource(
-            ResourceType::GPIO_PIN,
-            "GPIO" + std::to_string(pin),
-            reinterpret_cast<void*>(static_cast<uintptr_t>(pin))
-        );
-        pins_[pin] = info;
+    if (disabled)
+    {
+        return writeAttribute(info.edgeFd, "none");
     }
+    return writeAttribute(info.edgeFd, debounced ? "both" : edgeName(info.edge));
+}
 
+bool GPIOLinux::armInterrupt(const uint8_t pin, PinInfo& info, const EdgeTrigger edge)
+{
     // Set direction to input
-    const std::string directionPath = SYS_CLASS_GPIO + std::to_string(pin) + "/direction";
-    std::ofstream directionFile(directionPath);
-    if (!directionFile.is_open()) return false;
-    directionFile << "in";
-    directionFile.close();
+    info.shadow.store(NO_SHADOW, std::memory_order_release);
+    if (!writeAttribute(info.directionFd, "in")) return false;
+    info.direction = PinDirection::INPUT;
 
     // Configure edge detection
-    const std::string edgePath = SYS_CLASS_GPIO + std::to_string(pin) + "/edge";
-    std::ofstream edgeFile(edgePath);
-    if (!edgeFile.is_open()) return false;
+    info.edge = edge;
+    if (!writeEdge(pin, info)) return false;
 
-    switch (edge)
+    // Arm the pin on the shared epoll set, epoll_ctl takes effect even while the dispatcher waits
+    if (!info.interruptActive.load(std::memory_order_acquire))
     {
-        case EdgeTrigger::RISING:
-            edgeFile << "rising";
-            break;
-        case EdgeTrigger::FALLING:
-            edgeFile << "falling";
-            break;
-        case EdgeTrigger::BOTH:
-            edgeFile << "both";
-            break;
+        info.irqFd.reset(open((getPinPath(pin) + "/value").c_str(), O_RDONLY | O_CLOEXEC));
+        if (!info.irqFd.isValid()) return false;
+
+        // Initial dummy read to clear any pending interrupts
+        char buf[3];
+        pread(info.irqFd.get(), buf, sizeof(buf), 0);
+
+        epoll_event event{};
+        event.events = EPOLLPRI | EPOLLERR;
+        event.data.u64 = pin;
+        if (epoll_ctl(epollFd_.get(), EPOLL_CTL_ADD, info.irqFd.get(), &event) != 0)
+        {
+            info.irqFd.close();
+            return false;
+        }
     }
-    edgeFile.close();
 
-    // Register callback
-    uint64_t callbackId = CallbackManager::getInstance().registerGPIOCallback(pin, callback);
-    pins_[pin].callbackId = callbackId;
+    return true;
+}
+
+bool GPIOLinux::setInterrupt(const uint8_t pin, const EdgeTrigger edge, InterruptCallback callback)
+{
+    return setInterrupt(pin, edge, std::move(callback), EdgeRateLimit{});
+}
+
+bool GPIOLinux::setInterrupt(const uint8_t pin, const EdgeTrigger edge, InterruptCallback callback,
+                             const EdgeRateLimit& limit)
+{
+    PinInfo* info = acquirePin(pin, PinDirection::INPUT);
+    if (info == nullptr || !startDispatcher()) return false;
+
+    std::lock_guard<std::mutex> lock(info->mutex);
+    {
+        std::lock_guard<std::mutex> filterLock(filterMutex_);
+        rateLimiter_.configure(pin, limit);
+    }
+    if (!armInterrupt(pin, *info, edge)) return false;
+
+    // Replace any previous callback for this pin
+    if (info->callbackId != 0)
+    {
+        CallbackManager::getInstance().unregisterGPIOCallback(info->callbackId);
+    }
+    info->callbackId = CallbackManager::getInstance().registerGPIOCallback(pin, std::move(callback));
+    info->queueEvents = false;
+    info->interruptActive.store(true, std::memory_order_release);
+
+    return true;
+}
+
+bool GPIOLinux::enableEdgeEvents(const uint8_t pin, const EdgeTrigger edge)
+{
+    PinInfo* info = acquirePin(pin, PinDirection::INPUT);
+    if (info == nullptr || !startDispatcher()) return false;
+
+    std::lock_guard<std::mutex> lock(info->mutex);
+    {
+        std::lock_guard<std::mutex> filterLock(filterMutex_);
+        rateLimiter_.configure(pin, EdgeRateLimit{});
+    }
+    if (!armInterrupt(pin, *info, edge)) return false;
 
-    // Start interrupt monitoring thread if not already active
-    if (!pins_[pin].interruptActive.exchange(true, std::memory_order_acq_rel))
+    // Edges go to the queue, drop any callback from a previous setInterrupt
+    if (info->callbackId != 0)
     {
-        interruptThreads_[pin] = std::make_unique<std::thread>(
-            &GPIOLinux::monitorInterrupt, this, pin, callbackId
-        );
+        CallbackManager::getInstance().unregisterGPIOCallback(info->callbackId);
+        info->callbackId = 0;
     }
+    info->queueEvents = true;
+    info->interruptActive.store(true, std::memory_order_release);
 
     return true;
 }
 
+EdgeRateStats GPIOLinux::getEdgeRateStats(const uint8_t pin) const
+{
+    std::lock_guard<std::mutex> filterLock(filterMutex_);
+    return rateLimiter_.getStats(pin);
+}
+
+uint64_t GPIOLinux::getResourceId(const uint8_t pin) const
+{
+    // The ID is written before the pin is published
+    const PinInfo& info = pins_[pin];
+    return info.exported.load(std::memory_order_acquire) ? info.resourceId : 0;
+}
+
+GPIOEventQueue& GPIOLinux::getEdgeEventQueue()
+{
+    return edgeEvents_;
+}
+
 bool GPIOLinux::removeInterrupt(const uint8_t pin)
 {
-    std::lock_guard<std::mutex> lock(pinMutex_);
+    PinInfo& info = pins_[pin];
+    if (!info.exported.load(std::memory_order_acquire))
+    {
+        return false;
+    }
 
-    const auto it = pins_.find(pin);
-    if (it == pins_.end() || !it->second.interruptActive.load(std::memory_order_acquire))
+    std::lock_guard<std::mutex> lock(info.mutex);
+    if (!info.interruptActive.load(std::memory_order_acquire))
     {
         return false;
     }
 
     // Disable edge detection
-    const std::string edgePath = SYS_CLASS_GPIO + std::to_string(pin) + "/edge";
-    std::ofstream edgeFile(edgePath);
-    if (!edgeFile.is_open()) return false;
-    edgeFile << "none";
-    edgeFile.close();
+    if (!writeAttribute(info.edgeFd, "none")) return false;
 
-    // Mark interrupt as inactive
-    pins_[pin].interruptActive.store(false, std::memory_order_release);
+    // Mark interrupt as inactive and disarm the pin
+    info.interruptActive.store(false, std::memory_order_release);
+    info.queueEvents = false;
+    {
+        std::lock_guard<std::mutex> filterLock(filterMutex_);
+        debouncer_.cancel(pin);
+    }
+    epoll_ctl(epollFd_.get(), EPOLL_CTL_DEL, info.irqFd.get(), nullptr);
+    info.irqFd.close();
 
     // Unregister callback
-    if (pins_[pin].callbackId != 0)
+    if (info.callbackId != 0)
     {
-        CallbackManager::getInstance().unregisterGPIOCallback(pins_[pin].callbackId);
-        pins_[pin].callbackId = 0;
+        CallbackManager::getInstance().unregisterGPIOCallback(info.callbackId);
+        info.callbackId = 0;
     }
 
     return true;
@@ -275,19 +843,61 @@ bool GPIOLinux::removeInterrupt(const uint8_t pin)
 
 bool GPIOLinux::setDebounce(const uint8_t pin, const uint32_t debounceTimeMs)
 {
-    std::lock_guard<std::mutex> lock(pinMutex_);
-
-    const auto it = pins_.find(pin);
-    if (it == pins_.end() || !it->second.exported)
+    PinInfo& info = pins_[pin];
+    if (!info.exported.load(std::memory_order_acquire))
     {
         return false;
     }
 
-    const std::string debouncePath = SYS_CLASS_GPIO + std::to_string(pin) + "/debounce";
-    std::ofstream debounceFile(debouncePath);
-    if (!debounceFile.is_open()) return false;
-    debounceFile << debounceTimeMs;
-    debounceFile.close();
+    std::lock_guard<std::mutex> lock(info.mutex);
+
+    // The sysfs debounce attribute is missing on most kernels, filter edges in the dispatcher instead
+    char buf[3];
+    if (pread(info.valueFd.get(), buf, sizeof(buf), 0) <= 0) return false;
+    const PinValue level = (buf[0] == '1') ? PinValue::HIGH : PinValue::LOW;
+    {
+        std::lock_guard<std::mutex> filterLock(filterMutex_);
+        debouncer_.configure(pin, static_cast<uint64_t>(debounceTimeMs) * 1000000ULL, level);
+    }
+
+    if (info.interruptActive.load(std::memory_order_acquire))
+    {
+        return writeEdge(pin, info);
+    }
 
     return true;
-}
\ No newline at end of file
+}
+
+uint64_t GPIOLinux::getSuppressedBounceCount(const uint8_t pin) const
+{
+    std::lock_guard<std::mutex> filterLock(filterMutex_);
+    return debouncer_.getSuppressedCount(pin);
+}
+
+bool GPIOLinux::setInterruptThreadPriority(const int32_t priority)
+{
+    std::lock_guard<std::mutex> lock(dispatcherMutex_);
+
+    ThreadSchedule schedule = dispatcherSchedule_;
+    schedule.priority = priority;
+    if (!ThreadConfig::isValid(schedule)) return false;
+
+    dispatcherSchedule_ = schedule;
+    if (!dispatcherThread_.joinable()) return true;
+
+    return ThreadConfig::applyPriority(dispatcherThread_.native_handle(), priority);
+}
+
+bool GPIOLinux::setInterruptThreadAffinity(const int32_t cpu)
+{
+    std::lock_guard<std::mutex> lock(dispatcherMutex_);
+
+    ThreadSchedule schedule = dispatcherSchedule_;
+    schedule.cpu = cpu;
+    if (!ThreadConfig::isValid(schedule)) return false;
+
+    dispatcherSchedule_ = schedule;
+    if (!dispatcherThread_.joinable()) return true;
+
+    return ThreadConfig::applyAffinity(dispatcherThread_.native_handle(), cpu);
+}
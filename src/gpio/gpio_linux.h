@@ -3,6 +3,11 @@
 
 #include "../../include/hal/gpio.h"
 #include "../../include/hal/resource_manager.h"
+#include "../../include/hal/file_descriptor.h"
+#include "../thread_config/thread_config.h"
+#include "../sysfs_wait/sysfs_wait.h"
+#include "gpio_debouncer.h"
+#include "gpio_rate_limiter.h"
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
@@ -10,7 +15,8 @@
 #include <fstream>
 #include <stdexcept>
 #include <mutex>
-#include <unordered_map>
+#include <array>
+#include <vector>
 #include <thread>
 #include <atomic>
 
@@ -21,86 +27,212 @@ namespace mex_hal
     class GPIOLinux : public GPIOInterface
     {
     private:
+        static constexpr int8_t NO_SHADOW = -1;
+
         /// @brief Pin information structure, tracks state of each GPIO pin \struct PinInfo
-        struct PinInfo
+        struct alignas(64) PinInfo
         {
+            // Serializes attribute I/O and state changes of this pin only
+            mutable std::mutex mutex;
+
+            // Published with release once the attribute files are open, never cleared before destruction
+            std::atomic<bool> exported{false};
+
+            // Last written level of an output pin, NO_SHADOW while the pin is an input
+            std::atomic<int8_t> shadow{NO_SHADOW};
+
             uint64_t resourceId = 0;
             PinDirection direction = PinDirection::INPUT;
-            bool exported = false;
             std::atomic<bool> interruptActive{false};
+            bool queueEvents = false;
+            EdgeTrigger edge = EdgeTrigger::BOTH;
             uint64_t callbackId = 0;
 
+            // Attribute files stay open for the lifetime of the export
+            FileDescriptor valueFd;
+            FileDescriptor directionFd;
+            FileDescriptor edgeFd;
+
+            // Separate open file for edge notification, reads on valueFd would consume events
+            FileDescriptor irqFd;
+
             /**
              * @brief Constructor
              */
             PinInfo() = default;
 
-            /**
-             * @brief Copy constructor
-             * @param other The other PinInfo to copy from
-             */
-            PinInfo(const PinInfo& other)
-                : resourceId(other.resourceId)
-                , direction(other.direction)
-                , exported(other.exported)
-                , interruptActive(other.interruptActive.load())
-                , callbackId(other.callbackId)
-            {
-
-            }
+            /// @brief Prevent copying, the attribute descriptors are owned
+            PinInfo(const PinInfo&) = delete;
+            PinInfo& operator=(const PinInfo&) = delete;
+        };
 
-            /**
-             * @brrief Copy assignment operator
-             * @param other The other PinInfo to copy from
-             * @return A reference to this PinInfo
-             */
-            PinInfo& operator=(const PinInfo& other)
-            {
-                if (this != &other)
-                {
-                    resourceId = other.resourceId;
-                    direction = other.direction;
-                    exported = other.exported;
-                    interruptActive.store(other.interruptActive.load());
-                    callbackId = other.callbackId;
-                }
-                return *this;
-            }
+        /// @brief Edge ready for delivery outside the pin locks \struct Delivery
+        struct Delivery
+        {
+            GPIOEdgeEvent event;
+            bool queued = false;
         };
 
-        mutable std::mutex pinMutex_;
-        std::unordered_map<uint8_t, PinInfo> pins_;
+        std::string sysfsRoot_;
+
+        // Lock striping: one entry per uint8_t pin, exportMutex_ only guards export/unexport
+        std::array<PinInfo, 256> pins_;
+        std::mutex exportMutex_;
 
-        // Interrupt monitoring
-        std::unordered_map<uint8_t, std::unique_ptr<std::thread>> interruptThreads_;
+        // Interrupt dispatch, one epoll thread serves every pin
+        std::mutex dispatcherMutex_;
+        FileDescriptor epollFd_;
+        FileDescriptor wakeFd_;
+        std::thread dispatcherThread_;
+        ThreadSchedule dispatcherSchedule_;
+        std::atomic<bool> dispatcherRunning_{false};
         std::atomic<bool> shutdownRequested_{false};
+        GPIOEventQueue edgeEvents_;
+        std::vector<Delivery> deliveries_;
+
+        // Software edge filters (rate limit, debounce), one timerfd on the epoll set serves every pin
+        mutable std::mutex filterMutex_;
+        FileDescriptor timerFd_;
+        GPIORateLimiter rateLimiter_;
+        GPIODebouncer debouncer_;
+        uint64_t armedDeadlineNs_ = GPIODebouncer::NO_DEADLINE;
+        std::vector<GPIOEdgeEvent> limited_;
+        std::vector<GPIOEdgeEvent> settled_;
+        PinMask rearmPins_;
 
         /**
-         * @brief Export a GPIO pin
+         * @brief Get the sysfs directory of an exported GPIO pin
+         * @param pin The GPIO pin number
+         * @return A string representing the pin directory
+         */
+        std::string getPinPath(uint8_t pin) const;
+
+        /**
+         * @brief Request the export of a GPIO pin, the attribute files appear asynchronously
          * @param pin The GPIO pin number
          * @return A integer status code (0 = success, -1 = failure)
          */
-        static int exportPin(uint8_t pin);
+        int exportPin(uint8_t pin) const;
 
         /**
          * @brief Unexport a GPIO pin
          * @param pin The GPIO pin number
          * @return A integer status code (0 = success, -1 = failure)
          */
-        static int unexportPin(uint8_t pin);
+        int unexportPin(uint8_t pin) const;
+
+        /**
+         * @brief Get an exported pin, exporting it and opening its attribute files on first use
+         * @param pin The GPIO pin number
+         * @param direction The initial direction recorded for a newly exported pin
+         * @return A pointer to the PinInfo, nullptr on failure
+         */
+        PinInfo* acquirePin(uint8_t pin, PinDirection direction);
+
+        /**
+         * @brief Open the attribute files of an exported pin and publish it, caller must hold exportMutex_
+         * @param pin The GPIO pin number
+         * @param direction The initial direction recorded for the pin
+         * @return A pointer to the new PinInfo, nullptr on failure (the pin is unexported again)
+         */
+        PinInfo* openPin(uint8_t pin, PinDirection direction);
+
+        /**
+         * @brief Write a string to an open sysfs attribute at offset 0
+         * @param fd The attribute file descriptor
+         * @param value The value to write
+         * @return A true if the whole value was written, false otherwise
+         */
+        static bool writeAttribute(const FileDescriptor& fd, const char* value);
+
+        /**
+         * @brief Write the value attribute of a pin and count it for the pin's resource, caller must hold the pin lock
+         * @param info The exported pin
+         * @param value The level to drive
+         * @return A true if the value was written, false otherwise
+         */
+        static bool writeValue(const PinInfo& info, PinValue value);
 
         /**
-         * @brief Monitor GPIO pin for interrupts
+         * @brief Read the value attribute of a pin and count it for the pin's resource, caller must hold the pin lock
+         * @param info The exported pin
+         * @param value Receives the level
+         * @return A true if the value was read, false otherwise
+         */
+        static bool readValue(const PinInfo& info, PinValue& value);
+
+        /**
+         * @brief Take the locks of every pin in a mask in ascending pin order
+         *
+         * No other path holds two pin locks, so the fixed order cannot deadlock and
+         * concurrent bulk operations on overlapping masks are serialized.
+         * @param mask The pins to lock
+         */
+        void lockPins(const PinMask& mask) const;
+
+        /**
+         * @brief Release the locks taken by lockPins()
+         * @param mask The pins to unlock
+         */
+        void unlockPins(const PinMask& mask) const;
+
+        /**
+         * @brief Interrupt dispatch loop, waits on every armed pin with epoll
+         */
+        void dispatchLoop();
+
+        /**
+         * @brief Start the dispatch thread if needed
+         * @return A true if the dispatcher is running, false otherwise
+         */
+        bool startDispatcher();
+
+        /**
+         * @brief Configure edge detection and add a pin to the epoll set, caller must hold the pin lock
+         * @param pin The GPIO pin number
+         * @param info The exported pin
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @return A true if the pin is armed, false otherwise
+         */
+        bool armInterrupt(uint8_t pin, PinInfo& info, EdgeTrigger edge);
+
+        /**
+         * @brief Write the sysfs edge attribute of a pin, debounced pins watch both edges and storming pins none, caller must hold the pin lock
          * @param pin The GPIO pin number
-         * @param callbackId The callback ID to invoke on interrupt
+         * @param info The pin information
+         * @return A true if the attribute was written, false otherwise
+         */
+        bool writeEdge(uint8_t pin, const PinInfo& info) const;
+
+        /**
+         * @brief Move the edge filter timer to an earlier deadline, caller must hold filterMutex_
+         * @param deadlineNs The CLOCK_MONOTONIC deadline in nanoseconds
+         */
+        void armFilterTimer(uint64_t deadlineNs);
+
+        /**
+         * @brief Pass a rate limited edge on to the debouncer or queue it for delivery, caller must hold filterMutex_
+         * @param event The edge
+         */
+        void forwardLimited(const GPIOEdgeEvent& event);
+
+        /**
+         * @brief Run the expired edge filter deadlines: flush coalesced edges, re-arm storming pins, settle debounced pins
+         * @param nowNs The current CLOCK_MONOTONIC time in nanoseconds
          */
-        void monitorInterrupt(uint8_t pin, uint64_t callbackId) const;
+        void settleFilters(uint64_t nowNs);
 
     public:
         /**
          * @brief Constructor
          */
-        GPIOLinux() = default;
+        GPIOLinux();
+
+        /**
+         * @brief Constructor with a custom sysfs root (e.g. a fake tree for tests)
+         * @param sysfsRoot The directory containing export, unexport and gpioN entries
+         */
+        explicit GPIOLinux(std::string sysfsRoot);
 
         /**
          * @brief Destructor
@@ -124,12 +256,49 @@ namespace mex_hal
         bool write(uint8_t pin, PinValue value) override;
 
         /**
-         * @brief Read the value of a GPIO pin
+         * @brief Read the value of a GPIO pin, outputs are served from the last written value
          * @param pin The GPIO pin number
-         * @return A PinValue representing the current value of the pin (HIGH or LOW)
+         * @return A PinValue representing the current value of the GPIO pin (HIGH or LOW)
          */
         PinValue read(uint8_t pin) override;
 
+        /**
+         * @brief Read the level of a GPIO pin from hardware, bypassing the output shadow
+         * @param pin The GPIO pin number
+         * @return A PinValue representing the current value of the GPIO pin (HIGH or LOW)
+         */
+        PinValue readback(uint8_t pin) override;
+
+        /**
+         * @brief Invert an output GPIO pin from its shadow value with a single write
+         * @param pin The GPIO pin number
+         * @return A true if the GPIO pin was toggled, false if it is not a configured output
+         */
+        bool toggle(uint8_t pin) override;
+
+        /**
+         * @brief Set the direction of several GPIO pins, new pins are exported together so their waits overlap
+         * @param mask The pins to configure
+         * @param direction The direction to set (INPUT or OUTPUT)
+         * @return A true if every selected pin was configured, false otherwise
+         */
+        bool setDirectionMask(const PinMask& mask, PinDirection direction) override;
+
+        /**
+         * @brief Write several GPIO pins as one batch
+         * @param mask The pins to update
+         * @param values The values for the selected pins (set bit = HIGH)
+         * @return A true if all selected pins were written, false otherwise
+         */
+        bool writeMask(const PinMask& mask, const PinMask& values) override;
+
+        /**
+         * @brief Read several GPIO pins as one batch
+         * @param mask The pins to sample
+         * @return The sampled values, bits outside mask are cleared (set bit = HIGH)
+         */
+        PinMask readMask(const PinMask& mask) override;
+
         /**
          * @brief Set up an interrupt on a GPIO pin
          * @param pin The GPIO pin number
@@ -139,6 +308,30 @@ namespace mex_hal
          */
         bool setInterrupt(uint8_t pin, EdgeTrigger edge, InterruptCallback callback) override;
 
+        /**
+         * @brief Set up a rate limited interrupt on a GPIO pin, excess edges never reach the CallbackManager
+         * @param pin The GPIO pin number
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @param callback The callback function to invoke on interrupt
+         * @param limit The maximum edge rate and the handling of excess edges
+         * @return A true if the interrupt was successfully set, false otherwise
+         */
+        bool setInterrupt(uint8_t pin, EdgeTrigger edge, InterruptCallback callback, const EdgeRateLimit& limit) override;
+
+        /**
+         * @brief Get the rate limit counters of a GPIO pin
+         * @param pin The GPIO pin number
+         * @return The counters since the interrupt was last set
+         */
+        [[nodiscard]] EdgeRateStats getEdgeRateStats(uint8_t pin) const override;
+
+        /**
+         * @brief Get the ResourceManager ID of a GPIO pin
+         * @param pin The GPIO pin number
+         * @return The resource ID, 0 if the pin is not exported
+         */
+        [[nodiscard]] uint64_t getResourceId(uint8_t pin) const override;
+
         /**
          * @brief Remove an interrupt from a GPIO pin
          * @param pin The GPIO pin number
@@ -147,12 +340,47 @@ namespace mex_hal
         bool removeInterrupt(uint8_t pin) override;
 
         /**
-         * @brief Set debounce time for a GPIO pin
+         * @brief Set up edge detection on a GPIO pin that feeds the edge event queue instead of a callback
          * @param pin The GPIO pin number
-         * @param debounceTimeMs The debounce time in milliseconds
+         * @param edge The edge trigger type (RISING, FALLING, or BOTH)
+         * @return A true if edge events were enabled, false otherwise
+         */
+        bool enableEdgeEvents(uint8_t pin, EdgeTrigger edge) override;
+
+        /**
+         * @brief Get the timestamped edge event queue of this controller
+         * @return The queue, may be drained from any number of threads
+         */
+        GPIOEventQueue& getEdgeEventQueue() override;
+
+        /**
+         * @brief Set the software debounce time of a GPIO pin, one callback is delivered per settled transition
+         * @param pin The GPIO pin number
+         * @param debounceTimeMs The time the level must be stable in milliseconds, 0 disables debouncing
          * @return A true if the debounce time was successfully set, false otherwise
          */
         bool setDebounce(uint8_t pin, uint32_t debounceTimeMs) override;
+
+        /**
+         * @brief Get the number of edges suppressed by the software debounce of a pin
+         * @param pin The GPIO pin number
+         * @return The suppressed bounce count
+         */
+        [[nodiscard]] uint64_t getSuppressedBounceCount(uint8_t pin) const;
+
+        /**
+         * @brief Set the scheduling priority of the interrupt dispatch thread
+         * @param priority 0 for SCHED_OTHER, otherwise the SCHED_FIFO priority
+         * @return A true if the priority is valid and was applied, false otherwise
+         */
+        bool setInterruptThreadPriority(int32_t priority) override;
+
+        /**
+         * @brief Pin the interrupt dispatch thread to a CPU
+         * @param cpu The CPU index, -1 to allow all CPUs
+         * @return A true if the affinity is valid and was applied, false otherwise
+         */
+        bool setInterruptThreadAffinity(int32_t cpu) override;
     };
 }
 
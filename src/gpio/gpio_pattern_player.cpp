@@ -0,0 +1,222 @@
+#include "../../include/hal/gpio_pattern_player.h"
+#include "../thread_config/thread_config.h"
+#include "../monotonic_clock/monotonic_clock.h"
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <system_error>
+
+using namespace mex_hal;
+
+namespace
+{
+    // Longest single sleep, bounds the latency of stop() during long gaps
+    constexpr uint64_t STOP_POLL_NS = 10000000;
+}
+
+GPIOPatternPlayer::GPIOPatternPlayer(GPIOInterface& gpio) : gpio_(gpio)
+{
+}
+
+GPIOPatternPlayer::~GPIOPatternPlayer()
+{
+    stop();
+}
+
+bool GPIOPatternPlayer::load(std::vector<GPIOPatternStep> steps, const uint64_t cycleNs)
+{
+    if (steps.empty()) return false;
+
+    for (size_t i = 1; i < steps.size(); ++i)
+    {
+        if (steps[i].timeOffsetNs < steps[i - 1].timeOffsetNs) return false;
+    }
+
+    const uint64_t lastOffsetNs = steps.back().timeOffsetNs;
+    if (cycleNs != 0 && cycleNs < lastOffsetNs) return false;
+
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    if (running_.load(std::memory_order_acquire)) return false;
+
+    if (thread_.joinable()) thread_.join();
+
+    counters_ = std::make_unique<StepCounters[]>(steps.size());
+    steps_ = std::move(steps);
+    cycleNs_ = cycleNs != 0 ? cycleNs : lastOffsetNs;
+    return true;
+}
+
+bool GPIOPatternPlayer::start(const bool loop)
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    if (steps_.empty() || running_.load(std::memory_order_acquire)) return false;
+
+    // A zero-length cycle would replay the pattern without ever sleeping
+    if (loop && cycleNs_ == 0) return false;
+
+    if (thread_.joinable()) thread_.join();
+
+    // Counters are only reset while no player thread exists
+    for (size_t i = 0; i < steps_.size(); ++i)
+    {
+        counters_[i].plays.store(0, std::memory_order_relaxed);
+        counters_[i].totalLatenessNs.store(0, std::memory_order_relaxed);
+        counters_[i].maxLatenessNs.store(0, std::memory_order_relaxed);
+    }
+    cycles_.store(0, std::memory_order_relaxed);
+    writeErrors_.store(0, std::memory_order_relaxed);
+
+    loop_ = loop;
+    stopRequested_.store(false, std::memory_order_release);
+    running_.store(true, std::memory_order_release);
+
+    try
+    {
+        thread_ = std::thread(&GPIOPatternPlayer::playLoop, this, monotonicNs());
+    }
+    catch (const std::system_error&)
+    {
+        running_.store(false, std::memory_order_release);
+        return false;
+    }
+
+    ThreadConfig::apply(thread_.native_handle(), ThreadSchedule{priority_, cpu_});
+    return true;
+}
+
+bool GPIOPatternPlayer::stop()
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    const bool wasRunning = running_.load(std::memory_order_acquire);
+
+    stopRequested_.store(true, std::memory_order_release);
+    if (thread_.joinable()) thread_.join();
+
+    return wasRunning;
+}
+
+bool GPIOPatternPlayer::isRunning() const
+{
+    return running_.load(std::memory_order_acquire);
+}
+
+bool GPIOPatternPlayer::setThreadPriority(const int32_t priority)
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    if (!ThreadConfig::isValid(ThreadSchedule{priority, cpu_})) return false;
+
+    priority_ = priority;
+    return !thread_.joinable() || ThreadConfig::applyPriority(thread_.native_handle(), priority_);
+}
+
+bool GPIOPatternPlayer::setThreadAffinity(const int32_t cpu)
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    if (!ThreadConfig::isValid(ThreadSchedule{priority_, cpu})) return false;
+
+    cpu_ = cpu;
+    return !thread_.joinable() || ThreadConfig::applyAffinity(thread_.native_handle(), cpu_);
+}
+
+GPIOPatternStats GPIOPatternPlayer::getStats() const
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    GPIOPatternStats stats;
+    stats.cycles = cycles_.load(std::memory_order_relaxed);
+    stats.writeErrors = writeErrors_.load(std::memory_order_relaxed);
+
+    uint64_t totalLatenessNs = 0;
+    for (size_t i = 0; i < steps_.size(); ++i)
+    {
+        stats.steps += counters_[i].plays.load(std::memory_order_relaxed);
+        totalLatenessNs += counters_[i].totalLatenessNs.load(std::memory_order_relaxed);
+        stats.maxLatenessNs = std::max(stats.maxLatenessNs, counters_[i].maxLatenessNs.load(std::memory_order_relaxed));
+    }
+    if (stats.steps != 0) stats.meanLatenessNs = totalLatenessNs / stats.steps;
+
+    return stats;
+}
+
+GPIOPatternStepStats GPIOPatternPlayer::getStepStats(const size_t index) const
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+
+    GPIOPatternStepStats stats;
+    if (index >= steps_.size()) return stats;
+
+    const StepCounters& counters = counters_[index];
+    stats.plays = counters.plays.load(std::memory_order_relaxed);
+    stats.maxLatenessNs = counters.maxLatenessNs.load(std::memory_order_relaxed);
+    if (stats.plays != 0)
+    {
+        stats.meanLatenessNs = counters.totalLatenessNs.load(std::memory_order_relaxed) / stats.plays;
+    }
+
+    return stats;
+}
+
+bool GPIOPatternPlayer::sleepUntil(const uint64_t deadlineNs) const
+{
+    while (!stopRequested_.load(std::memory_order_acquire))
+    {
+        const uint64_t nowNs = monotonicNs();
+        if (nowNs >= deadlineNs) return true;
+
+        const uint64_t wakeNs = std::min(deadlineNs, nowNs + STOP_POLL_NS);
+        timespec wake{};
+        wake.tv_sec = static_cast<time_t>(wakeNs / 1000000000ULL);
+        wake.tv_nsec = static_cast<long>(wakeNs % 1000000000ULL);
+
+        // Absolute deadline, a wakeup after EINTR resumes without drift
+        const int result = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr);
+        if (result != 0 && result != EINTR) return false;
+    }
+
+    return false;
+}
+
+void GPIOPatternPlayer::playLoop(const uint64_t startNs)
+{
+    // The pattern is immutable while running_ is set, no lock is taken per step
+    uint64_t cycleStartNs = startNs;
+    bool playing = true;
+
+    while (playing)
+    {
+        for (size_t i = 0; i < steps_.size(); ++i)
+        {
+            const GPIOPatternStep& step = steps_[i];
+            const uint64_t deadlineNs = cycleStartNs + step.timeOffsetNs;
+            if (!sleepUntil(deadlineNs))
+            {
+                playing = false;
+                break;
+            }
+
+            if (!gpio_.writeMask(step.mask, step.values))
+            {
+                writeErrors_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            const uint64_t nowNs = monotonicNs();
+            const uint64_t latenessNs = nowNs > deadlineNs ? nowNs - deadlineNs : 0;
+
+            StepCounters& counters = counters_[i];
+            counters.plays.fetch_add(1, std::memory_order_relaxed);
+            counters.totalLatenessNs.fetch_add(latenessNs, std::memory_order_relaxed);
+            if (latenessNs > counters.maxLatenessNs.load(std::memory_order_relaxed))
+            {
+                counters.maxLatenessNs.store(latenessNs, std::memory_order_relaxed);
+            }
+        }
+
+        if (!playing) break;
+
+        cycles_.fetch_add(1, std::memory_order_relaxed);
+        playing = loop_;
+        cycleStartNs += cycleNs_;
+    }
+
+    running_.store(false, std::memory_order_release);
+}
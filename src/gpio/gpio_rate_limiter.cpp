@@ -0,0 +1,185 @@
+#include "gpio_rate_limiter.h"
+#include <algorithm>
+
+using namespace mex_hal;
+
+void GPIORateLimiter::configure(const uint8_t pin, const EdgeRateLimit& limit)
+{
+    PinState& state = states_[pin];
+    state = PinState{};
+    state.limit = limit;
+    state.windowNs = static_cast<uint64_t>(limit.windowMs) * 1000000ULL;
+    state.rearmNs = limit.rearmMs != 0 ? static_cast<uint64_t>(limit.rearmMs) * 1000000ULL : state.windowNs;
+    pendingPins_.reset(pin);
+}
+
+bool GPIORateLimiter::isEnabled(const uint8_t pin) const
+{
+    return states_[pin].limit.maxEvents != 0 && states_[pin].windowNs != 0;
+}
+
+bool GPIORateLimiter::isDisabled(const uint8_t pin) const
+{
+    return states_[pin].disabled;
+}
+
+void GPIORateLimiter::suppress(PinState& state, const PinValue value, const uint64_t timestampNs)
+{
+    if (state.limit.mode == EdgeRateMode::COALESCE)
+    {
+        ++state.stats.coalesced;
+        ++state.unseen;
+        state.pending = true;
+        state.pendingValue = value;
+        state.pendingNs = timestampNs;
+    }
+    else
+    {
+        ++state.stats.dropped;
+    }
+}
+
+GPIORateLimiter::Verdict GPIORateLimiter::onEdge(const uint8_t pin, const PinValue value,
+                                                 const uint64_t timestampNs, uint64_t& deadlineNs)
+{
+    PinState& state = states_[pin];
+    deadlineNs = NO_DEADLINE;
+
+    // Edges that were already queued when detection was turned off, the re-arm deadline is pending
+    if (state.disabled)
+    {
+        suppress(state, value, timestampNs);
+        return Verdict::SUPPRESS;
+    }
+
+    // Close the current window, a window within the limit or a quiet window ends the storm
+    if (state.windowOpen && timestampNs >= state.windowStartNs + state.windowNs)
+    {
+        if (state.windowCount <= state.limit.maxEvents || timestampNs >= state.windowStartNs + 2 * state.windowNs)
+        {
+            state.storming = false;
+        }
+        state.windowOpen = false;
+
+        // This edge is newer than a coalesced value whose flush has not run yet
+        if (state.pending)
+        {
+            state.pending = false;
+            pendingPins_.reset(pin);
+        }
+    }
+
+    if (!state.windowOpen)
+    {
+        state.windowOpen = true;
+        state.windowStartNs = timestampNs;
+        state.windowCount = 0;
+    }
+
+    if (++state.windowCount <= state.limit.maxEvents)
+    {
+        state.delivered = true;
+        state.lastValue = value;
+        return Verdict::DELIVER;
+    }
+
+    if (!state.storming)
+    {
+        state.storming = true;
+        ++state.stats.storms;
+    }
+    suppress(state, value, timestampNs);
+
+    if (state.limit.disableDuringStorm)
+    {
+        state.disabled = true;
+        state.deadlineNs = timestampNs + state.rearmNs;
+        pendingPins_.set(pin);
+        deadlineNs = state.deadlineNs;
+        return Verdict::DISABLE;
+    }
+
+    if (state.pending)
+    {
+        state.deadlineNs = state.windowStartNs + state.windowNs;
+        pendingPins_.set(pin);
+        deadlineNs = state.deadlineNs;
+    }
+
+    return Verdict::SUPPRESS;
+}
+
+bool GPIORateLimiter::onRearm(const uint8_t pin, const PinValue value)
+{
+    PinState& state = states_[pin];
+    if (state.delivered && state.lastValue == value)
+    {
+        return false;
+    }
+
+    state.delivered = true;
+    state.lastValue = value;
+    return true;
+}
+
+uint64_t GPIORateLimiter::settle(const uint64_t nowNs, std::vector<GPIOEdgeEvent>& flushed, PinMask& rearm)
+{
+    uint64_t nextDeadline = NO_DEADLINE;
+
+    for (size_t pin = 0; pin < states_.size(); ++pin)
+    {
+        if (!pendingPins_.test(pin)) continue;
+
+        PinState& state = states_[pin];
+        if (state.deadlineNs > nowNs)
+        {
+            nextDeadline = std::min(nextDeadline, state.deadlineNs);
+            continue;
+        }
+        pendingPins_.reset(pin);
+
+        // The owner reads the current level after re-arming, a held value would be stale
+        if (state.disabled)
+        {
+            state.disabled = false;
+            state.pending = false;
+            state.windowOpen = false;
+            rearm.set(pin);
+            continue;
+        }
+
+        if (!state.pending) continue;
+        state.pending = false;
+
+        // A burst that ended on the delivered level changes nothing
+        if (state.delivered && state.pendingValue == state.lastValue) continue;
+
+        state.delivered = true;
+        state.lastValue = state.pendingValue;
+        GPIOEdgeEvent event;
+        event.pin = static_cast<uint8_t>(pin);
+        event.value = state.pendingValue;
+        event.timestampNs = state.pendingNs;
+        event.coalesced = state.unseen - 1;
+        state.unseen = 0;
+        flushed.push_back(event);
+    }
+
+    return nextDeadline;
+}
+
+uint32_t GPIORateLimiter::takeCoalesced(const uint8_t pin)
+{
+    const uint32_t coalesced = states_[pin].unseen;
+    states_[pin].unseen = 0;
+    return coalesced;
+}
+
+EdgeRateStats GPIORateLimiter::getStats(const uint8_t pin) const
+{
+    const PinState& state = states_[pin];
+    EdgeRateStats stats = state.stats;
+    stats.stormActive = state.storming || state.disabled;
+    stats.disabled = state.disabled;
+    return stats;
+}
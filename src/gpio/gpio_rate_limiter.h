@@ -0,0 +1,141 @@
+#ifndef MEX_HAL_GPIO_RATE_LIMITER_H
+#define MEX_HAL_GPIO_RATE_LIMITER_H
+
+#include "../../include/hal/gpio_event_queue.h"
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief Per-pin edge rate limiter for GPIO interrupts
+     *
+     * Edges are counted in windows that open with the first edge after the previous
+     * window ended. Up to maxEvents edges per window are delivered; the rest are
+     * dropped or, in COALESCE mode, folded into one delivery of the latest value when
+     * the window closes. The first overflowing window after a quiet one starts a storm.
+     * With disableDuringStorm the owner turns edge detection off until the re-arm
+     * deadline and then reports the current level through onRearm().
+     * The owner drives settle() from a single timer armed for the returned deadlines.
+     * Not thread-safe, the owner serializes access.
+     */
+    class GPIORateLimiter
+    {
+    public:
+        static constexpr uint64_t NO_DEADLINE = std::numeric_limits<uint64_t>::max();
+
+        /// @brief Outcome of a raw edge \enum Verdict
+        enum class Verdict
+        {
+            DELIVER,    // pass the edge on
+            SUPPRESS,   // edge dropped or held for coalescing
+            DISABLE     // suppressed and a storm started, turn edge detection off
+        };
+
+        /**
+         * @brief Set the rate limit of a pin and reset its state and counters
+         * @param pin The GPIO pin number
+         * @param limit The limit, a zero maxEvents or windowMs disables limiting
+         */
+        void configure(uint8_t pin, const EdgeRateLimit& limit);
+
+        /**
+         * @brief Check whether a pin is rate limited
+         * @param pin The GPIO pin number
+         * @return A true if edges of the pin go through the limiter, false otherwise
+         */
+        [[nodiscard]] bool isEnabled(uint8_t pin) const;
+
+        /**
+         * @brief Check whether edge detection of a pin is off because of a storm
+         * @param pin The GPIO pin number
+         * @return A true until the re-arm deadline passed, false otherwise
+         */
+        [[nodiscard]] bool isDisabled(uint8_t pin) const;
+
+        /**
+         * @brief Record a raw edge of a rate limited pin
+         * @param pin The GPIO pin number
+         * @param value The pin value after the edge
+         * @param timestampNs The CLOCK_MONOTONIC timestamp of the edge in nanoseconds
+         * @param deadlineNs Receives the deadline at which settle() must run, NO_DEADLINE if none
+         * @return The verdict for this edge
+         */
+        Verdict onEdge(uint8_t pin, PinValue value, uint64_t timestampNs, uint64_t& deadlineNs);
+
+        /**
+         * @brief Report the level of a pin read right after edge detection was re-armed
+         * @param pin The GPIO pin number
+         * @param value The current pin value
+         * @return A true if the level changed while disabled and should be delivered, false otherwise
+         */
+        bool onRearm(uint8_t pin, PinValue value);
+
+        /**
+         * @brief Take the coalesced edges of a pin that no delivery has accounted for yet
+         * @param pin The GPIO pin number
+         * @return The count to report with the next event of the pin, the counter is reset
+         */
+        uint32_t takeCoalesced(uint8_t pin);
+
+        /**
+         * @brief Flush closed coalescing windows and re-arm pins whose storm pause elapsed
+         * @param nowNs The current CLOCK_MONOTONIC time in nanoseconds
+         * @param flushed Receives one event per coalesced window whose latest value changed the level,
+         *                its coalesced field counts the folded edges before the latest one
+         * @param rearm Receives the pins whose edge detection must be turned back on
+         * @return The earliest remaining deadline, NO_DEADLINE if nothing is pending
+         */
+        uint64_t settle(uint64_t nowNs, std::vector<GPIOEdgeEvent>& flushed, PinMask& rearm);
+
+        /**
+         * @brief Get the rate limit counters of a pin
+         * @param pin The GPIO pin number
+         * @return The counters since the last configure()
+         */
+        [[nodiscard]] EdgeRateStats getStats(uint8_t pin) const;
+
+    private:
+        /// @brief Rate limit state of one pin \struct PinState
+        struct PinState
+        {
+            EdgeRateLimit limit;
+            uint64_t windowNs = 0;
+            uint64_t rearmNs = 0;
+
+            bool windowOpen = false;
+            uint64_t windowStartNs = 0;
+            uint32_t windowCount = 0;
+
+            bool storming = false;
+            bool disabled = false;
+
+            bool pending = false;
+            uint32_t unseen = 0;    // coalesced edges not yet reported with a delivery
+            PinValue pendingValue = PinValue::LOW;
+            uint64_t pendingNs = 0;
+            uint64_t deadlineNs = 0;
+
+            bool delivered = false;
+            PinValue lastValue = PinValue::LOW;
+
+            EdgeRateStats stats;
+        };
+
+        /**
+         * @brief Account for an edge that is not delivered on its own
+         * @param state The pin state
+         * @param value The pin value after the edge
+         * @param timestampNs The timestamp of the edge in nanoseconds
+         */
+        static void suppress(PinState& state, PinValue value, uint64_t timestampNs);
+
+        std::array<PinState, 256> states_{};
+        PinMask pendingPins_;
+    };
+}
+
+#endif //MEX_HAL_GPIO_RATE_LIMITER_H
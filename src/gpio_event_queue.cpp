@@ -0,0 +1,110 @@
+#include "../include/hal/gpio_event_queue.h"
+
+using namespace mex_hal;
+
+GPIOEventQueue::GPIOEventQueue(const size_t capacity)
+{
+    size_t slots = 2;
+    while (slots < capacity)
+    {
+        slots <<= 1;
+    }
+
+    cells_ = std::make_unique<Cell[]>(slots);
+    mask_ = slots - 1;
+
+    // Slot i is free for the producer at position i
+    for (size_t i = 0; i < slots; ++i)
+    {
+        cells_[i].turn.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool GPIOEventQueue::push(const uint8_t pin, const PinValue value, const uint64_t timestampNs,
+                          const uint32_t coalesced) noexcept
+{
+    const uint64_t sequence = sequence_++;
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[tail & mask_];
+
+    // The slot is still owned by the previous lap until a consumer has copied it out
+    if (cell.turn.load(std::memory_order_acquire) != tail)
+    {
+        overflowCount_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    cell.event.pin = pin;
+    cell.event.value = value;
+    cell.event.timestampNs = timestampNs;
+    cell.event.sequence = sequence;
+    cell.event.coalesced = coalesced;
+    cell.turn.store(tail + 1, std::memory_order_release);
+    tail_.store(tail + 1, std::memory_order_relaxed);
+
+    return true;
+}
+
+size_t GPIOEventQueue::drain(GPIOEdgeEvent* events, const size_t maxEvents) noexcept
+{
+    if (events == nullptr || maxEvents == 0)
+    {
+        return 0;
+    }
+
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    size_t count;
+
+    // Claim a run of published slots with a single CAS
+    for (;;)
+    {
+        count = 0;
+        while (count < maxEvents && count <= mask_ &&
+               cells_[(head + count) & mask_].turn.load(std::memory_order_acquire) == head + count + 1)
+        {
+            ++count;
+        }
+
+        if (count == 0)
+        {
+            return 0;
+        }
+
+        if (head_.compare_exchange_weak(head, head + count, std::memory_order_relaxed))
+        {
+            break;
+        }
+    }
+
+    // Hand every slot back to the producer for its next lap
+    for (size_t i = 0; i < count; ++i)
+    {
+        Cell& cell = cells_[(head + i) & mask_];
+        events[i] = cell.event;
+        cell.turn.store(head + i + mask_ + 1, std::memory_order_release);
+    }
+
+    return count;
+}
+
+bool GPIOEventQueue::pop(GPIOEdgeEvent& event) noexcept
+{
+    return drain(&event, 1) == 1;
+}
+
+size_t GPIOEventQueue::size() const noexcept
+{
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    return tail > head ? static_cast<size_t>(tail - head) : 0;
+}
+
+size_t GPIOEventQueue::capacity() const noexcept
+{
+    return mask_ + 1;
+}
+
+uint64_t GPIOEventQueue::getOverflowCount() const noexcept
+{
+    return overflowCount_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,293 @@
+#include "i2c_bitbang.h"
+#include "../../include/hal/callback_manager.h"
+#include "../monotonic_clock/monotonic_clock.h"
+
+using namespace mex_hal;
+
+namespace
+{
+    // A slave stuck mid-byte releases SDA within nine clocks
+    constexpr int RECOVERY_CLOCKS = 9;
+}
+
+I2CBitBang::I2CBitBang(std::shared_ptr<GPIOInterface> gpio, const SoftI2CPins& pins)
+    : gpio_(std::move(gpio)), pins_(pins)
+{
+    clock_.setFrequency(DEFAULT_SPEED_HZ);
+}
+
+I2CBitBang::~I2CBitBang()
+{
+    std::lock_guard<std::mutex> lock(i2cMutex_);
+
+    if (resourceId_ != 0)
+    {
+        ResourceManager::getInstance().setInUse(resourceId_, false);
+        ResourceManager::getInstance().unregisterResource(resourceId_);
+        resourceId_ = 0;
+    }
+}
+
+void I2CBitBang::setScl(const bool high)
+{
+    if (!gpio_->setDirection(pins_.scl, high ? PinDirection::INPUT : PinDirection::OUTPUT))
+    {
+        lineError_ = true;
+        return;
+    }
+    sclHigh_ = high;
+
+    if (!high || pins_.stretchTimeoutUs == 0) return;
+    if (gpio_->read(pins_.scl) == PinValue::HIGH) return;
+
+    // The slave stretches the clock, the high phase starts once it lets go
+    const uint64_t deadlineNs = monotonicNs() + static_cast<uint64_t>(pins_.stretchTimeoutUs) * 1000ULL;
+    while (gpio_->read(pins_.scl) == PinValue::LOW)
+    {
+        if (monotonicNs() >= deadlineNs)
+        {
+            lineError_ = true;
+            return;
+        }
+    }
+    clock_.start();
+}
+
+void I2CBitBang::setSda(const bool high)
+{
+    if (high == sdaHigh_) return;
+
+    if (!gpio_->setDirection(pins_.sda, high ? PinDirection::INPUT : PinDirection::OUTPUT))
+    {
+        lineError_ = true;
+        return;
+    }
+    sdaHigh_ = high;
+}
+
+void I2CBitBang::start()
+{
+    // Repeated START, SDA goes high during the low phase and SCL follows
+    if (!sclHigh_)
+    {
+        setSda(true);
+        clock_.waitHalfPeriod();
+        setScl(true);
+        clock_.waitHalfPeriod();
+    }
+
+    setSda(false);
+    clock_.waitHalfPeriod();
+    setScl(false);
+}
+
+void I2CBitBang::stop()
+{
+    setSda(false);
+    clock_.waitHalfPeriod();
+    setScl(true);
+    clock_.waitHalfPeriod();
+    setSda(true);
+    clock_.waitHalfPeriod();
+}
+
+void I2CBitBang::writeBit(const bool bit)
+{
+    setSda(bit);
+    clock_.waitHalfPeriod();
+    setScl(true);
+    clock_.waitHalfPeriod();
+    setScl(false);
+}
+
+bool I2CBitBang::readBit()
+{
+    setSda(true);
+    clock_.waitHalfPeriod();
+    setScl(true);
+    clock_.waitHalfPeriod();
+    const bool bit = gpio_->read(pins_.sda) == PinValue::HIGH;
+    setScl(false);
+    return bit;
+}
+
+bool I2CBitBang::writeByte(const uint8_t byte)
+{
+    for (int bit = 7; bit >= 0 && !lineError_; --bit)
+    {
+        writeBit(((byte >> bit) & 1) != 0);
+    }
+
+    // The slave pulls SDA low to acknowledge
+    return !readBit() && !lineError_;
+}
+
+uint8_t I2CBitBang::readByte(const bool ack)
+{
+    uint8_t byte = 0;
+    for (int bit = 7; bit >= 0 && !lineError_; --bit)
+    {
+        if (readBit()) byte |= static_cast<uint8_t>(1u << bit);
+    }
+
+    writeBit(!ack);
+    return byte;
+}
+
+bool I2CBitBang::transaction(const uint8_t address, const std::vector<uint8_t>* writeData,
+                             std::vector<uint8_t>* readData, const size_t readLength)
+{
+    lineError_ = false;
+    clock_.start();
+    start();
+
+    bool acked = true;
+    if (writeData != nullptr)
+    {
+        acked = writeByte(static_cast<uint8_t>(address << 1));
+        for (size_t i = 0; i < writeData->size() && acked; ++i)
+        {
+            acked = writeByte((*writeData)[i]);
+        }
+    }
+
+    if (readData != nullptr && acked)
+    {
+        if (writeData != nullptr) start();
+
+        readData->assign(readLength, 0);
+        acked = writeByte(static_cast<uint8_t>(address << 1 | 1));
+        for (size_t i = 0; i < readLength && acked && !lineError_; ++i)
+        {
+            (*readData)[i] = readByte(i + 1 < readLength);
+        }
+    }
+
+    // A NACK or a line error still ends with STOP so the bus is left idle
+    stop();
+    return acked && !lineError_;
+}
+
+bool I2CBitBang::init(uint8_t /*bus*/)
+{
+    std::lock_guard<std::mutex> lock(i2cMutex_);
+
+    if (gpio_ == nullptr || pins_.scl == pins_.sda) return false;
+
+    lineError_ = false;
+    if (!gpio_->setDirection(pins_.scl, PinDirection::INPUT)) return false;
+    if (!gpio_->setDirection(pins_.sda, PinDirection::INPUT)) return false;
+    sclHigh_ = true;
+    sdaHigh_ = true;
+
+    // A slave interrupted mid-read still drives SDA, clock it out and end with STOP
+    if (gpio_->read(pins_.sda) == PinValue::LOW)
+    {
+        clock_.start();
+        for (int i = 0; i < RECOVERY_CLOCKS && gpio_->read(pins_.sda) == PinValue::LOW; ++i)
+        {
+            setScl(false);
+            clock_.waitHalfPeriod();
+            setScl(true);
+            clock_.waitHalfPeriod();
+        }
+        setScl(false);
+        clock_.waitHalfPeriod();
+        stop();
+        if (lineError_ || gpio_->read(pins_.sda) == PinValue::LOW) return false;
+    }
+
+    if (resourceId_ == 0)
+    {
+        // The bus is torn down before the pins it drives
+        std::vector<uint64_t> pinIds;
+        for (const uint8_t pin : {pins_.scl, pins_.sda})
+        {
+            if (const uint64_t pinId = gpio_->getResourceId(pin); pinId != 0) pinIds.push_back(pinId);
+        }
+
+        resourceId_ = ResourceManager::getInstance().registerResource(
+            ResourceType::I2C_BUS,
+            "gpio-i2c:" + std::to_string(pins_.scl) + "," + std::to_string(pins_.sda),
+            gpio_.get(),
+            pinIds
+        );
+    }
+    ResourceManager::getInstance().setInUse(resourceId_, true);
+
+    initialized_ = true;
+    return true;
+}
+
+bool I2CBitBang::setDeviceAddress(const uint8_t address)
+{
+    std::lock_guard<std::mutex> lock(i2cMutex_);
+
+    if (!initialized_ || address > 0x7F) return false;
+    currentAddress_ = address;
+    return true;
+}
+
+bool I2CBitBang::finishTransfer(std::unique_lock<std::mutex>& lock, const bool result, const uint8_t address,
+                                const size_t length) const
+{
+    const uint64_t resourceId = resourceId_;
+    lock.unlock();
+
+    CallbackManager::getInstance().publishEvent(ResourceType::I2C_BUS, resourceId,
+                                                result ? HALEventKind::TRANSFER_COMPLETE : HALEventKind::IO_ERROR,
+                                                length, address);
+    return result;
+}
+
+bool I2CBitBang::write(const std::vector<uint8_t>& data)
+{
+    std::unique_lock<std::mutex> lock(i2cMutex_);
+
+    if (!initialized_ || currentAddress_ == 0) return false;
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = transaction(currentAddress_, &data, nullptr, 0);
+    timer.finish(result ? data.size() : 0, result);
+    return finishTransfer(lock, result, currentAddress_, data.size());
+}
+
+bool I2CBitBang::read(std::vector<uint8_t>& data, const size_t length)
+{
+    std::unique_lock<std::mutex> lock(i2cMutex_);
+
+    if (!initialized_ || currentAddress_ == 0 || length == 0) return false;
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = transaction(currentAddress_, nullptr, &data, length);
+    timer.finish(result ? length : 0, result);
+    return finishTransfer(lock, result, currentAddress_, length);
+}
+
+bool I2CBitBang::writeRead(const uint8_t address, const std::vector<uint8_t>& writeData, std::vector<uint8_t>& readData)
+{
+    std::unique_lock<std::mutex> lock(i2cMutex_);
+
+    if (!initialized_ || address == 0 || address > 0x7F) return false;
+    currentAddress_ = address;
+
+    const size_t readLength = readData.empty() ? writeData.size() : readData.size();
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = readLength == 0 ? transaction(address, &writeData, nullptr, 0)
+                                        : transaction(address, &writeData, &readData, readLength);
+    timer.finish(result ? writeData.size() + readLength : 0, result);
+    return finishTransfer(lock, result, address, writeData.size() + readLength);
+}
+
+bool I2CBitBang::setSpeed(const uint32_t speed)
+{
+    std::lock_guard<std::mutex> lock(i2cMutex_);
+
+    if (!initialized_) return false;
+    clock_.setFrequency(speed);
+    return true;
+}
+
+uint64_t I2CBitBang::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(i2cMutex_);
+    return resourceId_;
+}
@@ -0,0 +1,177 @@
+#ifndef MEX_HAL_I2C_BITBANG_H
+#define MEX_HAL_I2C_BITBANG_H
+
+#include "../../include/hal/i2c.h"
+#include "../../include/hal/gpio.h"
+#include "../../include/hal/resource_manager.h"
+#include "../bitbang_clock/bitbang_clock.h"
+#include <memory>
+#include <mutex>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief I2C master bit-banged on GPIO lines \class I2CBitBang
+     *
+     * Both lines are driven open-drain: a released line is switched to input and
+     * pulled up externally, a low line is switched to output, which both GPIO
+     * backends drive low. Each level change is therefore one direction change, a
+     * single write to the persistent sysfs direction fd or one SET_CONFIG ioctl on
+     * the character device, and SDA is only touched when its level changes. Unlike
+     * SPI, SDA must never move together with SCL, so a bit costs up to three calls.
+     * After releasing SCL it is read back to honour clock stretching unless the
+     * stretch timeout is 0. writeRead() uses a repeated START.
+     */
+    class I2CBitBang final : public I2CInterface
+    {
+    private:
+        static constexpr uint32_t DEFAULT_SPEED_HZ = 100000;
+
+        std::shared_ptr<GPIOInterface> gpio_;
+        SoftI2CPins pins_;
+        BitBangClock clock_;
+        uint8_t currentAddress_ = 0;
+        bool sclHigh_ = true;
+        bool sdaHigh_ = true;
+        bool lineError_ = false;
+        bool initialized_ = false;
+        uint64_t resourceId_ = 0;
+        mutable std::mutex i2cMutex_;
+
+        /**
+         * @brief Release SCL or pull it low, a released SCL waits for clock stretching
+         * @param high A true to release the line, false to pull it low
+         */
+        void setScl(bool high);
+
+        /**
+         * @brief Release SDA or pull it low, nothing is written if the level is unchanged
+         * @param high A true to release the line, false to pull it low
+         */
+        void setSda(bool high);
+
+        /**
+         * @brief Generate a START, or a repeated START while SCL is low
+         */
+        void start();
+
+        /**
+         * @brief Generate a STOP, leaves both lines released
+         */
+        void stop();
+
+        /**
+         * @brief Clock one bit out
+         * @param bit The bit value
+         */
+        void writeBit(bool bit);
+
+        /**
+         * @brief Clock one bit in with SDA released
+         * @return The sampled bit
+         */
+        bool readBit();
+
+        /**
+         * @brief Clock a byte out and read the acknowledge bit
+         * @param byte The byte value
+         * @return A true if the slave acknowledged, false otherwise
+         */
+        bool writeByte(uint8_t byte);
+
+        /**
+         * @brief Clock a byte in and answer it
+         * @param ack A true to acknowledge, false to NACK the last byte
+         * @return The received byte
+         */
+        uint8_t readByte(bool ack);
+
+        /**
+         * @brief Run one bus transaction, a write phase followed by a read phase
+         * @param address The 7-bit slave address
+         * @param writeData The bytes to write, nullptr for a pure read
+         * @param readData The buffer for the read phase, nullptr for a pure write
+         * @param readLength The number of bytes to read
+         * @return A true if every byte was acknowledged and all GPIO calls succeeded, false otherwise
+         */
+        bool transaction(uint8_t address, const std::vector<uint8_t>* writeData,
+                         std::vector<uint8_t>* readData, size_t readLength);
+
+        /**
+         * @brief Release the bus lock and publish the outcome of a transfer on the event bus
+         * @param lock The held bus lock
+         * @param result The transfer result
+         * @param address The 7-bit slave address
+         * @param length The number of bytes transferred
+         * @return The transfer result
+         */
+        bool finishTransfer(std::unique_lock<std::mutex>& lock, bool result, uint8_t address, size_t length) const;
+
+    public:
+        /**
+         * @brief Constructor
+         * @param gpio The GPIO controller driving the lines, may be shared with other users
+         * @param pins The SCL and SDA lines and the clock stretch timeout
+         */
+        I2CBitBang(std::shared_ptr<GPIOInterface> gpio, const SoftI2CPins& pins);
+
+        /**
+         * @brief Destructor
+         */
+        ~I2CBitBang() override;
+
+        /**
+         * @brief Release both lines and clock out a slave that holds SDA low
+         * @param bus Ignored, the bus is defined by the GPIO lines
+         * @return A true if initialization was successful, false otherwise
+         */
+        bool init(uint8_t bus) override;
+
+        /**
+         * @brief Set the I2C device address
+         * @param address The 7-bit I2C device address
+         * @return A true if the address was successfully set, false otherwise
+         */
+        bool setDeviceAddress(uint8_t address) override;
+
+        /**
+         * @brief Write data to the I2C device
+         * @param data The data to write
+         * @return A true if the data was successfully written, false otherwise
+         */
+        bool write(const std::vector<uint8_t>& data) override;
+
+        /**
+         * @brief Read data from the I2C device
+         * @param data The buffer to store read data
+         * @param length The number of bytes to read
+         * @return A true if the data was successfully read, false otherwise
+         */
+        bool read(std::vector<uint8_t>& data, size_t length) override;
+
+        /**
+         * @brief Write and then read data with a repeated START in between
+         * @param address The I2C device address, also becomes the current address
+         * @param writeData The data to write
+         * @param readData The buffer to store read data, its size is the read length or the write length if empty
+         * @return A true if the operation was successful, false otherwise
+         */
+        bool writeRead(uint8_t address, const std::vector<uint8_t>& writeData, std::vector<uint8_t>& readData) override;
+
+        /**
+         * @brief Set the I2C bus speed
+         * @param speed The bus speed in Hz, 0 for the fastest rate the GPIO backend sustains
+         * @return A true if the speed was successfully set, false otherwise
+         */
+        bool setSpeed(uint32_t speed) override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
+    };
+}
+
+#endif //MEX_HAL_I2C_BITBANG_H
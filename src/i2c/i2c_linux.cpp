@@ -1,4 +1,5 @@
 #include "i2c_linux.h"
+#include "../../include/hal/callback_manager.h"
 
 #include <fstream>
 
@@ -50,22 +51,40 @@ bool I2CLinux::setDeviceAddress(const uint8_t address)
     return true;
 }
 
+bool I2CLinux::finishTransfer(std::unique_lock<std::mutex>& lock, const bool result, const uint8_t address,
+                            const size_t length) const
+{
+    const uint64_t resourceId = resourceId_;
+    lock.unlock();
+
+    CallbackManager::getInstance().publishEvent(ResourceType::I2C_BUS, resourceId,
+                                                result ? HALEventKind::TRANSFER_COMPLETE : HALEventKind::IO_ERROR,
+                                                length, address);
+    return result;
+}
+
 bool I2CLinux::write(const std::vector<uint8_t>& data)
 {
-    std::lock_guard<std::mutex> lock(i2cMutex_);
+    std::unique_lock<std::mutex> lock(i2cMutex_);
 
     if (!fd_.isValid() || currentAddress_ == 0) return false;
-    return ::write(fd_.get(), data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = ::write(fd_.get(), data.data(), data.size()) == static_cast<ssize_t>(data.size());
+    timer.finish(result ? data.size() : 0, result);
+    return finishTransfer(lock, result, currentAddress_, data.size());
 }
 
 bool I2CLinux::read(std::vector<uint8_t>& data, const size_t length)
 {
-    std::lock_guard<std::mutex> lock(i2cMutex_);
+    std::unique_lock<std::mutex> lock(i2cMutex_);
 
     if (!fd_.isValid() || currentAddress_ == 0) return false;
     data.resize(length);
+    const ResourceIoTimer timer(resourceId_);
     const ssize_t bytesRead = ::read(fd_.get(), data.data(), length);
-    return bytesRead == static_cast<ssize_t>(length);
+    const bool result = bytesRead == static_cast<ssize_t>(length);
+    timer.finish(result ? length : 0, result);
+    return finishTransfer(lock, result, currentAddress_, length);
 }
 
 bool I2CLinux::writeRead(const uint8_t address, const std::vector<uint8_t> &writeData, std::vector<uint8_t> &readData)
@@ -88,3 +107,8 @@ bool I2CLinux::setSpeed(const uint32_t speed)
     return true;
 }
 
+uint64_t I2CLinux::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(i2cMutex_);
+    return resourceId_;
+}
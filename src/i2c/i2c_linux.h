@@ -24,6 +24,16 @@ namespace mex_hal
         uint64_t resourceId_ = 0;
         mutable std::mutex i2cMutex_;
 
+        /**
+         * @brief Release the bus lock and publish the outcome of a transfer on the event bus
+         * @param lock The held bus lock
+         * @param result The transfer result
+         * @param address The 7-bit slave address
+         * @param length The number of bytes transferred
+         * @return The transfer result
+         */
+        bool finishTransfer(std::unique_lock<std::mutex>& lock, bool result, uint8_t address, size_t length) const;
+
     public:
         /**
          * @brief Constructor
@@ -79,6 +89,12 @@ namespace mex_hal
          * @return A true if the speed was successfully set, false otherwise
          */
         bool setSpeed(uint32_t speed) override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
     };
 }
 
@@ -0,0 +1,22 @@
+#ifndef MEX_HAL_MONOTONIC_CLOCK_H
+#define MEX_HAL_MONOTONIC_CLOCK_H
+
+#include <cstdint>
+#include <ctime>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief Read CLOCK_MONOTONIC, the time base of edge timestamps, deadlines and profiling
+     * @return The current time in nanoseconds
+     */
+    inline uint64_t monotonicNs() noexcept
+    {
+        timespec now{};
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+    }
+}
+
+#endif //MEX_HAL_MONOTONIC_CLOCK_H
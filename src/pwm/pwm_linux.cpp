@@ -1,6 +1,6 @@
 #include "pwm_linux.h"
-#include <thread>
-#include <chrono>
+#include "../../include/hal/callback_manager.h"
+#include "../sysfs_wait/sysfs_wait.h"
 
 using namespace mex_hal;
 
@@ -35,11 +35,9 @@ bool PWMLinux::exportPWM() const
     if (!exportFile.is_open()) return false;
     exportFile << static_cast<int>(channel_);
     exportFile.close();
-    
-    // Give kernel time to create PWM files
-    std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    
-    return true;
+
+    // Wait for udev to create the channel attributes instead of sleeping a fixed time
+    return SysfsWait::waitForNodes({getBasePath() + "/period", getBasePath() + "/duty_cycle", getBasePath() + "/enable"});
 }
 
 bool PWMLinux::unexportPWM() const
@@ -55,10 +53,16 @@ bool PWMLinux::unexportPWM() const
 bool PWMLinux::writeSysfs(const std::string& attribute, const std::string& value) const
 {
     const std::string path = getBasePath() + "/" + attribute;
+    const ResourceIoTimer timer(resourceId_);
     std::ofstream file(path);
-    if (!file.is_open()) return false;
+    if (!file.is_open())
+    {
+        timer.finish(0, false);
+        return false;
+    }
     file << value;
     file.close();
+    timer.finish(value.size(), true);
     return true;
 }
 
@@ -98,21 +102,33 @@ bool PWMLinux::init(const uint8_t chipNum, const uint8_t channelNum)
     return true;
 }
 
+bool PWMLinux::finishChange(std::unique_lock<std::mutex>& lock, const bool result) const
+{
+    const uint64_t resourceId = resourceId_;
+    const uint8_t channel = channel_;
+    lock.unlock();
+
+    CallbackManager::getInstance().publishEvent(ResourceType::PWM_CHANNEL, resourceId,
+                                                result ? HALEventKind::OUTPUT_CHANGED : HALEventKind::IO_ERROR,
+                                                dutyCycleNs_.load(std::memory_order_acquire), channel);
+    return result;
+}
+
 bool PWMLinux::enable(const bool shouldEnable)
 {
-    std::lock_guard<std::mutex> lock(pwmMutex_);
+    std::unique_lock<std::mutex> lock(pwmMutex_);
 
     if (writeSysfs("enable", shouldEnable ? "1" : "0"))
     {
         enabled_.store(shouldEnable, std::memory_order_release);
-        return true;
+        return finishChange(lock, true);
     }
-    return false;
+    return finishChange(lock, false);
 }
 
 bool PWMLinux::setPeriod(const uint32_t period)
 {
-    std::lock_guard<std::mutex> lock(pwmMutex_);
+    std::unique_lock<std::mutex> lock(pwmMutex_);
 
     const bool wasEnabled = enabled_.load(std::memory_order_acquire);
     if (wasEnabled)
@@ -128,7 +144,7 @@ bool PWMLinux::setPeriod(const uint32_t period)
         {
             writeSysfs("enable", "1");
         }
-        return true;
+        return finishChange(lock, true);
     }
     
     if (wasEnabled)
@@ -136,12 +152,12 @@ bool PWMLinux::setPeriod(const uint32_t period)
         writeSysfs("enable", "1");
     }
     
-    return false;
+    return finishChange(lock, false);
 }
 
 bool PWMLinux::setDutyCycle(const uint32_t dutyCycle)
 {
-    std::lock_guard<std::mutex> lock(pwmMutex_);
+    std::unique_lock<std::mutex> lock(pwmMutex_);
 
     const uint32_t period = periodNs_.load(std::memory_order_acquire);
     if (dutyCycle > period)
@@ -152,9 +168,9 @@ bool PWMLinux::setDutyCycle(const uint32_t dutyCycle)
     if (writeSysfs("duty_cycle", std::to_string(dutyCycle)))
     {
         dutyCycleNs_.store(dutyCycle, std::memory_order_release);
-        return true;
+        return finishChange(lock, true);
     }
-    return false;
+    return finishChange(lock, false);
 }
 
 bool PWMLinux::setDutyCyclePercent(const float percent)
@@ -171,7 +187,7 @@ bool PWMLinux::setDutyCyclePercent(const float percent)
 
 bool PWMLinux::setPolarity(const bool invertPolarity)
 {
-    std::lock_guard<std::mutex> lock(pwmMutex_);
+    std::unique_lock<std::mutex> lock(pwmMutex_);
 
     const bool wasEnabled = enabled_.load(std::memory_order_acquire);
     if (wasEnabled)
@@ -186,7 +202,7 @@ bool PWMLinux::setPolarity(const bool invertPolarity)
         writeSysfs("enable", "1");
     }
     
-    return result;
+    return finishChange(lock, result);
 }
 
 uint32_t PWMLinux::getPeriod() const
@@ -203,3 +219,9 @@ bool PWMLinux::isEnabled() const
 {
     return enabled_.load(std::memory_order_acquire);
 }
+
+uint64_t PWMLinux::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+    return resourceId_;
+}
@@ -24,6 +24,14 @@ namespace mex_hal
         uint64_t resourceId_ = 0;
         mutable std::mutex pwmMutex_;
 
+        /**
+         * @brief Release the channel lock and publish the outcome of a configuration change on the event bus
+         * @param lock The held channel lock
+         * @param result The result of the sysfs writes
+         * @return The result
+         */
+        bool finishChange(std::unique_lock<std::mutex>& lock, bool result) const;
+
         /**
          * @brief Get the base sysfs path for the PWM channel
          * @return A string representing the base path
@@ -128,6 +136,12 @@ namespace mex_hal
          * @return True if enabled, false otherwise
          */
         bool isEnabled() const override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
     };
 }
 
@@ -0,0 +1,447 @@
+#include "../../include/hal/soft_pwm.h"
+#include "../../include/hal/callback_manager.h"
+#include "../../include/hal/resource_manager.h"
+#include "../thread_config/thread_config.h"
+#include "../monotonic_clock/monotonic_clock.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <system_error>
+
+using namespace mex_hal;
+
+namespace
+{
+    PinValue levelOf(const bool active, const bool inverted)
+    {
+        return active != inverted ? PinValue::HIGH : PinValue::LOW;
+    }
+
+    void addJitter(uint64_t& total, uint64_t& max, const uint64_t jitterNs)
+    {
+        total += jitterNs;
+        max = std::max(max, jitterNs);
+    }
+}
+
+SoftPWMScheduler::SoftPWMScheduler(std::shared_ptr<GPIOInterface> gpio) : gpio_(std::move(gpio))
+{
+}
+
+SoftPWMScheduler::~SoftPWMScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    wakeup_.notify_all();
+
+    if (thread_.joinable()) thread_.join();
+}
+
+std::unique_ptr<SoftPWM> SoftPWMScheduler::createChannel()
+{
+    return std::make_unique<SoftPWM>(*this);
+}
+
+bool SoftPWMScheduler::isValidChannel(const int32_t channel) const
+{
+    return channel >= 0 && static_cast<size_t>(channel) < channels_.size() && channels_[channel].used;
+}
+
+int32_t SoftPWMScheduler::addChannel(const uint8_t pin)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (gpio_ == nullptr || claimedPins_.test(pin)) return -1;
+    if (!gpio_->setDirection(pin, PinDirection::OUTPUT)) return -1;
+
+    auto slot = std::find_if(channels_.begin(), channels_.end(), [](const Channel& channel) { return !channel.used; });
+    if (slot == channels_.end()) slot = channels_.insert(channels_.end(), Channel{});
+
+    // The generation survives slot reuse so events of the previous owner stay stale
+    const uint64_t generation = slot->generation + 1;
+    *slot = Channel{};
+    slot->pin = pin;
+    slot->used = true;
+    slot->generation = generation;
+
+    claimedPins_.set(pin);
+    return static_cast<int32_t>(slot - channels_.begin());
+}
+
+void SoftPWMScheduler::removeChannel(const int32_t channel)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!isValidChannel(channel)) return;
+
+    Channel& state = channels_[channel];
+    ++state.generation;
+    state.used = false;
+    state.toggling = false;
+    gpio_->write(state.pin, levelOf(false, state.inverted));
+    claimedPins_.reset(state.pin);
+}
+
+void SoftPWMScheduler::pushEvent(const Event& event)
+{
+    // Latest first, the due edge is popped from the back
+    const auto position = std::upper_bound(events_.begin(), events_.end(), event,
+        [](const Event& lhs, const Event& rhs) { return lhs.deadlineNs > rhs.deadlineNs; });
+    events_.insert(position, event);
+}
+
+bool SoftPWMScheduler::reschedule(const int32_t index, const uint64_t nowNs)
+{
+    Channel& channel = channels_[index];
+    ++channel.generation;
+
+    // Disabled, 0 % and 100 % need no edges, only a level
+    if (!channel.enabled || channel.dutyNs == 0 || channel.dutyNs >= channel.periodNs)
+    {
+        channel.toggling = false;
+        channel.active = channel.enabled && channel.dutyNs != 0;
+        return gpio_->write(channel.pin, levelOf(channel.active, channel.inverted));
+    }
+
+    uint64_t deadlineNs;
+    bool levelWritten = true;
+    if (!channel.toggling)
+    {
+        // Periods start on multiples of the period, channels sharing it share their rising edge write
+        channel.toggling = true;
+        channel.active = false;
+        deadlineNs = (nowNs / channel.periodNs + 1) * channel.periodNs;
+    }
+    else
+    {
+        // Stay on the current period, only the polarity may have changed the line level
+        levelWritten = gpio_->write(channel.pin, levelOf(channel.active, channel.inverted));
+        const uint64_t nextEdgeNs = channel.periodStartNs + (channel.active ? channel.dutyNs : channel.periodNs);
+        deadlineNs = std::max(nextEdgeNs, nowNs);
+    }
+
+    pushEvent(Event{deadlineNs, index, channel.generation});
+    return levelWritten;
+}
+
+bool SoftPWMScheduler::configureChannel(const int32_t channel, const uint32_t periodNs, const uint32_t dutyNs,
+                                        const bool inverted, const bool enabled)
+{
+    if (dutyNs > periodNs) return false;
+    if (enabled && periodNs == 0) return false;
+
+    const bool toggles = enabled && dutyNs != 0 && dutyNs < periodNs;
+    if (toggles && periodNs < MIN_PERIOD_NS) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!isValidChannel(channel)) return false;
+        if (toggles && !ensureThread()) return false;
+
+        Channel& state = channels_[channel];
+        state.periodNs = periodNs;
+        state.dutyNs = dutyNs;
+        state.inverted = inverted;
+        state.enabled = enabled;
+        if (!reschedule(channel, monotonicNs())) return false;
+    }
+
+    wakeup_.notify_all();
+    return true;
+}
+
+bool SoftPWMScheduler::ensureThread()
+{
+    if (thread_.joinable()) return true;
+
+    try
+    {
+        thread_ = std::thread(&SoftPWMScheduler::run, this);
+    }
+    catch (const std::system_error&)
+    {
+        return false;
+    }
+
+    ThreadConfig::apply(thread_.native_handle(), ThreadSchedule{priority_, cpu_});
+    return true;
+}
+
+bool SoftPWMScheduler::setThreadPriority(const int32_t priority)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ThreadConfig::isValid(ThreadSchedule{priority, cpu_})) return false;
+
+    priority_ = priority;
+    return !thread_.joinable() || ThreadConfig::applyPriority(thread_.native_handle(), priority_);
+}
+
+bool SoftPWMScheduler::setThreadAffinity(const int32_t cpu)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!ThreadConfig::isValid(ThreadSchedule{priority_, cpu})) return false;
+
+    cpu_ = cpu;
+    return !thread_.joinable() || ThreadConfig::applyAffinity(thread_.native_handle(), cpu_);
+}
+
+SoftPWMStats SoftPWMScheduler::getChannelStats(const int32_t channel) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    SoftPWMStats stats;
+    if (!isValidChannel(channel)) return stats;
+
+    const JitterCounters& counters = channels_[channel].counters;
+    stats.edges = counters.edges;
+    stats.writes = counters.edges;
+    stats.missedPeriods = counters.missedPeriods;
+    stats.maxJitterNs = counters.maxJitterNs;
+    if (counters.edges != 0) stats.meanJitterNs = counters.totalJitterNs / counters.edges;
+    return stats;
+}
+
+SoftPWMStats SoftPWMScheduler::getStats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    SoftPWMStats stats;
+    stats.edges = total_.edges;
+    stats.writes = writes_;
+    stats.writeErrors = writeErrors_;
+    stats.missedPeriods = total_.missedPeriods;
+    stats.maxJitterNs = total_.maxJitterNs;
+    if (total_.edges != 0) stats.meanJitterNs = total_.totalJitterNs / total_.edges;
+    return stats;
+}
+
+void SoftPWMScheduler::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::vector<std::pair<int32_t, uint64_t>> due;
+
+    while (!stopRequested_)
+    {
+        if (events_.empty())
+        {
+            wakeup_.wait(lock);
+            continue;
+        }
+
+        // steady_clock is CLOCK_MONOTONIC, the wait targets the absolute deadline
+        const uint64_t nowNs = monotonicNs();
+        if (events_.back().deadlineNs > nowNs)
+        {
+            const std::chrono::steady_clock::time_point deadline{std::chrono::nanoseconds(events_.back().deadlineNs)};
+            wakeup_.wait_until(lock, deadline);
+            continue;
+        }
+
+        PinMask mask;
+        PinMask values;
+        due.clear();
+
+        while (!events_.empty() && events_.back().deadlineNs <= nowNs)
+        {
+            const Event event = events_.back();
+            Channel& channel = channels_[event.channel];
+            if (!channel.used || event.generation != channel.generation)
+            {
+                events_.pop_back();
+                continue;
+            }
+
+            // A rise whose active phase is already over would only emit a runt pulse, stay inactive on the grid
+            if (!channel.active && event.deadlineNs + channel.dutyNs <= nowNs)
+            {
+                events_.pop_back();
+                const uint64_t skipped = (nowNs - event.deadlineNs - channel.dutyNs) / channel.periodNs + 1;
+                channel.periodStartNs = event.deadlineNs + (skipped - 1) * channel.periodNs;
+                channel.counters.missedPeriods += skipped;
+                total_.missedPeriods += skipped;
+                pushEvent(Event{channel.periodStartNs + channel.periodNs, event.channel, channel.generation});
+                continue;
+            }
+
+            // A second edge of the same line goes into the next write, or the pulse would vanish
+            if (mask.test(channel.pin)) break;
+            events_.pop_back();
+
+            channel.active = !channel.active;
+            mask.set(channel.pin);
+            values.set(channel.pin, levelOf(channel.active, channel.inverted) == PinValue::HIGH);
+
+            uint64_t nextNs;
+            if (channel.active)
+            {
+                channel.periodStartNs = event.deadlineNs;
+                nextNs = event.deadlineNs + channel.dutyNs;
+            }
+            else
+            {
+                nextNs = channel.periodStartNs + channel.periodNs;
+
+                // Skip periods whose active phase is already over, the grid is kept
+                if (nextNs + channel.dutyNs <= nowNs)
+                {
+                    const uint64_t skipped = (nowNs - nextNs - channel.dutyNs) / channel.periodNs + 1;
+                    nextNs += skipped * channel.periodNs;
+                    channel.counters.missedPeriods += skipped;
+                    total_.missedPeriods += skipped;
+                }
+            }
+
+            pushEvent(Event{nextNs, event.channel, channel.generation});
+            due.emplace_back(event.channel, event.deadlineNs);
+        }
+
+        if (due.empty()) continue;
+
+        ++writes_;
+        if (!gpio_->writeMask(mask, values)) ++writeErrors_;
+
+        const uint64_t doneNs = monotonicNs();
+        for (const auto& [index, deadlineNs] : due)
+        {
+            const uint64_t jitterNs = doneNs - deadlineNs;
+            JitterCounters& counters = channels_[index].counters;
+            ++counters.edges;
+            addJitter(counters.totalJitterNs, counters.maxJitterNs, jitterNs);
+            ++total_.edges;
+            addJitter(total_.totalJitterNs, total_.maxJitterNs, jitterNs);
+        }
+    }
+}
+
+SoftPWM::SoftPWM(SoftPWMScheduler& scheduler) : scheduler_(scheduler)
+{
+}
+
+SoftPWM::~SoftPWM()
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+
+    if (resourceId_ != 0)
+    {
+        ResourceManager::getInstance().setInUse(resourceId_, false);
+        ResourceManager::getInstance().unregisterResource(resourceId_);
+        resourceId_ = 0;
+    }
+
+    if (channel_ >= 0) scheduler_.removeChannel(channel_);
+}
+
+bool SoftPWM::init(uint8_t /*chip*/, const uint8_t channel)
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+
+    if (channel_ >= 0) return false;
+
+    channel_ = scheduler_.addChannel(channel);
+    if (channel_ < 0) return false;
+
+    line_ = channel;
+    resourceId_ = ResourceManager::getInstance().registerResource(
+        ResourceType::PWM_CHANNEL,
+        "soft-pwm:" + std::to_string(channel),
+        reinterpret_cast<void*>(static_cast<uintptr_t>(channel))
+    );
+    ResourceManager::getInstance().setInUse(resourceId_, true);
+
+    return true;
+}
+
+bool SoftPWM::apply(const uint32_t periodNs, const uint32_t dutyNs, const bool inverted, const bool enabled)
+{
+    if (channel_ < 0) return false;
+    if (!scheduler_.configureChannel(channel_, periodNs, dutyNs, inverted, enabled)) return false;
+
+    periodNs_ = periodNs;
+    dutyCycleNs_ = dutyNs;
+    inverted_ = inverted;
+    enabled_ = enabled;
+    return true;
+}
+
+bool SoftPWM::finishChange(std::unique_lock<std::mutex>& lock, const bool result) const
+{
+    const uint64_t resourceId = resourceId_;
+    const uint32_t dutyNs = dutyCycleNs_;
+    const uint8_t line = line_;
+    lock.unlock();
+
+    if (result)
+    {
+        CallbackManager::getInstance().publishEvent(ResourceType::PWM_CHANNEL, resourceId,
+                                                    HALEventKind::OUTPUT_CHANGED, dutyNs, line);
+    }
+    return result;
+}
+
+bool SoftPWM::enable(const bool enabled)
+{
+    std::unique_lock<std::mutex> lock(pwmMutex_);
+    return finishChange(lock, apply(periodNs_, dutyCycleNs_, inverted_, enabled));
+}
+
+bool SoftPWM::setPeriod(const uint32_t periodNs)
+{
+    std::unique_lock<std::mutex> lock(pwmMutex_);
+    return finishChange(lock, apply(periodNs, dutyCycleNs_, inverted_, enabled_));
+}
+
+bool SoftPWM::setDutyCycle(const uint32_t dutyCycleNs)
+{
+    std::unique_lock<std::mutex> lock(pwmMutex_);
+    return finishChange(lock, apply(periodNs_, dutyCycleNs, inverted_, enabled_));
+}
+
+bool SoftPWM::setDutyCyclePercent(const float percent)
+{
+    if (percent < 0.0f || percent > 100.0f)
+    {
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(pwmMutex_);
+    const auto dutyCycle = static_cast<uint32_t>((static_cast<double>(periodNs_) * percent) / 100.0);
+    return finishChange(lock, apply(periodNs_, dutyCycle, inverted_, enabled_));
+}
+
+bool SoftPWM::setPolarity(const bool invertPolarity)
+{
+    std::unique_lock<std::mutex> lock(pwmMutex_);
+    return finishChange(lock, apply(periodNs_, dutyCycleNs_, invertPolarity, enabled_));
+}
+
+uint32_t SoftPWM::getPeriod() const
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+    return periodNs_;
+}
+
+uint32_t SoftPWM::getDutyCycle() const
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+    return dutyCycleNs_;
+}
+
+bool SoftPWM::isEnabled() const
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+    return enabled_;
+}
+
+uint64_t SoftPWM::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+    return resourceId_;
+}
+
+SoftPWMStats SoftPWM::getStats() const
+{
+    std::lock_guard<std::mutex> lock(pwmMutex_);
+    return scheduler_.getChannelStats(channel_);
+}
@@ -1,29 +1,273 @@
 #include "../include/hal/resource_manager.h"
+#include <algorithm>
+#include <condition_variable>
 #include <stdexcept>
+#include <thread>
+#include <unordered_set>
 
 using namespace mex_hal;
 
+namespace
+{
+    /**
+     * @brief Remove one edge from an adjacency map
+     * @param edges The map
+     * @param from The resource whose list holds the edge
+     * @param to The other end of the edge
+     * @return A true if the edge was found, false otherwise
+     */
+    bool eraseEdge(std::unordered_map<uint64_t, std::vector<uint64_t>>& edges, const uint64_t from, const uint64_t to)
+    {
+        const auto it = edges.find(from);
+        if (it == edges.end())
+        {
+            return false;
+        }
+
+        auto& list = it->second;
+        const auto edge = std::find(list.begin(), list.end(), to);
+        if (edge == list.end())
+        {
+            return false;
+        }
+
+        list.erase(edge);
+        if (list.empty())
+        {
+            edges.erase(it);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Add to a counter that only the calling thread writes, without a read-modify-write
+     * @param counter The counter
+     * @param value The amount to add
+     */
+    void addOwned(std::atomic<uint64_t>& counter, const uint64_t value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+}
+
+ResourceManager::ReadGuard::ReadGuard(ReaderSlot& slot)
+    : slot_(slot)
+{
+    // Ordered before the slot checks, a writer that sees the reader slot clear knows this lookup sees the retirement
+    slot_.active.fetch_add(1, std::memory_order_seq_cst);
+}
+
+ResourceManager::ReadGuard::~ReadGuard()
+{
+    slot_.active.fetch_sub(1, std::memory_order_release);
+}
+
+ResourceManager::IoShard::~IoShard()
+{
+    for (auto& chunk : chunks)
+    {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+ResourceManager::IoLease::~IoLease()
+{
+    if (shard != nullptr)
+    {
+        // Publishes the counts to the next thread that writes the shard
+        shard->leased.store(false, std::memory_order_release);
+    }
+}
+
+ResourceManager::ResourceManager() = default;
+
+ResourceManager::~ResourceManager()
+{
+    for (auto& chunk : chunks_)
+    {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
 ResourceManager& ResourceManager::getInstance()
 {
     static ResourceManager instance;
     return instance;
 }
 
+ResourceManager::ReaderSlot& ResourceManager::readerSlot() const
+{
+    thread_local const size_t index = nextReaderSlot_.fetch_add(1, std::memory_order_relaxed) % READER_SLOTS;
+    return readerSlots_[index];
+}
+
+ResourceManager::IoShard& ResourceManager::ioShard()
+{
+    thread_local IoLease lease;
+    if (lease.shard != nullptr)
+    {
+        return *lease.shard;
+    }
+
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    for (const auto& shard : ioShards_)
+    {
+        bool leased = false;
+        if (shard->leased.compare_exchange_strong(leased, true, std::memory_order_acquire))
+        {
+            lease.shard = shard.get();
+            return *lease.shard;
+        }
+    }
+
+    ioShards_.push_back(std::make_unique<IoShard>());
+    lease.shard = ioShards_.back().get();
+    lease.shard->leased.store(true, std::memory_order_relaxed);
+    return *lease.shard;
+}
+
+ResourceManager::Slot* ResourceManager::find(const uint64_t resourceId) const
+{
+    // ID 0 wraps to an index beyond the map
+    const uint32_t index = static_cast<uint32_t>(resourceId) - 1;
+    if (index >= MAX_RESOURCES)
+    {
+        return nullptr;
+    }
+
+    Slot* chunk = chunks_[index / CHUNK_SLOTS].load(std::memory_order_acquire);
+    if (chunk == nullptr)
+    {
+        return nullptr;
+    }
+
+    // seq_cst like the reader slot mark and the retirement, either the lookup fails or reclaim() sees the mark
+    Slot& slot = chunk[index % CHUNK_SLOTS];
+    if (slot.generation.load(std::memory_order_seq_cst) != static_cast<uint32_t>(resourceId >> 32) ||
+        (slot.info.refCount.load(std::memory_order_seq_cst) & ResourceInfo::RETIRED) != 0)
+    {
+        return nullptr;
+    }
+
+    return &slot;
+}
+
+void ResourceManager::retire(const uint32_t index)
+{
+    // Stale IDs stop matching at once, lookups already past the check see RETIRED; seq_cst pairs with find()
+    Slot& slot = chunks_[index / CHUNK_SLOTS].load(std::memory_order_relaxed)[index % CHUNK_SLOTS];
+    slot.generation.fetch_add(1, std::memory_order_seq_cst);
+    retiredSlots_.push_back(index);
+    --liveCount_;
+}
+
+void ResourceManager::reclaim()
+{
+    // A lookup that marked its slot after the generation bump fails its check, so clear slots end every grace period
+    for (const ReaderSlot& slot : readerSlots_)
+    {
+        if (slot.active.load(std::memory_order_seq_cst) != 0)
+        {
+            return;
+        }
+    }
+
+    // References taken with acquire() before clearAll() keep their slot until released
+    auto it = retiredSlots_.begin();
+    while (it != retiredSlots_.end())
+    {
+        ResourceInfo& info = chunks_[*it / CHUNK_SLOTS].load(std::memory_order_relaxed)[*it % CHUNK_SLOTS].info;
+        if (info.refCount.load(std::memory_order_acquire) != ResourceInfo::RETIRED)
+        {
+            ++it;
+            continue;
+        }
+
+        info.name.clear();
+        info.handle = nullptr;
+        freeSlots_.push_back(*it);
+        *it = retiredSlots_.back();
+        retiredSlots_.pop_back();
+    }
+}
+
+uint64_t ResourceManager::add(const ResourceType type, const std::string& name, void* handle)
+{
+    reclaim();
+
+    uint32_t index = 0;
+    if (!freeSlots_.empty())
+    {
+        index = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+    else if (slotCount_ < MAX_RESOURCES)
+    {
+        index = slotCount_++;
+        auto& chunk = chunks_[index / CHUNK_SLOTS];
+        if (chunk.load(std::memory_order_relaxed) == nullptr)
+        {
+            Slot* slots = new Slot[CHUNK_SLOTS];
+            for (size_t i = 0; i < CHUNK_SLOTS; ++i)
+            {
+                slots[i].info.refCount.store(ResourceInfo::RETIRED, std::memory_order_relaxed);
+            }
+            chunk.store(slots, std::memory_order_release);
+        }
+    }
+    else
+    {
+        return 0;
+    }
+
+    Slot& slot = chunks_[index / CHUNK_SLOTS].load(std::memory_order_relaxed)[index % CHUNK_SLOTS];
+    slot.info.type = type;
+    slot.info.name = name;
+    slot.info.handle = handle;
+    slot.info.inUse.store(false, std::memory_order_relaxed);
+
+    // Publishes the fields above to lookups that see the resource registered
+    slot.info.refCount.store(1, std::memory_order_release);
+    ++liveCount_;
+
+    return (static_cast<uint64_t>(slot.generation.load(std::memory_order_relaxed)) << 32) | (index + 1);
+}
+
 uint64_t ResourceManager::registerResource(const ResourceType type, const std::string& name, void* handle)
 {
     std::lock_guard<std::mutex> lock(resourceMutex_);
+    return add(type, name, handle);
+}
+
+uint64_t ResourceManager::registerResource(const ResourceType type, const std::string& name, void* handle,
+                                           const std::vector<uint64_t>& dependencies)
+{
+    std::lock_guard<std::mutex> lock(resourceMutex_);
+
+    for (const uint64_t dependencyId : dependencies)
+    {
+        if (find(dependencyId) == nullptr)
+        {
+            return 0;
+        }
+    }
 
-    const uint64_t resourceId = nextResourceId_.fetch_add(1, std::memory_order_relaxed);
-        
-    auto resource = std::make_unique<ResourceInfo>();
-    resource->type = type;
-    resource->name = name;
-    resource->handle = handle;
-    resource->refCount.store(1, std::memory_order_release);
-    resource->inUse.store(false, std::memory_order_release);
-        
-    resources_[resourceId] = std::move(resource);
-        
+    const uint64_t resourceId = add(type, name, handle);
+    if (resourceId == 0)
+    {
+        return 0;
+    }
+
+    // A new resource has no dependents, its edges close no cycle
+    for (const uint64_t dependencyId : dependencies)
+    {
+        auto& list = dependencies_[resourceId];
+        if (std::find(list.begin(), list.end(), dependencyId) == list.end())
+        {
+            list.push_back(dependencyId);
+            dependents_[dependencyId].push_back(resourceId);
+        }
+    }
     return resourceId;
 }
 
@@ -31,155 +275,637 @@ bool ResourceManager::unregisterResource(const uint64_t resourceId)
 {
     std::lock_guard<std::mutex> lock(resourceMutex_);
 
-    const auto it = resources_.find(resourceId);
-    if (it == resources_.end())
+    Slot* slot = find(resourceId);
+    if (slot == nullptr)
     {
         return false;
     }
-        
-    // Only allow unregistration if ref count is 0
-    if (it->second->refCount.load(std::memory_order_acquire) > 0)
+
+    // Only allow unregistration if ref count is 0, a concurrent addRef() then sees the resource retired
+    uint32_t expected = 0;
+    if (!slot->info.refCount.compare_exchange_strong(expected, ResourceInfo::RETIRED, std::memory_order_seq_cst))
     {
         return false;
     }
-        
-    resources_.erase(it);
+
+    retire(static_cast<uint32_t>(resourceId) - 1);
+    eraseDependencies(resourceId);
+    reclaim();
     return true;
 }
 
-uint32_t ResourceManager::addRef(const uint64_t resourceId)
+void ResourceManager::eraseDependencies(const uint64_t resourceId)
+{
+    if (const auto it = dependencies_.find(resourceId); it != dependencies_.end())
+    {
+        for (const uint64_t dependencyId : it->second)
+        {
+            eraseEdge(dependents_, dependencyId, resourceId);
+        }
+        dependencies_.erase(it);
+    }
+
+    if (const auto it = dependents_.find(resourceId); it != dependents_.end())
+    {
+        for (const uint64_t dependentId : it->second)
+        {
+            eraseEdge(dependencies_, dependentId, resourceId);
+        }
+        dependents_.erase(it);
+    }
+}
+
+bool ResourceManager::dependsOn(const uint64_t resourceId, const uint64_t dependencyId) const
+{
+    std::vector<uint64_t> stack{resourceId};
+    std::unordered_set<uint64_t> visited{resourceId};
+    while (!stack.empty())
+    {
+        const auto it = dependencies_.find(stack.back());
+        stack.pop_back();
+        if (it == dependencies_.end())
+        {
+            continue;
+        }
+
+        for (const uint64_t next : it->second)
+        {
+            if (next == dependencyId)
+            {
+                return true;
+            }
+            if (visited.insert(next).second)
+            {
+                stack.push_back(next);
+            }
+        }
+    }
+    return false;
+}
+
+bool ResourceManager::addDependency(const uint64_t resourceId, const uint64_t dependencyId)
 {
     std::lock_guard<std::mutex> lock(resourceMutex_);
 
-    const auto it = resources_.find(resourceId);
-    if (it == resources_.end())
+    if (resourceId == dependencyId || find(resourceId) == nullptr || find(dependencyId) == nullptr)
     {
-        return 0;
+        return false;
+    }
+
+    auto& list = dependencies_[resourceId];
+    if (std::find(list.begin(), list.end(), dependencyId) != list.end())
+    {
+        return true;
+    }
+
+    // The edge closes a cycle if the dependency already uses the resource
+    if (dependsOn(dependencyId, resourceId))
+    {
+        if (list.empty())
+        {
+            dependencies_.erase(resourceId);
+        }
+        return false;
     }
-        
-    return it->second->refCount.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    list.push_back(dependencyId);
+    dependents_[dependencyId].push_back(resourceId);
+    return true;
 }
 
-uint32_t ResourceManager::release(const uint64_t resourceId)
+bool ResourceManager::removeDependency(const uint64_t resourceId, const uint64_t dependencyId)
+{
+    std::lock_guard<std::mutex> lock(resourceMutex_);
+
+    if (!eraseEdge(dependencies_, resourceId, dependencyId))
+    {
+        return false;
+    }
+
+    eraseEdge(dependents_, dependencyId, resourceId);
+    return true;
+}
+
+std::vector<uint64_t> ResourceManager::getDependencies(const uint64_t resourceId) const
+{
+    std::lock_guard<std::mutex> lock(resourceMutex_);
+    const auto it = dependencies_.find(resourceId);
+    return it != dependencies_.end() ? it->second : std::vector<uint64_t>{};
+}
+
+std::vector<uint64_t> ResourceManager::getDependents(const uint64_t resourceId) const
+{
+    std::lock_guard<std::mutex> lock(resourceMutex_);
+    const auto it = dependents_.find(resourceId);
+    return it != dependents_.end() ? it->second : std::vector<uint64_t>{};
+}
+
+void ResourceManager::buildGraph(Graph& graph) const
+{
+    collect(graph.resources);
+
+    std::unordered_map<uint64_t, size_t> positions;
+    positions.reserve(graph.resources.size());
+    for (size_t i = 0; i < graph.resources.size(); ++i)
+    {
+        positions.emplace(graph.resources[i].id, i);
+    }
+
+    graph.dependents.assign(graph.resources.size(), 0);
+    graph.dependencies.assign(graph.resources.size(), {});
+    for (size_t from = 0; from < graph.resources.size(); ++from)
+    {
+        for (const uint64_t dependencyId : graph.resources[from].dependencies)
+        {
+            const size_t to = positions.at(dependencyId);
+            graph.dependencies[from].push_back(to);
+            ++graph.dependents[to];
+        }
+    }
+}
+
+bool ResourceManager::sortGraph(const Graph& graph, std::vector<size_t>& order)
 {
+    // Kahn's algorithm, a resource is ready once all its dependents are placed
+    std::vector<uint32_t> dependents = graph.dependents;
+    order.clear();
+    for (size_t i = 0; i < dependents.size(); ++i)
+    {
+        if (dependents[i] == 0)
+        {
+            order.push_back(i);
+        }
+    }
+
+    for (size_t next = 0; next < order.size(); ++next)
+    {
+        for (const size_t dependency : graph.dependencies[order[next]])
+        {
+            if (--dependents[dependency] == 0)
+            {
+                order.push_back(dependency);
+            }
+        }
+    }
+
+    // Resources on a cycle never become ready
+    return order.size() == dependents.size();
+}
+
+bool ResourceManager::getTeardownOrder(std::vector<uint64_t>& order) const
+{
+    Graph graph;
+    {
+        std::lock_guard<std::mutex> lock(resourceMutex_);
+        buildGraph(graph);
+    }
+
+    std::vector<size_t> positions;
+    const bool acyclic = sortGraph(graph, positions);
+
+    order.clear();
+    for (const size_t position : positions)
+    {
+        order.push_back(graph.resources[position].id);
+    }
+    return acyclic;
+}
+
+bool ResourceManager::teardown(const ResourceReleaseCallback& release, const size_t threads)
+{
+    Graph graph;
+    {
+        std::lock_guard<std::mutex> lock(resourceMutex_);
+        buildGraph(graph);
+    }
+
+    std::vector<size_t> ready;
+    if (!sortGraph(graph, ready))
+    {
+        return false;
+    }
+
+    // Restart from the resources without dependents, the rest become ready as their dependents finish
+    ready.erase(std::remove_if(ready.begin(), ready.end(),
+                               [&graph](const size_t i) { return graph.dependents[i] != 0; }),
+                ready.end());
+    std::reverse(ready.begin(), ready.end());
+
+    std::mutex queueMutex;
+    std::condition_variable queueCv;
+    size_t remaining = graph.resources.size();
+
+    const auto worker = [&] {
+        std::unique_lock<std::mutex> queueLock(queueMutex);
+        while (true)
+        {
+            queueCv.wait(queueLock, [&] { return !ready.empty() || remaining == 0; });
+            if (ready.empty())
+            {
+                return;
+            }
+
+            const size_t position = ready.back();
+            ready.pop_back();
+            queueLock.unlock();
+
+            const ResourceState& resource = graph.resources[position];
+            release(resource);
+            {
+                std::lock_guard<std::mutex> lock(resourceMutex_);
+                Slot* slot = find(resource.id);
+                if (slot != nullptr &&
+                    (slot->info.refCount.fetch_or(ResourceInfo::RETIRED, std::memory_order_seq_cst) &
+                     ResourceInfo::RETIRED) == 0)
+                {
+                    retire(static_cast<uint32_t>(resource.id) - 1);
+                }
+                eraseDependencies(resource.id);
+            }
+
+            queueLock.lock();
+            --remaining;
+            bool woken = remaining == 0;
+            for (const size_t dependency : graph.dependencies[position])
+            {
+                if (--graph.dependents[dependency] == 0)
+                {
+                    ready.push_back(dependency);
+                    woken = true;
+                }
+            }
+            if (woken)
+            {
+                queueCv.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < std::min(threads, graph.resources.size()); ++t)
+    {
+        helpers.emplace_back(worker);
+    }
+    worker();
+    for (auto& helper : helpers)
+    {
+        helper.join();
+    }
+
     std::lock_guard<std::mutex> lock(resourceMutex_);
+    reclaim();
+    return true;
+}
 
-    const auto it = resources_.find(resourceId);
-    if (it == resources_.end())
+uint32_t ResourceManager::addRef(ResourceInfo& info)
+{
+    const uint32_t oldCount = info.refCount.fetch_add(1, std::memory_order_acq_rel);
+    if ((oldCount & ResourceInfo::RETIRED) != 0)
     {
+        // Lost the race with unregistration, the count of a retired resource is no longer read
+        info.refCount.fetch_sub(1, std::memory_order_relaxed);
         return 0;
     }
 
-    const uint32_t oldCount = it->second->refCount.load(std::memory_order_acquire);
-    if (oldCount == 0)
+    return oldCount + 1;
+}
+
+uint32_t ResourceManager::addRef(const uint64_t resourceId)
+{
+    ReadGuard guard(readerSlot());
+
+    Slot* slot = find(resourceId);
+    if (slot == nullptr)
     {
         return 0;
     }
-        
-    return it->second->refCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+
+    return addRef(slot->info);
+}
+
+ResourceInfo* ResourceManager::acquire(const uint64_t resourceId)
+{
+    ReadGuard guard(readerSlot());
+
+    Slot* slot = find(resourceId);
+    if (slot == nullptr || addRef(slot->info) == 0)
+    {
+        return nullptr;
+    }
+
+    return &slot->info;
+}
+
+uint32_t ResourceManager::release(ResourceInfo& info)
+{
+    uint32_t oldCount = info.refCount.load(std::memory_order_relaxed);
+    while ((oldCount & ~ResourceInfo::RETIRED) != 0)
+    {
+        if (info.refCount.compare_exchange_weak(oldCount, oldCount - 1, std::memory_order_acq_rel))
+        {
+            return (oldCount - 1) & ~ResourceInfo::RETIRED;
+        }
+    }
+
+    return 0;
+}
+
+uint32_t ResourceManager::release(const uint64_t resourceId)
+{
+    ReadGuard guard(readerSlot());
+
+    Slot* slot = find(resourceId);
+    if (slot == nullptr)
+    {
+        return 0;
+    }
+
+    return release(slot->info);
 }
 
 uint32_t ResourceManager::getRefCount(const uint64_t resourceId) const
 {
-    std::lock_guard<std::mutex> lock(resourceMutex_);
+    // Slots are never freed, a read needs no guard if the generation still matches after it
+    const Slot* slot = find(resourceId);
+    if (slot == nullptr)
+    {
+        return 0;
+    }
 
-    const auto it = resources_.find(resourceId);
-    if (it == resources_.end())
+    const uint32_t count = slot->info.refCount.load(std::memory_order_acquire);
+    if (slot->generation.load(std::memory_order_acquire) != static_cast<uint32_t>(resourceId >> 32))
     {
         return 0;
     }
-        
-    return it->second->refCount.load(std::memory_order_acquire);
+
+    return count & ~ResourceInfo::RETIRED;
 }
 
 bool ResourceManager::isInUse(const uint64_t resourceId) const
 {
-    std::lock_guard<std::mutex> lock(resourceMutex_);
-
-    const auto it = resources_.find(resourceId);
-    if (it == resources_.end())
+    const Slot* slot = find(resourceId);
+    if (slot == nullptr)
     {
         return false;
     }
-        
-    return it->second->inUse.load(std::memory_order_acquire);
+
+    const bool inUse = slot->info.inUse.load(std::memory_order_acquire);
+    return inUse && slot->generation.load(std::memory_order_acquire) == static_cast<uint32_t>(resourceId >> 32);
 }
 
 void ResourceManager::setInUse(const uint64_t resourceId, const bool inUse)
 {
-    std::lock_guard<std::mutex> lock(resourceMutex_);
+    ReadGuard guard(readerSlot());
+
+    if (Slot* slot = find(resourceId))
+    {
+        slot->info.inUse.store(inUse, std::memory_order_release);
+    }
+}
 
-    const auto it = resources_.find(resourceId);
+bool ResourceManager::getResourceInfo(const uint64_t resourceId, ResourceState& state) const
+{
+    ReadGuard guard(readerSlot());
 
-    if (it != resources_.end())
+    // The slot is not reused while the guard is held, its name only changes on reuse
+    const Slot* slot = find(resourceId);
+    if (slot == nullptr)
     {
-        it->second->inUse.store(inUse, std::memory_order_release);
+        return false;
     }
+
+    state.id = resourceId;
+    state.type = slot->info.type;
+    state.name = slot->info.name;
+    state.handle = slot->info.handle;
+    state.refCount = slot->info.refCount.load(std::memory_order_acquire) & ~ResourceInfo::RETIRED;
+    state.inUse = slot->info.inUse.load(std::memory_order_acquire);
+    state.dependencies.clear();
+    return true;
 }
 
-const ResourceInfo *ResourceManager::getResourceInfo(const uint64_t resourceId) const
+void ResourceManager::collect(std::vector<ResourceState>& resources) const
+{
+    size_t count = 0;
+    for (uint32_t index = 0; index < slotCount_; ++index)
+    {
+        const Slot& slot = chunks_[index / CHUNK_SLOTS].load(std::memory_order_relaxed)[index % CHUNK_SLOTS];
+        const uint32_t refCount = slot.info.refCount.load(std::memory_order_acquire);
+        if ((refCount & ResourceInfo::RETIRED) != 0)
+        {
+            continue;
+        }
+
+        if (count == resources.size())
+        {
+            resources.emplace_back();
+        }
+        ResourceState& state = resources[count++];
+        state.id = (static_cast<uint64_t>(slot.generation.load(std::memory_order_relaxed)) << 32) | (index + 1);
+        state.type = slot.info.type;
+        state.name = slot.info.name;
+        state.handle = slot.info.handle;
+        state.refCount = refCount;
+        state.inUse = slot.info.inUse.load(std::memory_order_acquire);
+
+        const auto edges = dependencies_.find(state.id);
+        if (edges != dependencies_.end())
+        {
+            state.dependencies.assign(edges->second.begin(), edges->second.end());
+        }
+        else
+        {
+            state.dependencies.clear();
+        }
+    }
+    resources.resize(count);
+}
+
+void ResourceManager::snapshot(std::vector<ResourceState>& resources) const
 {
     std::lock_guard<std::mutex> lock(resourceMutex_);
+    collect(resources);
+}
+
+std::vector<ResourceState> ResourceManager::snapshot() const
+{
+    std::vector<ResourceState> resources;
+    snapshot(resources);
+    return resources;
+}
 
-    const auto it = resources_.find(resourceId);
-    if (it == resources_.end())
+void ResourceManager::recordIo(const uint64_t resourceId, const size_t bytes, const uint64_t latencyNs,
+                               const bool success)
+{
+    // The ID names the counters, the slot itself is not touched
+    const uint32_t index = static_cast<uint32_t>(resourceId) - 1;
+    if (index >= MAX_RESOURCES)
     {
-        return nullptr;
+        return;
     }
 
-    return it->second.get();
+    auto& chunk = ioShard().chunks[index / CHUNK_SLOTS];
+    IoCounters* counters = chunk.load(std::memory_order_relaxed);
+    if (counters == nullptr)
+    {
+        counters = new IoCounters[CHUNK_SLOTS];
+        chunk.store(counters, std::memory_order_release);
+    }
+
+    IoCounters& entry = counters[index % CHUNK_SLOTS];
+    const uint32_t generation = static_cast<uint32_t>(resourceId >> 32);
+    if (entry.generation.load(std::memory_order_relaxed) != generation)
+    {
+        // The slot was reused since this thread last counted it, readers skip the entry while it is reset
+        entry.generation.store(NO_GENERATION, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        entry.operations.store(0, std::memory_order_relaxed);
+        entry.bytes.store(0, std::memory_order_relaxed);
+        entry.errors.store(0, std::memory_order_relaxed);
+        entry.totalLatencyNs.store(0, std::memory_order_relaxed);
+        entry.maxLatencyNs.store(0, std::memory_order_relaxed);
+        entry.generation.store(generation, std::memory_order_release);
+    }
+
+    addOwned(entry.operations, 1);
+    addOwned(entry.bytes, bytes);
+    addOwned(entry.errors, success ? 0 : 1);
+    addOwned(entry.totalLatencyNs, latencyNs);
+    if (latencyNs > entry.maxLatencyNs.load(std::memory_order_relaxed))
+    {
+        entry.maxLatencyNs.store(latencyNs, std::memory_order_relaxed);
+    }
+}
+
+bool ResourceManager::getIoStats(const uint64_t resourceId, ResourceIoStats& stats) const
+{
+    if (find(resourceId) == nullptr)
+    {
+        return false;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(resourceId) - 1;
+    const uint32_t generation = static_cast<uint32_t>(resourceId >> 32);
+    stats = {};
+
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    for (const auto& shard : ioShards_)
+    {
+        const IoCounters* counters = shard->chunks[index / CHUNK_SLOTS].load(std::memory_order_acquire);
+        if (counters == nullptr)
+        {
+            continue;
+        }
+
+        const IoCounters& entry = counters[index % CHUNK_SLOTS];
+        if (entry.generation.load(std::memory_order_acquire) != generation)
+        {
+            continue;
+        }
+
+        const uint64_t operations = entry.operations.load(std::memory_order_relaxed);
+        const uint64_t bytes = entry.bytes.load(std::memory_order_relaxed);
+        const uint64_t errors = entry.errors.load(std::memory_order_relaxed);
+        const uint64_t totalLatencyNs = entry.totalLatencyNs.load(std::memory_order_relaxed);
+        const uint64_t maxLatencyNs = entry.maxLatencyNs.load(std::memory_order_relaxed);
+
+        // Counts read across a reset for a later resource in the slot are dropped
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (entry.generation.load(std::memory_order_relaxed) != generation)
+        {
+            continue;
+        }
+
+        stats.operations += operations;
+        stats.bytes += bytes;
+        stats.errors += errors;
+        stats.totalLatencyNs += totalLatencyNs;
+        stats.maxLatencyNs = std::max(stats.maxLatencyNs, maxLatencyNs);
+    }
+    return true;
 }
 
 size_t ResourceManager::getResourceCount() const
 {
     std::lock_guard<std::mutex> lock(resourceMutex_);
-    return resources_.size();
+    return liveCount_;
 }
 
 void ResourceManager::clearAll()
 {
     std::lock_guard<std::mutex> lock(resourceMutex_);
-    resources_.clear();
+
+    for (uint32_t index = 0; index < slotCount_; ++index)
+    {
+        ResourceInfo& info = chunks_[index / CHUNK_SLOTS].load(std::memory_order_relaxed)[index % CHUNK_SLOTS].info;
+        if ((info.refCount.fetch_or(ResourceInfo::RETIRED, std::memory_order_seq_cst) & ResourceInfo::RETIRED) == 0)
+        {
+            retire(index);
+        }
+    }
+    dependencies_.clear();
+    dependents_.clear();
+    reclaim();
 }
 
 // ResourceGuard implementation
 ResourceGuard::ResourceGuard(const uint64_t resourceId)
     : resourceId_(resourceId)
-, valid_(true)
+    , info_(resourceId != 0 ? ResourceManager::getInstance().acquire(resourceId) : nullptr)
 {
-    if (resourceId_ != 0)
+}
+
+ResourceGuard::ResourceGuard(const uint64_t resourceId, ResourceInfo* info)
+    : resourceId_(resourceId)
+    , info_(info)
+{
+}
+
+ResourceGuard ResourceGuard::share() const
+{
+    // The reference held by this guard keeps the slot from being reused
+    if (info_ == nullptr || ResourceManager::addRef(*info_) == 0)
     {
-        ResourceManager::getInstance().addRef(resourceId_);
+        return ResourceGuard(resourceId_, nullptr);
     }
+    return ResourceGuard(resourceId_, info_);
 }
 
 ResourceGuard::~ResourceGuard()
 {
-    if (valid_ && resourceId_ != 0)
+    if (info_ != nullptr)
     {
-        ResourceManager::getInstance().release(resourceId_);
+        ResourceManager::release(*info_);
     }
 }
 
 ResourceGuard::ResourceGuard(ResourceGuard &&other) noexcept
     : resourceId_(other.resourceId_)
-    , valid_(other.valid_)
+    , info_(other.info_)
 {
-    other.valid_ = false;
+    other.info_ = nullptr;
 }
 
 ResourceGuard &ResourceGuard::operator=(ResourceGuard &&other) noexcept
 {
     if (this != &other)
     {
-        if (valid_ && resourceId_ != 0)
+        if (info_ != nullptr)
         {
-            ResourceManager::getInstance().release(resourceId_);
+            ResourceManager::release(*info_);
         }
 
         resourceId_ = other.resourceId_;
-        valid_ = other.valid_;
-        other.valid_ = false;
+        info_ = other.info_;
+        other.info_ = nullptr;
     }
     return *this;
 }
+
+void ResourceIoTimer::finish(const size_t bytes, const bool success) const
+{
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    ResourceManager::getInstance().recordIo(
+        resourceId_, bytes,
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()), success);
+}
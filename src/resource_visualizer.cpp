@@ -1,5 +1,6 @@
 #include "../include/hal/resource_visualizer.h"
 #include "../include/hal/resource_manager.h"
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -24,6 +25,7 @@ void ResourceVisualizer::startLiveUpdate(int intervalMs)
         {
             gatherResourceData();
             buildResourceGraph();
+            gatherCallbackData();
             std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
         }
     });
@@ -39,25 +41,38 @@ void ResourceVisualizer::stopLiveUpdate()
 void ResourceVisualizer::gatherResourceData()
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    const auto& rm = ResourceManager::getInstance();
-    const size_t count = rm.getResourceCount();
 
+    // One copy under the registration lock, IDs may be sparse after unregistering
+    ResourceManager::getInstance().snapshot(resourceStates_);
+
+    // The metrics are per process, read once for all resources
+    ResourceUsage process{};
+    gatherProcessMetrics(process);
+
+    const auto& manager = ResourceManager::getInstance();
     resourceUsages_.clear();
-    for (uint64_t id = 1; id <= count; ++id)
+    for (const ResourceState& state : resourceStates_)
     {
-        if (const auto info = rm.getResourceInfo(id))
-        {
-            ResourceUsage usage;
-            usage.id = id;
-            usage.name = info->name;
-            usage.refCount = info->refCount.load();
-            usage.inUse = info->inUse.load();
+        ResourceUsage usage = process;
+        usage.id = state.id;
+        usage.name = state.name;
+        usage.refCount = state.refCount;
+        usage.inUse = state.inUse;
+        manager.getIoStats(state.id, usage.io);
+        resourceUsages_.push_back(std::move(usage));
+    }
+}
 
-            gatherProcessMetrics(usage);
+std::vector<ResourceUsage> ResourceVisualizer::getResourceUsages() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resourceUsages_;
+}
 
-            resourceUsages_.push_back(usage);
-        }
-    }
+std::vector<ResourceNode> ResourceVisualizer::getResourceGraph() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return resourceGraph_;
 }
 
 void ResourceVisualizer::gatherProcessMetrics(ResourceUsage& usage)
@@ -103,13 +118,14 @@ void ResourceVisualizer::buildResourceGraph()
     std::lock_guard<std::mutex> lock(mutex_);
     resourceGraph_.clear();
 
-    for (const auto& usage : resourceUsages_)
+    // The edges were copied with the resources by the last snapshot, no further lock is taken
+    for (const ResourceState& state : resourceStates_)
     {
         ResourceNode node;
-        node.id = usage.id;
-        node.name = usage.name;
-        // TODO: populate dependencies if ResourceManager tracks them
-        resourceGraph_.push_back(node);
+        node.id = state.id;
+        node.name = state.name;
+        node.dependencies = state.dependencies;
+        resourceGraph_.push_back(std::move(node));
     }
 }
 
@@ -117,7 +133,7 @@ void ResourceVisualizer::printResourceUsage() const
 {
     std::lock_guard<std::mutex> lock(mutex_);
     std::cout << "\n=== HAL Resource Usage ===\n";
-    std::cout << "ID\tName\tRefCount\tInUse\tCPU%\tMemory KB\tFDs\tCPU Bar\n";
+    std::cout << "ID\tName\tRefCount\tInUse\tOps\tBytes\tErrors\tAvg us\tMax us\tCPU%\tMemory KB\tFDs\tCPU Bar\n";
 
     for (const auto& r : resourceUsages_)
     {
@@ -128,6 +144,11 @@ void ResourceVisualizer::printResourceUsage() const
                   << r.name << "\t"
                   << r.refCount << "\t\t"
                   << (r.inUse ? "Yes" : "No") << "\t"
+                  << r.io.operations << "\t"
+                  << r.io.bytes << "\t"
+                  << r.io.errors << "\t"
+                  << (r.io.operations != 0 ? r.io.totalLatencyNs / r.io.operations / 1000 : 0) << "\t"
+                  << r.io.maxLatencyNs / 1000 << "\t"
                   << r.cpuPercent << "\t"
                   << (r.memoryBytes / 1024) << "\t"
                   << r.openFDs << "\t"
@@ -149,3 +170,46 @@ void ResourceVisualizer::printResourceGraph() const
         std::cout << "\n";
     }
 }
+
+void ResourceVisualizer::gatherCallbackData()
+{
+    std::vector<CallbackProfile> profiles = CallbackManager::getInstance().getCallbackProfiles();
+    std::sort(profiles.begin(), profiles.end(), [](const CallbackProfile& a, const CallbackProfile& b) {
+        return a.execution.totalNs > b.execution.totalNs;
+    });
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbackProfiles_ = std::move(profiles);
+}
+
+std::vector<CallbackProfile> ResourceVisualizer::getTopCallbacks(const size_t count) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t n = std::min(count, callbackProfiles_.size());
+    return {callbackProfiles_.begin(), callbackProfiles_.begin() + static_cast<std::ptrdiff_t>(n)};
+}
+
+void ResourceVisualizer::printCallbackUsage(const size_t count) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::cout << "\n=== Callback Usage ===\n";
+    if (!CallbackManager::PROFILING_ENABLED)
+    {
+        std::cout << "Callback profiling is not built in (HAL_CALLBACK_PROFILING)\n";
+        return;
+    }
+
+    std::cout << "ID\tSource\tCalls\tTotal us\tExec p50/p99/max ns\tLatency p50/p99/max ns\n";
+    const size_t n = std::min(count, callbackProfiles_.size());
+    for (size_t i = 0; i < n; ++i)
+    {
+        const CallbackProfile& p = callbackProfiles_[i];
+        std::cout << p.callbackId << "\t"
+                  << (p.kind == CallbackKind::TIMER ? "timer " : p.kind == CallbackKind::EVENT ? "event " : "pin ")
+                  << p.source << "\t"
+                  << p.execution.count << "\t"
+                  << (p.execution.totalNs / 1000) << "\t\t"
+                  << p.execution.p50Ns << "/" << p.execution.p99Ns << "/" << p.execution.maxNs << "\t\t"
+                  << p.latency.p50Ns << "/" << p.latency.p99Ns << "/" << p.latency.maxNs << "\n";
+    }
+}
@@ -0,0 +1,211 @@
+#include "spi_bitbang.h"
+#include "../../include/hal/callback_manager.h"
+
+using namespace mex_hal;
+
+SPIBitBang::SPIBitBang(std::shared_ptr<GPIOInterface> gpio, const SoftSPIPins& pins)
+    : gpio_(std::move(gpio)), pins_(pins)
+{
+}
+
+SPIBitBang::~SPIBitBang()
+{
+    std::lock_guard<std::mutex> lock(spiMutex_);
+
+    if (resourceId_ != 0)
+    {
+        ResourceManager::getInstance().setInUse(resourceId_, false);
+        ResourceManager::getInstance().unregisterResource(resourceId_);
+        resourceId_ = 0;
+    }
+}
+
+void SPIBitBang::applyMode(const SPIMode mode)
+{
+    cpol_ = mode == SPIMode::MODE_2 || mode == SPIMode::MODE_3;
+    cpha_ = mode == SPIMode::MODE_1 || mode == SPIMode::MODE_3;
+}
+
+PinMask SPIBitBang::lineValues(const bool sclk, const bool mosi, const bool csActive) const
+{
+    PinMask values;
+    if (sclk) values.set(pins_.sclk);
+    if (mosi) values.set(pins_.mosi);
+    if (!csActive) values.set(pins_.cs);
+    return values;
+}
+
+bool SPIBitBang::init(uint8_t /*bus*/, uint8_t /*cs*/, const uint32_t speed, const SPIMode mode)
+{
+    std::lock_guard<std::mutex> lock(spiMutex_);
+
+    if (gpio_ == nullptr) return false;
+
+    PinMask outputs;
+    outputs.set(pins_.sclk).set(pins_.mosi).set(pins_.cs);
+    if (outputs.count() != 3 || outputs.test(pins_.miso)) return false;
+
+    applyMode(mode);
+    clock_.setFrequency(speed);
+
+    if (!gpio_->setDirectionMask(outputs, PinDirection::OUTPUT)) return false;
+    if (!gpio_->setDirection(pins_.miso, PinDirection::INPUT)) return false;
+    if (!gpio_->writeMask(outputs, lineValues(cpol_, false, false))) return false;
+
+    if (resourceId_ == 0)
+    {
+        // The bus is torn down before the pins it drives
+        std::vector<uint64_t> pinIds;
+        for (const uint8_t pin : {pins_.sclk, pins_.mosi, pins_.miso, pins_.cs})
+        {
+            if (const uint64_t pinId = gpio_->getResourceId(pin); pinId != 0) pinIds.push_back(pinId);
+        }
+
+        resourceId_ = ResourceManager::getInstance().registerResource(
+            ResourceType::SPI_BUS,
+            "gpio-spi:" + std::to_string(pins_.sclk) + "," + std::to_string(pins_.mosi) + "," +
+                std::to_string(pins_.miso) + "," + std::to_string(pins_.cs),
+            gpio_.get(),
+            pinIds
+        );
+    }
+    ResourceManager::getInstance().setInUse(resourceId_, true);
+
+    initialized_ = true;
+    return true;
+}
+
+bool SPIBitBang::shift(const std::vector<uint8_t>& txData, std::vector<uint8_t>* rxData)
+{
+    PinMask sclkMask;
+    sclkMask.set(pins_.sclk);
+    PinMask csMask;
+    csMask.set(pins_.cs);
+    PinMask clockData = sclkMask;
+    clockData.set(pins_.mosi);
+    const PinMask clockDataCs = clockData | csMask;
+
+    const bool idle = cpol_;
+    const bool active = !cpol_;
+
+    if (rxData != nullptr) rxData->assign(txData.size(), 0);
+
+    bool success = true;
+    clock_.start();
+
+    // With CPHA=1 the first leading edge already shifts data, chip select needs a phase of its own
+    if (cpha_)
+    {
+        success = gpio_->writeMask(csMask, lineValues(idle, false, true));
+        clock_.waitHalfPeriod();
+    }
+
+    for (size_t i = 0; i < txData.size() && success; ++i)
+    {
+        uint8_t received = 0;
+
+        for (int bit = 7; bit >= 0 && success; --bit)
+        {
+            const bool mosi = ((txData[i] >> bit) & 1) != 0;
+
+            if (!cpha_)
+            {
+                // Data changes with the trailing edge, the very first bit with chip select instead
+                const bool first = i == 0 && bit == 7;
+                success = gpio_->writeMask(first ? clockDataCs : clockData, lineValues(idle, mosi, true));
+                clock_.waitHalfPeriod();
+                success = success && gpio_->writeMask(sclkMask, lineValues(active, mosi, true));
+            }
+            else
+            {
+                success = gpio_->writeMask(clockData, lineValues(active, mosi, true));
+                clock_.waitHalfPeriod();
+                success = success && gpio_->writeMask(sclkMask, lineValues(idle, mosi, true));
+            }
+
+            // Sampled on the second edge of the bit, the slave changed MISO on the edge before
+            if (rxData != nullptr && gpio_->read(pins_.miso) == PinValue::HIGH)
+            {
+                received |= static_cast<uint8_t>(1u << bit);
+            }
+            clock_.waitHalfPeriod();
+        }
+
+        if (rxData != nullptr) (*rxData)[i] = received;
+    }
+
+    // Release chip select even after a failed edge, with CPHA=0 together with the last trailing edge
+    const bool released = gpio_->writeMask(cpha_ ? csMask : sclkMask | csMask, lineValues(idle, false, false));
+    return success && released;
+}
+
+bool SPIBitBang::finishTransfer(std::unique_lock<std::mutex>& lock, const bool result, const size_t length) const
+{
+    const uint64_t resourceId = resourceId_;
+    lock.unlock();
+
+    CallbackManager::getInstance().publishEvent(ResourceType::SPI_BUS, resourceId,
+                                                result ? HALEventKind::TRANSFER_COMPLETE : HALEventKind::IO_ERROR,
+                                                length);
+    return result;
+}
+
+bool SPIBitBang::transfer(const std::vector<uint8_t>& txData, std::vector<uint8_t>& rxData)
+{
+    std::unique_lock<std::mutex> lock(spiMutex_);
+
+    if (!initialized_) return false;
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = shift(txData, &rxData);
+    timer.finish(result ? txData.size() : 0, result);
+    return finishTransfer(lock, result, txData.size());
+}
+
+bool SPIBitBang::write(const std::vector<uint8_t>& data)
+{
+    std::unique_lock<std::mutex> lock(spiMutex_);
+
+    if (!initialized_) return false;
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = shift(data, nullptr);
+    timer.finish(result ? data.size() : 0, result);
+    return finishTransfer(lock, result, data.size());
+}
+
+bool SPIBitBang::read(std::vector<uint8_t>& data, const size_t length)
+{
+    std::unique_lock<std::mutex> lock(spiMutex_);
+
+    if (!initialized_ || length == 0) return false;
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = shift(std::vector<uint8_t>(length, 0), &data);
+    timer.finish(result ? length : 0, result);
+    return finishTransfer(lock, result, length);
+}
+
+bool SPIBitBang::setSpeed(const uint32_t speed)
+{
+    std::lock_guard<std::mutex> lock(spiMutex_);
+
+    if (!initialized_) return false;
+    clock_.setFrequency(speed);
+    return true;
+}
+
+bool SPIBitBang::setMode(const SPIMode mode)
+{
+    std::lock_guard<std::mutex> lock(spiMutex_);
+
+    if (!initialized_) return false;
+    applyMode(mode);
+
+    PinMask sclkMask;
+    sclkMask.set(pins_.sclk);
+    return gpio_->writeMask(sclkMask, lineValues(cpol_, false, false));
+}
+
+uint64_t SPIBitBang::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(spiMutex_);
+    return resourceId_;
+}
@@ -0,0 +1,136 @@
+#ifndef MEX_HAL_SPI_BITBANG_H
+#define MEX_HAL_SPI_BITBANG_H
+
+#include "../../include/hal/spi.h"
+#include "../../include/hal/gpio.h"
+#include "../../include/hal/resource_manager.h"
+#include "../bitbang_clock/bitbang_clock.h"
+#include <memory>
+#include <mutex>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief SPI master bit-banged on GPIO lines \class SPIBitBang
+     *
+     * Every clock edge that moves data is one writeMask() carrying SCLK and MOSI
+     * together, chip select is folded into the first or last edge where the mode
+     * allows it. On the character device backend that is one GPIO_V2_LINE_SET_VALUES
+     * ioctl per edge; sysfs still writes one persistent value fd per changed line.
+     * MISO is sampled with read() only for transfers that return data. Bits are
+     * shifted MSB first in all four SPI modes, the clock is paced by BitBangClock.
+     */
+    class SPIBitBang final : public SPIInterface
+    {
+    private:
+        std::shared_ptr<GPIOInterface> gpio_;
+        SoftSPIPins pins_;
+        BitBangClock clock_;
+        bool cpol_ = false;
+        bool cpha_ = false;
+        bool initialized_ = false;
+        uint64_t resourceId_ = 0;
+        mutable std::mutex spiMutex_;
+
+        /**
+         * @brief Apply the clock polarity and phase of a mode
+         * @param mode The SPI mode
+         */
+        void applyMode(SPIMode mode);
+
+        /**
+         * @brief Release the bus lock and publish the outcome of a transfer on the event bus
+         * @param lock The held bus lock
+         * @param result The transfer result
+         * @param length The number of bytes transferred
+         * @return The transfer result
+         */
+        bool finishTransfer(std::unique_lock<std::mutex>& lock, bool result, size_t length) const;
+
+        /**
+         * @brief Build the writeMask() values for the bus lines
+         * @param sclk The SCLK level
+         * @param mosi The MOSI level
+         * @param csActive A true to drive chip select low
+         * @return The pin values, bits outside the written mask are ignored
+         */
+        [[nodiscard]] PinMask lineValues(bool sclk, bool mosi, bool csActive) const;
+
+        /**
+         * @brief Clock bytes through the bus with chip select asserted
+         * @param txData The bytes to shift out
+         * @param rxData The buffer for the sampled bytes, nullptr to skip sampling MISO
+         * @return A true if every GPIO call succeeded, false otherwise
+         */
+        bool shift(const std::vector<uint8_t>& txData, std::vector<uint8_t>* rxData);
+
+    public:
+        /**
+         * @brief Constructor
+         * @param gpio The GPIO controller driving the lines, may be shared with other users
+         * @param pins The SCLK, MOSI, MISO and chip select lines
+         */
+        SPIBitBang(std::shared_ptr<GPIOInterface> gpio, const SoftSPIPins& pins);
+
+        /**
+         * @brief Destructor
+         */
+        ~SPIBitBang() override;
+
+        /**
+         * @brief Configure the lines and idle the bus
+         * @param bus Ignored, the bus is defined by the GPIO lines
+         * @param cs Ignored, chip select is the GPIO line given at construction
+         * @param speed The SPI clock speed in Hz, 0 for the fastest rate the GPIO backend sustains
+         * @param mode The SPI mode (clock polarity and phase)
+         * @return A true if initialization was successful, false otherwise
+         */
+        bool init(uint8_t bus, uint8_t cs, uint32_t speed, SPIMode mode) override;
+
+        /**
+         * @brief Transfer data over SPI (full-duplex)
+         * @param txData The data to transmit
+         * @param rxData The buffer to store received data
+         * @return A true if the transfer was successful, false otherwise
+         */
+        bool transfer(const std::vector<uint8_t>& txData, std::vector<uint8_t>& rxData) override;
+
+        /**
+         * @brief Write data to the SPI bus without sampling MISO
+         * @param data The data to write
+         * @return A true if the data was successfully written, false otherwise
+         */
+        bool write(const std::vector<uint8_t>& data) override;
+
+        /**
+         * @brief Read data from the SPI bus while shifting out zeros
+         * @param data The buffer to store read data
+         * @param length The number of bytes to read
+         * @return A true if the data was successfully read, false otherwise
+         */
+        bool read(std::vector<uint8_t>& data, size_t length) override;
+
+        /**
+         * @brief Set the SPI clock speed
+         * @param speed The SPI clock speed in Hz, 0 for no pacing
+         * @return A true if the speed was successfully set, false otherwise
+         */
+        bool setSpeed(uint32_t speed) override;
+
+        /**
+         * @brief Set the SPI mode and move SCLK to its new idle level
+         * @param mode The SPI mode
+         * @return A true if the mode was successfully set, false otherwise
+         */
+        bool setMode(SPIMode mode) override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
+    };
+}
+
+#endif //MEX_HAL_SPI_BITBANG_H
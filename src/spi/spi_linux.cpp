@@ -1,4 +1,5 @@
 #include "spi_linux.h"
+#include "../../include/hal/callback_manager.h"
 
 using namespace mex_hal;
 
@@ -60,9 +61,20 @@ bool SPILinux::init(const uint8_t bus, const uint8_t cs, uint32_t speed, SPIMode
     return true;
 }
 
+bool SPILinux::finishTransfer(std::unique_lock<std::mutex>& lock, const bool result, const size_t length) const
+{
+    const uint64_t resourceId = resourceId_;
+    lock.unlock();
+
+    CallbackManager::getInstance().publishEvent(ResourceType::SPI_BUS, resourceId,
+                                                result ? HALEventKind::TRANSFER_COMPLETE : HALEventKind::IO_ERROR,
+                                                length);
+    return result;
+}
+
 bool SPILinux::transfer(const std::vector<uint8_t> &txData, std::vector<uint8_t> &rxData)
 {
-    std::lock_guard<std::mutex> lock(spiMutex_);
+    std::unique_lock<std::mutex> lock(spiMutex_);
 
     if (!fd_.isValid()) return false;
 
@@ -79,7 +91,10 @@ bool SPILinux::transfer(const std::vector<uint8_t> &txData, std::vector<uint8_t>
         .pad = 0
     };
 
-    return ioctl(fd_.get(), SPI_IOC_MESSAGE(1), &tr) >= 0;
+    const ResourceIoTimer timer(resourceId_);
+    const bool result = ioctl(fd_.get(), SPI_IOC_MESSAGE(1), &tr) >= 0;
+    timer.finish(result ? txData.size() : 0, result);
+    return finishTransfer(lock, result, txData.size());
 }
 
 bool SPILinux::write(const std::vector<uint8_t> &data)
@@ -120,4 +135,10 @@ bool SPILinux::setMode(SPIMode mode)
     if (!fd_.isValid()) return false;
     auto spiMode = static_cast<uint8_t>(mode);
     return ioctl(fd_.get(), SPI_IOC_WR_MODE, &spiMode) >= 0;
-}
\ No newline at end of file
+}
+
+uint64_t SPILinux::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(spiMutex_);
+    return resourceId_;
+}
@@ -25,6 +25,15 @@ namespace mex_hal
         uint64_t resourceId_ = 0;
         mutable std::mutex spiMutex_;
 
+        /**
+         * @brief Release the bus lock and publish the outcome of a transfer on the event bus
+         * @param lock The held bus lock
+         * @param result The transfer result
+         * @param length The number of bytes transferred
+         * @return The transfer result
+         */
+        bool finishTransfer(std::unique_lock<std::mutex>& lock, bool result, size_t length) const;
+
     public:
         /**
          * @brief Constructor
@@ -82,6 +91,12 @@ namespace mex_hal
          * @return A true if the mode was successfully set, false otherwise
          */
         bool setMode(SPIMode mode) override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
     };
 }
 
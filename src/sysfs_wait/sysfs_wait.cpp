@@ -0,0 +1,47 @@
+#include "sysfs_wait.h"
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+using namespace mex_hal;
+
+bool SysfsWait::waitForNode(const std::string& path, const uint32_t timeoutMs) noexcept
+{
+    return waitForNodes({path}, timeoutMs);
+}
+
+bool SysfsWait::waitForNodes(const std::vector<std::string>& paths, const uint32_t timeoutMs) noexcept
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    std::vector<const std::string*> pending;
+    pending.reserve(paths.size());
+    for (const auto& path : paths)
+    {
+        pending.push_back(&path);
+    }
+
+    uint32_t backoffUs = kInitialBackoffUs;
+    for (;;)
+    {
+        // udev may create the node first and fix its permissions later
+        pending.erase(std::remove_if(pending.begin(), pending.end(), [](const std::string* path) {
+            return access(path->c_str(), R_OK | W_OK) == 0;
+        }), pending.end());
+
+        if (pending.empty())
+        {
+            return true;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            return false;
+        }
+
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+            std::chrono::microseconds(backoffUs), deadline - now));
+        backoffUs = std::min(backoffUs * 2, kMaxBackoffUs);
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef MEX_HAL_SYSFS_WAIT_H
+#define MEX_HAL_SYSFS_WAIT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief Waits for sysfs attribute nodes created asynchronously after an export
+     *
+     * sysfs does not raise inotify events for nodes the kernel creates, so readiness
+     * is polled with access(2) and an exponential backoff. Waiting for several nodes
+     * at once overlaps their latencies.
+     */
+    class SysfsWait
+    {
+    public:
+        static constexpr uint32_t DEFAULT_TIMEOUT_MS = 1000;
+
+        /**
+         * @brief Wait until a node exists and is readable and writable
+         * @param path The attribute path
+         * @param timeoutMs The maximum time to wait in milliseconds
+         * @return A true if the node became ready, false on timeout
+         */
+        static bool waitForNode(const std::string& path, uint32_t timeoutMs = DEFAULT_TIMEOUT_MS) noexcept;
+
+        /**
+         * @brief Wait until every node exists and is readable and writable
+         * @param paths The attribute paths
+         * @param timeoutMs The maximum time to wait for all nodes in milliseconds
+         * @return A true if all nodes became ready, false on timeout
+         */
+        static bool waitForNodes(const std::vector<std::string>& paths, uint32_t timeoutMs = DEFAULT_TIMEOUT_MS) noexcept;
+
+    private:
+        static constexpr uint32_t kInitialBackoffUs = 50;
+        static constexpr uint32_t kMaxBackoffUs = 2000;
+    };
+}
+
+#endif //MEX_HAL_SYSFS_WAIT_H
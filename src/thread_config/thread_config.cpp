@@ -0,0 +1,50 @@
+#include "thread_config.h"
+#include <sched.h>
+#include <unistd.h>
+
+using namespace mex_hal;
+
+bool ThreadConfig::isValid(const ThreadSchedule& schedule) noexcept
+{
+    if (schedule.priority < 0 || schedule.priority > sched_get_priority_max(SCHED_FIFO))
+    {
+        return false;
+    }
+
+    return schedule.cpu >= -1 && schedule.cpu < CPU_SETSIZE;
+}
+
+bool ThreadConfig::apply(const pthread_t thread, const ThreadSchedule& schedule) noexcept
+{
+    const bool priorityApplied = applyPriority(thread, schedule.priority);
+    const bool affinityApplied = applyAffinity(thread, schedule.cpu);
+    return priorityApplied && affinityApplied;
+}
+
+bool ThreadConfig::applyPriority(const pthread_t thread, const int32_t priority) noexcept
+{
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(thread, priority > 0 ? SCHED_FIFO : SCHED_OTHER, &param) == 0;
+}
+
+bool ThreadConfig::applyAffinity(const pthread_t thread, const int32_t cpu) noexcept
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+
+    if (cpu < 0)
+    {
+        const long count = sysconf(_SC_NPROCESSORS_CONF);
+        for (long i = 0; i < count && i < CPU_SETSIZE; ++i)
+        {
+            CPU_SET(i, &cpus);
+        }
+    }
+    else
+    {
+        CPU_SET(cpu, &cpus);
+    }
+
+    return pthread_setaffinity_np(thread, sizeof(cpus), &cpus) == 0;
+}
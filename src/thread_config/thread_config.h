@@ -0,0 +1,54 @@
+#ifndef MEX_HAL_THREAD_CONFIG_H
+#define MEX_HAL_THREAD_CONFIG_H
+
+#include <pthread.h>
+#include <cstdint>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /// @brief Scheduling parameters for HAL worker threads \struct ThreadSchedule
+    struct ThreadSchedule
+    {
+        int32_t priority = 0;   // 0 = SCHED_OTHER, 1..99 = SCHED_FIFO priority
+        int32_t cpu = -1;       // -1 = no CPU affinity
+    };
+
+    /// @brief Thread Configuration class, applies scheduling to HAL worker threads \class ThreadConfig
+    class ThreadConfig
+    {
+    public:
+        /**
+         * @brief Check that a schedule is within the range supported by the system
+         * @param schedule The schedule to check
+         * @return A true if the schedule is valid, false otherwise
+         */
+        [[nodiscard]] static bool isValid(const ThreadSchedule& schedule) noexcept;
+
+        /**
+         * @brief Apply priority and CPU affinity to a thread
+         * @param thread The native thread handle
+         * @param schedule The schedule to apply
+         * @return A true if both settings were applied, false otherwise
+         */
+        static bool apply(pthread_t thread, const ThreadSchedule& schedule) noexcept;
+
+        /**
+         * @brief Apply a scheduling priority to a thread
+         * @param thread The native thread handle
+         * @param priority 0 for SCHED_OTHER, otherwise the SCHED_FIFO priority
+         * @return A true if the priority was applied, false otherwise
+         */
+        static bool applyPriority(pthread_t thread, int32_t priority) noexcept;
+
+        /**
+         * @brief Pin a thread to a single CPU
+         * @param thread The native thread handle
+         * @param cpu The CPU index, -1 to allow all CPUs
+         * @return A true if the affinity was applied, false otherwise
+         */
+        static bool applyAffinity(pthread_t thread, int32_t cpu) noexcept;
+    };
+}
+
+#endif //MEX_HAL_THREAD_CONFIG_H
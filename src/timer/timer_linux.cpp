@@ -31,7 +31,11 @@ void TimerLinux::timerLoop()
             std::this_thread::sleep_for(microseconds(intervalUs));
         }
         
-        if (!shouldStop.load())
+        if (shouldStop.load())
+        {
+            break;
+        }
+
         {
             std::lock_guard<std::mutex> lock(callbackMutex);
             if (callback)
@@ -47,14 +51,51 @@ void TimerLinux::timerLoop()
         
         if (mode == TimerMode::PERIODIC)
         {
-            startTime = nextTick;
+            // One vDSO clock read per tick, the watchdog adds no system call
+            const uint64_t missed = checkDeadline(nextTick, steady_clock::now());
+            startTime = nextTick + missed * microseconds(intervalUs);
         }
     }
     
     running.store(false);
 }
 
-bool TimerLinux::start(const uint64_t interval, const TimerCallback cb)
+uint64_t TimerLinux::checkDeadline(const steady_clock::time_point nextTick, const steady_clock::time_point done)
+{
+    const uint64_t tick = ticks.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t responseNs =
+        done > nextTick ? static_cast<uint64_t>(duration_cast<nanoseconds>(done - nextTick).count()) : 0;
+    if (responseNs > maxResponseNs.load(std::memory_order_relaxed))
+    {
+        maxResponseNs.store(responseNs, std::memory_order_relaxed);
+    }
+
+    // The tick at nextTick + k * interval has passed for every k up to responseNs / interval,
+    // skipped whether or not the budget allows running that long
+    const uint64_t intervalNs = intervalUs * 1000;
+    const uint64_t missed = intervalNs != 0 ? responseNs / intervalNs : 0;
+    if (missed != 0)
+    {
+        missedPeriods.fetch_add(missed, std::memory_order_relaxed);
+    }
+
+    const uint64_t budgetNs = budgetUs != 0 ? budgetUs * 1000 : intervalNs;
+    if (budgetNs == 0 || responseNs <= budgetNs)
+    {
+        return missed;
+    }
+
+    overruns.fetch_add(1, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (overrunHandler)
+    {
+        overrunHandler(TimerOverrun{tick, responseNs, budgetNs, missed});
+    }
+    return missed;
+}
+
+bool TimerLinux::start(const uint64_t interval, TimerCallback cb)
 {
     if (running.load())
     {
@@ -62,10 +103,14 @@ bool TimerLinux::start(const uint64_t interval, const TimerCallback cb)
     }
     
     intervalUs = interval;
+    ticks.store(0, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+    missedPeriods.store(0, std::memory_order_relaxed);
+    maxResponseNs.store(0, std::memory_order_relaxed);
     
     {
         std::lock_guard<std::mutex> lock(callbackMutex);
-        callback = cb;
+        callback = std::move(cb);
     }
     
     shouldStop.store(false);
@@ -133,3 +178,26 @@ uint64_t TimerLinux::getCurrentTimeUs() const
     auto epoch = now.time_since_epoch();
     return static_cast<uint64_t>(duration_cast<microseconds>(epoch).count());
 }
+
+bool TimerLinux::setDeadlineBudget(const uint64_t budget, TimerOverrunCallback handler)
+{
+    if (running.load())
+    {
+        return false;
+    }
+
+    budgetUs = budget;
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    overrunHandler = std::move(handler);
+    return true;
+}
+
+TimerDeadlineStats TimerLinux::getDeadlineStats() const
+{
+    TimerDeadlineStats stats;
+    stats.ticks = ticks.load(std::memory_order_relaxed);
+    stats.overruns = overruns.load(std::memory_order_relaxed);
+    stats.missedPeriods = missedPeriods.load(std::memory_order_relaxed);
+    stats.maxResponseNs = maxResponseNs.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -22,11 +22,26 @@ namespace mex_hal
         TimerCallback callback;
         std::chrono::steady_clock::time_point startTime;
         std::mutex callbackMutex;
+        uint64_t budgetUs = 0;
+        TimerOverrunCallback overrunHandler;
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> overruns{0};
+        std::atomic<uint64_t> missedPeriods{0};
+        std::atomic<uint64_t> maxResponseNs{0};
 
         /**
          * @brief Timer loop function
          */
         void timerLoop();
+
+        /**
+         * @brief Account for the response time of a periodic tick
+         * @param nextTick The scheduled time of the tick
+         * @param done The end of its callback
+         * @return The number of following ticks that already passed
+         */
+        uint64_t checkDeadline(std::chrono::steady_clock::time_point nextTick,
+                               std::chrono::steady_clock::time_point done);
         
     public:
         /**
@@ -96,6 +111,20 @@ namespace mex_hal
          * @return The current time in microseconds
          */
         [[nodiscard]] uint64_t getCurrentTimeUs() const override;
+
+        /**
+         * @brief Set the execution budget of periodic callbacks, only while the timer is stopped
+         * @param budgetUs The budget in microseconds, 0 = the interval
+         * @param handler Called with each overrun, may be empty
+         * @return A true if the budget was set, false if the timer is running
+         */
+        bool setDeadlineBudget(uint64_t budgetUs, TimerOverrunCallback handler) override;
+
+        /**
+         * @brief Get the deadline statistics of periodic callbacks
+         * @return The statistics since the last start()
+         */
+        [[nodiscard]] TimerDeadlineStats getDeadlineStats() const override;
     };
 }
 
@@ -138,32 +138,54 @@ bool UARTLinux::configurePort(const UARTConfig& config)
     return true;
 }
 
+void UARTLinux::publishEvent(std::unique_lock<std::mutex>& lock, const HALEventKind kind, const size_t length) const
+{
+    const uint64_t resourceId = resourceId_;
+    lock.unlock();
+
+    CallbackManager::getInstance().publishEvent(ResourceType::UART_PORT, resourceId, kind, length);
+}
+
 bool UARTLinux::write(const std::vector<uint8_t>& data)
 {
-    std::lock_guard<std::mutex> lock(uartMutex_);
+    std::unique_lock<std::mutex> lock(uartMutex_);
 
     if (!fd_.isValid() || data.empty()) return false;
 
+    const ResourceIoTimer timer(resourceId_);
     const ssize_t bytesWritten = ::write(fd_.get(), data.data(), data.size());
-    return bytesWritten == static_cast<ssize_t>(data.size());
+    const bool result = bytesWritten == static_cast<ssize_t>(data.size());
+    timer.finish(bytesWritten > 0 ? static_cast<size_t>(bytesWritten) : 0, result);
+    publishEvent(lock, result ? HALEventKind::DATA_SENT : HALEventKind::IO_ERROR, data.size());
+    return result;
 }
 
 bool UARTLinux::read(std::vector<uint8_t>& data, size_t length)
 {
-    std::lock_guard<std::mutex> lock(uartMutex_);
+    std::unique_lock<std::mutex> lock(uartMutex_);
 
     if (!fd_.isValid() || length == 0) return false;
     
     data.resize(length);
+    const ResourceIoTimer timer(resourceId_);
     const ssize_t bytesRead = ::read(fd_.get(), data.data(), length);
 
+    // A read that times out without data is not an error of the port
+    timer.finish(bytesRead > 0 ? static_cast<size_t>(bytesRead) : 0, bytesRead >= 0);
+
     if (bytesRead > 0)
     {
         data.resize(static_cast<size_t>(bytesRead));
+        publishEvent(lock, HALEventKind::DATA_RECEIVED, data.size());
         return true;
     }
     
     data.clear();
+
+    if (bytesRead < 0)
+    {
+        publishEvent(lock, HALEventKind::IO_ERROR, length);
+    }
     return false;
 }
 
@@ -195,3 +217,9 @@ bool UARTLinux::setConfig(const UARTConfig& config)
     std::lock_guard<std::mutex> lock(uartMutex_);
     return configurePort(config);
 }
+
+uint64_t UARTLinux::getResourceId() const
+{
+    std::lock_guard<std::mutex> lock(uartMutex_);
+    return resourceId_;
+}
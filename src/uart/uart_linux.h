@@ -4,6 +4,7 @@
 #include "../../include/hal/uart.h"
 #include "../../include/hal/file_descriptor.h"
 #include "../../include/hal/resource_manager.h"
+#include "../../include/hal/callback_manager.h"
 #include <fcntl.h>
 #include <unistd.h>
 #include <termios.h>
@@ -25,6 +26,14 @@ namespace mex_hal
         uint64_t resourceId_ = 0;
         mutable std::mutex uartMutex_;
 
+        /**
+         * @brief Release the port lock and publish an event of the port on the event bus
+         * @param lock The held port lock
+         * @param kind What happened
+         * @param length The number of bytes moved or requested
+         */
+        void publishEvent(std::unique_lock<std::mutex>& lock, HALEventKind kind, size_t length) const;
+
         /**
          * @brief Configure the UART port with the specified settings
          * @param config The UART configuration
@@ -84,6 +93,12 @@ namespace mex_hal
          * @return A true if the configuration was successfully set, false otherwise
          */
         bool setConfig(const UARTConfig& config) override;
+
+        /**
+         * @brief Get the resource id the device is tracked and publishes events under
+         * @return The resource id, 0 while the device is not initialized
+         */
+        [[nodiscard]] uint64_t getResourceId() const override;
     };
 }
 
@@ -0,0 +1,51 @@
+#ifndef MEX_HAL_FAKE_SYSFS_H
+#define MEX_HAL_FAKE_SYSFS_H
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Test fixture with a fake GPIO sysfs tree in a temporary directory
+ *
+ * Minimal fake sysfs tree, export and unexport are plain files. Derived fixtures
+ * call createPin() from their SetUp() for the pins they use and pass root to GPIOLinux.
+ */
+class FakeSysfsTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char tmpl[] = "/tmp/mex_hal_gpio_XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl), nullptr);
+        root = tmpl;
+
+        std::ofstream(root / "export").close();
+        std::ofstream(root / "unexport").close();
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove_all(root);
+    }
+
+    /**
+     * @brief Create an exported input pin with a low value and no edge detection
+     * @param pin The GPIO pin number
+     */
+    void createPin(const uint8_t pin) const
+    {
+        const std::filesystem::path pinDir = root / ("gpio" + std::to_string(pin));
+        std::filesystem::create_directories(pinDir);
+        std::ofstream(pinDir / "value") << "0";
+        std::ofstream(pinDir / "direction") << "in";
+        std::ofstream(pinDir / "edge") << "none";
+    }
+
+    std::filesystem::path root;
+};
+
+#endif //MEX_HAL_FAKE_SYSFS_H
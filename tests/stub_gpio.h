@@ -0,0 +1,42 @@
+#ifndef MEX_HAL_STUB_GPIO_H
+#define MEX_HAL_STUB_GPIO_H
+
+#include <hal/gpio.h>
+
+/// @brief mex_hal Hardware Abstraction Layer \namespace mex_hal
+namespace mex_hal
+{
+    /**
+     * @brief GPIO controller for tests that accepts every pin operation and does nothing
+     *
+     * Configuration and writes succeed, reads return LOW, interrupts are not supported.
+     * Test fakes derive from it and override only the calls they model.
+     */
+    class StubGPIO : public GPIOInterface
+    {
+    public:
+        bool setDirection(uint8_t, PinDirection) override { return true; }
+        bool write(uint8_t, PinValue) override { return true; }
+        PinValue read(uint8_t) override { return PinValue::LOW; }
+        PinValue readback(uint8_t) override { return PinValue::LOW; }
+        bool toggle(uint8_t) override { return true; }
+        bool setDirectionMask(const PinMask&, PinDirection) override { return true; }
+        bool writeMask(const PinMask&, const PinMask&) override { return true; }
+        PinMask readMask(const PinMask&) override { return {}; }
+        bool setInterrupt(uint8_t, EdgeTrigger, InterruptCallback) override { return false; }
+        bool setInterrupt(uint8_t, EdgeTrigger, InterruptCallback, const EdgeRateLimit&) override { return false; }
+        EdgeRateStats getEdgeRateStats(uint8_t) const override { return {}; }
+        uint64_t getResourceId(uint8_t) const override { return 0; }
+        bool removeInterrupt(uint8_t) override { return false; }
+        bool enableEdgeEvents(uint8_t, EdgeTrigger) override { return false; }
+        GPIOEventQueue& getEdgeEventQueue() override { return queue_; }
+        bool setDebounce(uint8_t, uint32_t) override { return false; }
+        bool setInterruptThreadPriority(int32_t) override { return false; }
+        bool setInterruptThreadAffinity(int32_t) override { return false; }
+
+    private:
+        GPIOEventQueue queue_;
+    };
+}
+
+#endif //MEX_HAL_STUB_GPIO_H
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <hal/callback_manager.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr uint8_t kPin = 21;
+    constexpr uint32_t kTimerId = 7;
+    constexpr int kInvocations = 200000;
+    constexpr int kPublishes = 20000;
+
+    /// @brief The former dispatch: shared_mutex, id list copy and a lookup and std::function copy per callback
+    class LockedDispatch
+    {
+    public:
+        using Callback = std::function<void(uint8_t, PinValue)>;
+
+        void add(const uint64_t id, Callback callback)
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            callbacks_[id] = std::move(callback);
+            byPin_[kPin].push_back(id);
+        }
+
+        void invoke(const uint8_t pin, const PinValue value)
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            const auto it = byPin_.find(pin);
+            if (it == byPin_.end()) return;
+            const std::vector<uint64_t> ids = it->second;
+            lock.unlock();
+
+            for (const uint64_t id : ids)
+            {
+                std::shared_lock<std::shared_mutex> callbackLock(mutex_);
+                const auto callbackIt = callbacks_.find(id);
+                if (callbackIt == callbacks_.end()) continue;
+                auto callback = callbackIt->second;
+                callbackLock.unlock();
+                callback(pin, value);
+            }
+        }
+
+    private:
+        std::shared_mutex mutex_;
+        std::unordered_map<uint64_t, Callback> callbacks_;
+        std::unordered_map<uint8_t, std::vector<uint64_t>> byPin_;
+    };
+
+    template <typename Invoke>
+    double nsPerInvoke(Invoke&& invoke, const int invocations = kInvocations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < invocations; ++i)
+        {
+            invoke();
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / invocations;
+    }
+}
+
+class CallbackBenchmarkTest : public ::testing::TestWithParam<int>
+{
+protected:
+    void SetUp() override
+    {
+        CallbackManager::getInstance().clearAll();
+    }
+
+    void TearDown() override
+    {
+        CallbackManager::getInstance().clearAll();
+    }
+};
+
+TEST_P(CallbackBenchmarkTest, InvokeLatency)
+{
+    auto& cm = CallbackManager::getInstance();
+    const int subscribers = GetParam();
+    uint64_t gpioCalls = 0;
+    uint64_t timerCalls = 0;
+    uint64_t lockedCalls = 0;
+
+    LockedDispatch locked;
+    for (int i = 0; i < subscribers; ++i)
+    {
+        // Captures that fit the small buffer of std::function, as interrupt handlers usually do
+        cm.registerGPIOCallback(kPin, [&gpioCalls](uint8_t, PinValue) { ++gpioCalls; });
+        cm.registerTimerCallback(kTimerId, [&timerCalls]() { ++timerCalls; });
+        locked.add(static_cast<uint64_t>(i), [&lockedCalls](uint8_t, PinValue) { ++lockedCalls; });
+    }
+
+    // Other pins and timers make the tables realistic, they are never invoked
+    for (uint32_t other = 0; other < 16; ++other)
+    {
+        cm.registerGPIOCallback(static_cast<uint8_t>(other), [](uint8_t, PinValue) {});
+        cm.registerTimerCallback(100 + other, []() {});
+    }
+
+    const double lockedNs = nsPerInvoke([&] { locked.invoke(kPin, PinValue::HIGH); });
+    const double gpioNs = nsPerInvoke([&] { cm.invokeGPIOCallback(kPin, PinValue::HIGH); });
+    const double timerNs = nsPerInvoke([&] { cm.invokeTimerCallback(kTimerId); });
+
+    std::cout << "[ BENCH    ] " << subscribers << " subscribers, locked copy: " << lockedNs << " ns/invoke\n"
+              << "[ BENCH    ] " << subscribers << " subscribers, GPIO:        " << gpioNs << " ns/invoke\n"
+              << "[ BENCH    ] " << subscribers << " subscribers, timer:       " << timerNs << " ns/invoke\n";
+
+    const auto expected = static_cast<uint64_t>(kInvocations) * static_cast<uint64_t>(subscribers);
+    EXPECT_EQ(gpioCalls, expected);
+    EXPECT_EQ(timerCalls, expected);
+    EXPECT_EQ(lockedCalls, expected);
+}
+
+TEST_P(CallbackBenchmarkTest, PublishCostPerPeripheralType)
+{
+    auto& cm = CallbackManager::getInstance();
+    const int subscribers = GetParam();
+    uint64_t calls = 0;
+
+    const ResourceType types[] = {ResourceType::SPI_BUS, ResourceType::I2C_BUS, ResourceType::UART_PORT,
+                                  ResourceType::ADC_CHANNEL, ResourceType::PWM_CHANNEL};
+    for (const ResourceType type : types)
+    {
+        // Half follow the benchmarked device, half every device of the type, plus listeners of other devices
+        for (int i = 0; i < subscribers; ++i)
+        {
+            cm.registerEventCallback(type, i % 2 == 0 ? 1 : EventKey::ANY_SOURCE,
+                                     [&calls](const HALEvent&) { ++calls; });
+        }
+        for (uint64_t other = 2; other < 18; ++other)
+        {
+            cm.registerEventCallback(type, other, [](const HALEvent&) {});
+        }
+    }
+
+    for (const ResourceType type : types)
+    {
+        const double publishNs =
+            nsPerInvoke([&] { cm.publishEvent(type, 1, HALEventKind::TRANSFER_COMPLETE, 4); }, kPublishes);
+        const double unobservedNs =
+            nsPerInvoke([&] { cm.publishEvent(type, 99, HALEventKind::TRANSFER_COMPLETE, 4); }, kPublishes);
+        std::cout << "[ BENCH    ] " << subscribers << " subscribers, event type " << static_cast<int>(type) << ": "
+                  << publishNs << " ns/publish, " << unobservedNs << " ns/publish to the type listeners only\n";
+    }
+
+    // The unobserved source still reaches the type-wide subscribers
+    const auto anySource = static_cast<uint64_t>(subscribers / 2);
+    const auto perType = static_cast<uint64_t>(kPublishes) * (static_cast<uint64_t>(subscribers) + anySource);
+    EXPECT_EQ(calls, perType * 5);
+}
+
+TEST_P(CallbackBenchmarkTest, BatchedDeliveryCost)
+{
+    auto& cm = CallbackManager::getInstance();
+    const auto batchSize = static_cast<size_t>(GetParam());
+    uint64_t perEventSum = 0;
+    uint64_t batchedSum = 0;
+
+    // The parameter is the batch size here, the delay bound never expires during the run
+    cm.registerEventCallback(ResourceType::ADC_CHANNEL, 1, [&perEventSum](const HALEvent& event) {
+        perEventSum += event.value;
+    });
+    cm.registerEventBatchCallback(ResourceType::ADC_CHANNEL, 2, [&batchedSum](const HALEvent* events, size_t count) {
+        for (size_t i = 0; i < count; ++i)
+        {
+            batchedSum += events[i].value;
+        }
+    }, BatchConfig{batchSize, 60000000});
+
+    const double perEventNs =
+        nsPerInvoke([&] { cm.publishEvent(ResourceType::ADC_CHANNEL, 1, HALEventKind::SAMPLE, 1); }, kPublishes);
+    const double batchedNs =
+        nsPerInvoke([&] { cm.publishEvent(ResourceType::ADC_CHANNEL, 2, HALEventKind::SAMPLE, 1); }, kPublishes);
+    cm.flushBatches();
+
+    std::cout << "[ BENCH    ] per-event delivery:       " << perEventNs << " ns/sample\n"
+              << "[ BENCH    ] batches of " << batchSize << " samples: " << batchedNs << " ns/sample\n";
+
+    EXPECT_EQ(perEventSum, static_cast<uint64_t>(kPublishes));
+    EXPECT_EQ(batchedSum, static_cast<uint64_t>(kPublishes));
+}
+
+INSTANTIATE_TEST_SUITE_P(Subscribers, CallbackBenchmarkTest, ::testing::Values(1, 8, 64));
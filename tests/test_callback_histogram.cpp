@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include <hal/callback_histogram.h>
+#include <thread>
+#include <vector>
+
+using namespace mex_hal;
+
+TEST(CallbackHistogramTest, BucketsAreLogLinear)
+{
+    // Small values are exact, larger ones share buckets at most 12.5 % wide
+    for (uint64_t value = 0; value < 16; ++value)
+    {
+        EXPECT_EQ(CallbackHistogram::bucketUpperBound(CallbackHistogram::bucketIndex(value)), value);
+    }
+
+    for (const uint64_t value : {17ULL, 1000ULL, 123456ULL, 1ULL << 40, ~0ULL})
+    {
+        const size_t index = CallbackHistogram::bucketIndex(value);
+        ASSERT_LT(index, CallbackHistogram::BUCKETS);
+        const uint64_t upper = CallbackHistogram::bucketUpperBound(index);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(upper - value, value / 8);
+        EXPECT_EQ(CallbackHistogram::bucketIndex(upper), index);
+    }
+
+    EXPECT_EQ(CallbackHistogram::bucketIndex(~0ULL), CallbackHistogram::BUCKETS - 1);
+}
+
+TEST(CallbackHistogramTest, SummarizesPercentiles)
+{
+    CallbackHistogram histogram;
+    EXPECT_EQ(histogram.summary().count, 0u);
+
+    for (uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value * 1000);
+    }
+
+    const HistogramSummary summary = histogram.summary();
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_EQ(summary.maxNs, 1000000u);
+    EXPECT_EQ(summary.meanNs, 500500u);
+    EXPECT_EQ(summary.totalNs, 500500000u);
+
+    // Percentiles report the upper bound of their bucket, never below the exact value
+    EXPECT_GE(summary.p50Ns, 500000u);
+    EXPECT_LE(summary.p50Ns, 500000u + 500000u / 8);
+    EXPECT_GE(summary.p90Ns, 900000u);
+    EXPECT_GE(summary.p99Ns, 990000u);
+    EXPECT_LE(summary.p999Ns, summary.maxNs);
+    EXPECT_LE(summary.p50Ns, summary.p90Ns);
+    EXPECT_LE(summary.p90Ns, summary.p99Ns);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.summary().count, 0u);
+    EXPECT_EQ(histogram.summary().maxNs, 0u);
+}
+
+TEST(CallbackHistogramTest, ConcurrentRecording)
+{
+    CallbackHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&histogram, t]() {
+            for (uint64_t i = 0; i < 10000; ++i)
+            {
+                histogram.record(i + static_cast<uint64_t>(t) * 100000);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const HistogramSummary summary = histogram.summary();
+    EXPECT_EQ(summary.count, 40000u);
+    EXPECT_EQ(summary.maxNs, 309999u);
+}
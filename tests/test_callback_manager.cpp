@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 #include <hal/callback_manager.h>
+#include <hal/resource_visualizer.h>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
 
 using namespace mex_hal;
 
@@ -16,8 +20,20 @@ protected:
 
     void TearDown() override
     {
+        CallbackManager::getInstance().stopExecutor();
         CallbackManager::getInstance().clearAll();
     }
+
+    template <typename Predicate>
+    static bool waitFor(Predicate&& predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!predicate() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return predicate();
+    }
 };
 
 TEST_F(CallbackManagerTest, Singleton)
@@ -318,3 +334,594 @@ TEST_F(CallbackManagerTest, ThreadSafetyTimer)
     
     EXPECT_EQ(callCount, numThreads);
 }
+
+TEST_F(CallbackManagerTest, CallbackUnregistersItself)
+{
+    auto& cm = CallbackManager::getInstance();
+    std::atomic<int> callCount{0};
+    std::atomic<uint64_t> id{0};
+
+    id = cm.registerGPIOCallback(5, [&cm, &callCount, &id](uint8_t, PinValue) {
+        callCount++;
+        cm.unregisterGPIOCallback(id);
+    });
+
+    cm.invokeGPIOCallback(5, PinValue::HIGH);
+    cm.invokeGPIOCallback(5, PinValue::HIGH);
+
+    EXPECT_EQ(callCount, 1);
+    EXPECT_FALSE(cm.unregisterGPIOCallback(id));
+}
+
+TEST_F(CallbackManagerTest, InvokeDuringRegistrationChurn)
+{
+    auto& cm = CallbackManager::getInstance();
+    std::atomic<int> stableCount{0};
+    std::atomic<bool> running{true};
+    cm.registerGPIOCallback(3, [&stableCount](uint8_t, PinValue) {
+        stableCount++;
+    });
+
+    // Registrations replace the snapshot under the readers, the stable callback must never be skipped
+    std::thread churn([&cm, &running]() {
+        while (running)
+        {
+            const uint64_t gpioId = cm.registerGPIOCallback(3, [](uint8_t, PinValue) {});
+            const uint64_t timerId = cm.registerTimerCallback(1, []() {});
+            cm.unregisterGPIOCallback(gpioId);
+            cm.unregisterTimerCallback(timerId);
+        }
+    });
+
+    const int invocations = 20000;
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 2; ++t)
+    {
+        readers.emplace_back([&cm]() {
+            for (int i = 0; i < invocations; ++i)
+            {
+                cm.invokeGPIOCallback(3, PinValue::LOW);
+                cm.invokeTimerCallback(1);
+            }
+        });
+    }
+
+    for (auto& t : readers)
+    {
+        t.join();
+    }
+    running = false;
+    churn.join();
+
+    EXPECT_EQ(stableCount, 2 * invocations);
+}
+
+TEST_F(CallbackManagerTest, ExecutorRunsCallbacksOffEventThread)
+{
+    auto& cm = CallbackManager::getInstance();
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{}}));
+    EXPECT_EQ(cm.getExecutorWorkerCount(), 1u);
+
+    std::mutex mutex;
+    std::thread::id gpioThread;
+    std::thread::id timerThread;
+    std::atomic<int> callCount{0};
+    cm.registerGPIOCallback(4, [&](uint8_t pin, PinValue value) {
+        EXPECT_EQ(pin, 4);
+        EXPECT_EQ(value, PinValue::HIGH);
+        std::lock_guard<std::mutex> lock(mutex);
+        gpioThread = std::this_thread::get_id();
+        callCount++;
+    }, CallbackSchedule{0, -1});
+    cm.registerTimerCallback(9, [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        timerThread = std::this_thread::get_id();
+        callCount++;
+    }, CallbackSchedule{0, -1});
+
+    cm.invokeGPIOCallback(4, PinValue::HIGH);
+    cm.invokeTimerCallback(9);
+    ASSERT_TRUE(waitFor([&] { return callCount == 2; }));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_NE(gpioThread, std::this_thread::get_id());
+        EXPECT_EQ(gpioThread, timerThread);
+    }
+    EXPECT_TRUE(waitFor([&] { return cm.getExecutorStats(0).executed == 2; }));
+    EXPECT_EQ(cm.getExecutorStats(0).dropped, 0u);
+
+    // Without the executor the callbacks run on the dispatching thread again
+    cm.stopExecutor();
+    EXPECT_EQ(cm.getExecutorWorkerCount(), 0u);
+    cm.invokeGPIOCallback(4, PinValue::HIGH);
+    EXPECT_EQ(callCount, 3);
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(gpioThread, std::this_thread::get_id());
+}
+
+TEST_F(CallbackManagerTest, SlowBandDoesNotDelayHigherBand)
+{
+    auto& cm = CallbackManager::getInstance();
+
+    // SCHED_FIFO may be refused without privileges, the bands still get their own threads
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{0, -1, 64}, CallbackWorkerConfig{10, -1, 64}}));
+
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    std::atomic<int> loggingCalls{0};
+    std::atomic<int> safetyCalls{0};
+
+    cm.registerGPIOCallback(6, [&](uint8_t, PinValue) {
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&] { return release; });
+        loggingCalls++;
+    }, CallbackSchedule{0, -1});
+    cm.registerGPIOCallback(6, [&](uint8_t, PinValue) {
+        safetyCalls++;
+    }, CallbackSchedule{50, -1});
+
+    // The dispatching thread only queues, it returns while the logging callback blocks
+    for (int i = 0; i < 5; ++i)
+    {
+        cm.invokeGPIOCallback(6, PinValue::LOW);
+    }
+    EXPECT_TRUE(waitFor([&] { return safetyCalls == 5; }));
+    EXPECT_EQ(loggingCalls, 0);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    released.notify_all();
+    EXPECT_TRUE(waitFor([&] { return loggingCalls == 5; }));
+    EXPECT_EQ(cm.getExecutorStats(1).executed, 5u);
+}
+
+TEST_F(CallbackManagerTest, ScheduleSelectsBandOrEventThread)
+{
+    auto& cm = CallbackManager::getInstance();
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{0, -1, 64}, CallbackWorkerConfig{20, -1, 64}}));
+
+    const std::thread::id self = std::this_thread::get_id();
+    std::atomic<bool> inlineOnSelf{false};
+    cm.registerTimerCallback(1, [&]() { inlineOnSelf = std::this_thread::get_id() == self; });
+    cm.invokeTimerCallback(1);
+    EXPECT_TRUE(inlineOnSelf);
+
+    // Priorities between two workers belong to the lower one
+    std::atomic<int> lowBand{0};
+    std::atomic<int> highBand{0};
+    cm.registerTimerCallback(2, [&]() { lowBand++; }, CallbackSchedule{19, -1});
+    cm.registerTimerCallback(3, [&]() { highBand++; }, CallbackSchedule{99, -1});
+    cm.invokeTimerCallback(2);
+    cm.invokeTimerCallback(3);
+    EXPECT_TRUE(waitFor([&] { return lowBand == 1 && highBand == 1; }));
+    EXPECT_TRUE(waitFor([&] { return cm.getExecutorStats(0).executed == 1 && cm.getExecutorStats(1).executed == 1; }));
+
+    // The pin schedule applies to registrations without one, such as those of setInterrupt()
+    std::atomic<int> pinCalls{0};
+    cm.setGPIOCallbackSchedule(8, CallbackSchedule{25, -1});
+    cm.registerGPIOCallback(8, [&](uint8_t, PinValue) { pinCalls++; });
+    cm.invokeGPIOCallback(8, PinValue::HIGH);
+    EXPECT_TRUE(waitFor([&] { return pinCalls == 1; }));
+    EXPECT_TRUE(waitFor([&] { return cm.getExecutorStats(1).executed == 2; }));
+}
+
+TEST_F(CallbackManagerTest, ExecutorOverflowIsCounted)
+{
+    auto& cm = CallbackManager::getInstance();
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{0, -1, 4}}));
+
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    std::atomic<int> started{0};
+    std::atomic<int> callCount{0};
+    cm.registerGPIOCallback(2, [&](uint8_t, PinValue) {
+        started++;
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&] { return release; });
+        callCount++;
+    }, CallbackSchedule{0, -1});
+
+    // One event blocks the worker, four fill the ring and the rest are dropped
+    cm.invokeGPIOCallback(2, PinValue::HIGH);
+    ASSERT_TRUE(waitFor([&] { return started == 1; }));
+    for (int i = 0; i < 10; ++i)
+    {
+        cm.invokeGPIOCallback(2, PinValue::HIGH);
+    }
+    EXPECT_EQ(cm.getExecutorStats(0).queued, 4u);
+    EXPECT_EQ(cm.getExecutorStats(0).dropped, 6u);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    released.notify_all();
+
+    // Queued callbacks run before the workers stop
+    cm.stopExecutor();
+    EXPECT_EQ(callCount, 5);
+}
+
+TEST_F(CallbackManagerTest, ExecutorRejectsInvalidConfiguration)
+{
+    auto& cm = CallbackManager::getInstance();
+    EXPECT_FALSE(cm.startExecutor({}));
+    EXPECT_FALSE(cm.startExecutor({CallbackWorkerConfig{-1, -1, 16}}));
+    EXPECT_FALSE(cm.startExecutor({CallbackWorkerConfig{0, -2, 16}}));
+    EXPECT_FALSE(cm.startExecutor({CallbackWorkerConfig{0, -1, 0}}));
+    EXPECT_EQ(cm.getExecutorWorkerCount(), 0u);
+
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{}}));
+    EXPECT_FALSE(cm.startExecutor({CallbackWorkerConfig{}}));
+    EXPECT_EQ(cm.getExecutorStats(1).executed, 0u);
+}
+
+TEST_F(CallbackManagerTest, ProfilesLatencyAndExecutionTime)
+{
+    if (!CallbackManager::PROFILING_ENABLED)
+    {
+        GTEST_SKIP() << "Built without HAL_CALLBACK_PROFILING";
+    }
+
+    auto& cm = CallbackManager::getInstance();
+    const uint64_t slowId = cm.registerGPIOCallback(7, [](uint8_t, PinValue) {
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    });
+    const uint64_t fastId = cm.registerTimerCallback(3, []() {});
+
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    for (int i = 0; i < 5; ++i)
+    {
+        // An event detected 1 ms ago counts towards the dispatch latency
+        cm.invokeGPIOCallback(7, PinValue::HIGH, static_cast<uint64_t>(now) - 1000000);
+        cm.invokeTimerCallback(3);
+    }
+
+    CallbackProfile slow;
+    ASSERT_TRUE(cm.getCallbackProfile(slowId, slow));
+    EXPECT_EQ(slow.kind, CallbackKind::GPIO);
+    EXPECT_EQ(slow.source, 7u);
+    EXPECT_EQ(slow.execution.count, 5u);
+    EXPECT_GE(slow.execution.p50Ns, 500000u);
+    EXPECT_GE(slow.latency.p50Ns, 1000000u);
+    EXPECT_GE(slow.execution.maxNs, slow.execution.p99Ns);
+
+    CallbackProfile fast;
+    ASSERT_TRUE(cm.getCallbackProfile(fastId, fast));
+    EXPECT_EQ(fast.kind, CallbackKind::TIMER);
+    EXPECT_EQ(fast.execution.count, 5u);
+    EXPECT_EQ(cm.getCallbackProfiles().size(), 2u);
+
+    // The visualizer ranks callbacks by the execution time they used
+    ResourceVisualizer visualizer;
+    visualizer.gatherCallbackData();
+    const auto top = visualizer.getTopCallbacks(1);
+    ASSERT_EQ(top.size(), 1u);
+    EXPECT_EQ(top[0].callbackId, slowId);
+
+    cm.resetCallbackProfiles();
+    ASSERT_TRUE(cm.getCallbackProfile(slowId, slow));
+    EXPECT_EQ(slow.execution.count, 0u);
+    EXPECT_EQ(slow.latency.maxNs, 0u);
+
+    cm.unregisterGPIOCallback(slowId);
+    EXPECT_FALSE(cm.getCallbackProfile(slowId, slow));
+}
+
+TEST_F(CallbackManagerTest, ProfilesExecutorLatency)
+{
+    if (!CallbackManager::PROFILING_ENABLED)
+    {
+        GTEST_SKIP() << "Built without HAL_CALLBACK_PROFILING";
+    }
+
+    auto& cm = CallbackManager::getInstance();
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{}}));
+    std::atomic<int> callCount{0};
+    const uint64_t id = cm.registerTimerCallback(5, [&callCount]() { callCount++; }, CallbackSchedule{0, -1});
+
+    for (int i = 0; i < 20; ++i)
+    {
+        cm.invokeTimerCallback(5);
+    }
+    ASSERT_TRUE(waitFor([&] { return callCount == 20; }));
+    ASSERT_TRUE(waitFor([&] { return cm.getExecutorStats(0).executed == 20; }));
+
+    CallbackProfile profile;
+    ASSERT_TRUE(cm.getCallbackProfile(id, profile));
+    EXPECT_EQ(profile.latency.count, 20u);
+    EXPECT_EQ(profile.execution.count, 20u);
+    EXPECT_GT(profile.latency.maxNs, 0u);
+}
+
+TEST_F(CallbackManagerTest, EventBusRoutesByTypeAndSource)
+{
+    auto& cm = CallbackManager::getInstance();
+    std::vector<HALEvent> device;
+    std::vector<HALEvent> allSpi;
+    int uartCount = 0;
+
+    cm.registerEventCallback(ResourceType::SPI_BUS, 5, [&device](const HALEvent& event) { device.push_back(event); });
+    cm.registerEventCallback(ResourceType::SPI_BUS, EventKey::ANY_SOURCE,
+                             [&allSpi](const HALEvent& event) { allSpi.push_back(event); });
+    const uint64_t uartId = cm.registerEventCallback(ResourceType::UART_PORT, EventKey::ANY_SOURCE,
+                                                     [&uartCount](const HALEvent&) { uartCount++; });
+
+    cm.publishEvent(ResourceType::SPI_BUS, 5, HALEventKind::TRANSFER_COMPLETE, 16);
+    cm.publishEvent(ResourceType::SPI_BUS, 6, HALEventKind::IO_ERROR, 4);
+    cm.publishEvent(ResourceType::UART_PORT, 9, HALEventKind::DATA_RECEIVED, 3);
+    cm.publishEvent(ResourceType::I2C_BUS, 5, HALEventKind::TRANSFER_COMPLETE, 2, 0x50);
+
+    ASSERT_EQ(device.size(), 1u);
+    EXPECT_EQ(device[0].type, ResourceType::SPI_BUS);
+    EXPECT_EQ(device[0].source, 5u);
+    EXPECT_EQ(device[0].kind, HALEventKind::TRANSFER_COMPLETE);
+    EXPECT_EQ(device[0].value, 16u);
+    EXPECT_GT(device[0].timestampNs, 0u);
+
+    ASSERT_EQ(allSpi.size(), 2u);
+    EXPECT_EQ(allSpi[1].source, 6u);
+    EXPECT_EQ(allSpi[1].kind, HALEventKind::IO_ERROR);
+    EXPECT_EQ(uartCount, 1);
+
+    EXPECT_TRUE(cm.unregisterEventCallback(uartId));
+    EXPECT_FALSE(cm.unregisterEventCallback(uartId));
+    cm.publishEvent(ResourceType::UART_PORT, 9, HALEventKind::DATA_SENT, 1);
+    EXPECT_EQ(uartCount, 1);
+
+    cm.clearAll();
+    cm.publishEvent(ResourceType::SPI_BUS, 5, HALEventKind::TRANSFER_COMPLETE, 16);
+    EXPECT_EQ(device.size(), 1u);
+    EXPECT_EQ(allSpi.size(), 2u);
+}
+
+TEST_F(CallbackManagerTest, EventBusServesManySourcesFromOneWorker)
+{
+    auto& cm = CallbackManager::getInstance();
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{}}));
+
+    constexpr uint64_t SOURCES = 64;
+    std::mutex mutex;
+    std::set<uint64_t> sources;
+    std::set<std::thread::id> threads;
+    std::atomic<int> callCount{0};
+
+    // One subscription and one worker thread follow every ADC and PWM device
+    const auto record = [&](const HALEvent& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sources.insert(event.source);
+        threads.insert(std::this_thread::get_id());
+        callCount++;
+    };
+    cm.registerEventCallback(ResourceType::ADC_CHANNEL, EventKey::ANY_SOURCE, record, CallbackSchedule{0, -1});
+    cm.registerEventCallback(ResourceType::PWM_CHANNEL, EventKey::ANY_SOURCE, record, CallbackSchedule{0, -1});
+
+    for (uint64_t source = 1; source <= SOURCES; ++source)
+    {
+        cm.publishEvent(ResourceType::ADC_CHANNEL, source, HALEventKind::SAMPLE, source * 10, 2);
+        cm.publishEvent(ResourceType::PWM_CHANNEL, SOURCES + source, HALEventKind::OUTPUT_CHANGED, 500000);
+    }
+
+    ASSERT_TRUE(waitFor([&] { return callCount == static_cast<int>(2 * SOURCES); }));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(sources.size(), 2 * SOURCES);
+    ASSERT_EQ(threads.size(), 1u);
+    EXPECT_NE(*threads.begin(), std::this_thread::get_id());
+    EXPECT_EQ(cm.getExecutorStats(0).executed, 2 * SOURCES);
+}
+
+TEST_F(CallbackManagerTest, GPIOBatchDeliversFullBatchesInOrder)
+{
+    auto& cm = CallbackManager::getInstance();
+    std::vector<size_t> batchSizes;
+    std::vector<GPIOEdgeEvent> edges;
+
+    // A delay far beyond the test leaves only the size bound
+    const uint64_t id = cm.registerGPIOBatchCallback(12, [&](const GPIOEdgeEvent* events, const size_t count) {
+        batchSizes.push_back(count);
+        edges.insert(edges.end(), events, events + count);
+    }, BatchConfig{8, 60000000});
+
+    for (int i = 0; i < 20; ++i)
+    {
+        cm.invokeGPIOCallback(12, i % 2 == 0 ? PinValue::HIGH : PinValue::LOW);
+    }
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{8, 8}));
+
+    cm.flushBatches();
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{8, 8, 4}));
+    ASSERT_EQ(edges.size(), 20u);
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        EXPECT_EQ(edges[i].pin, 12);
+        EXPECT_EQ(edges[i].sequence, i);
+        EXPECT_EQ(edges[i].value, i % 2 == 0 ? PinValue::HIGH : PinValue::LOW);
+        EXPECT_GT(edges[i].timestampNs, 0u);
+    }
+
+    // Profiles count deliveries, not edges
+    CallbackProfile profile;
+    if (CallbackManager::PROFILING_ENABLED)
+    {
+        ASSERT_TRUE(cm.getCallbackProfile(id, profile));
+        EXPECT_EQ(profile.execution.count, 3u);
+        EXPECT_EQ(profile.latency.count, 3u);
+    }
+
+    // Unregistering delivers what is still pending
+    cm.invokeGPIOCallback(12, PinValue::HIGH);
+    EXPECT_TRUE(cm.unregisterGPIOCallback(id));
+    EXPECT_EQ(batchSizes.back(), 1u);
+    EXPECT_EQ(edges.size(), 21u);
+}
+
+TEST_F(CallbackManagerTest, GPIOBatchProducersNeverWaitForSlowSubscriber)
+{
+    auto& cm = CallbackManager::getInstance();
+    std::mutex mutex;
+    std::vector<GPIOEdgeEvent> edges;
+    std::vector<size_t> batchSizes;
+    std::atomic<bool> inDelivery{false};
+    std::atomic<bool> releaseDelivery{false};
+
+    const uint64_t id = cm.registerGPIOBatchCallback(13, [&](const GPIOEdgeEvent* events, const size_t count) {
+        inDelivery = true;
+        while (!releaseDelivery)
+        {
+            std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        batchSizes.push_back(count);
+        edges.insert(edges.end(), events, events + count);
+    }, BatchConfig{4, 60000000});
+
+    // The first full batch blocks its producer inside the subscriber
+    std::thread producer([&cm] {
+        for (int i = 0; i < 4; ++i)
+        {
+            cm.invokeGPIOCallback(13, PinValue::HIGH);
+        }
+    });
+    ASSERT_TRUE(waitFor([&] { return inDelivery.load(); }));
+
+    // Another full batch and three more edges return at once, the three are dropped
+    for (int i = 0; i < 7; ++i)
+    {
+        cm.invokeGPIOCallback(13, PinValue::LOW);
+    }
+    EXPECT_EQ(cm.getBatchDrops(id), 0u);
+
+    // The blocked producer delivers the waiting batch once its own delivery returns
+    releaseDelivery = true;
+    producer.join();
+    cm.invokeGPIOCallback(13, PinValue::HIGH);
+    cm.flushBatches();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{4, 4, 1}));
+    ASSERT_EQ(edges.size(), 9u);
+    EXPECT_EQ(edges[3].sequence, 3u);
+    EXPECT_EQ(edges[7].sequence, 7u);
+    EXPECT_EQ(edges[8].sequence, 11u);
+    EXPECT_EQ(cm.getBatchDrops(id), 3u);
+    EXPECT_TRUE(cm.unregisterGPIOCallback(id));
+}
+
+TEST_F(CallbackManagerTest, GPIOBatchOnWorkerKeepsCoalescedCount)
+{
+    auto& cm = CallbackManager::getInstance();
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{}}));
+
+    std::mutex mutex;
+    std::vector<GPIOEdgeEvent> edges;
+    std::thread::id deliveryThread;
+    cm.registerGPIOBatchCallback(14, [&](const GPIOEdgeEvent* events, const size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        deliveryThread = std::this_thread::get_id();
+        edges.insert(edges.end(), events, events + count);
+    }, BatchConfig{8, 0}, CallbackSchedule{0, -1});
+
+    // The collector runs on the worker, the count travels with the queued task
+    cm.invokeGPIOCallback(14, PinValue::HIGH, 1000, 5);
+    cm.invokeGPIOCallback(14, PinValue::LOW, 2000);
+    ASSERT_TRUE(waitFor([&] { std::lock_guard<std::mutex> lock(mutex); return edges.size() == 2; }));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_NE(deliveryThread, std::this_thread::get_id());
+    EXPECT_EQ(edges[0].coalesced, 5u);
+    EXPECT_EQ(edges[0].timestampNs, 1000u);
+    EXPECT_EQ(edges[1].coalesced, 0u);
+}
+
+TEST_F(CallbackManagerTest, EventBatchDelayBoundsLatency)
+{
+    auto& cm = CallbackManager::getInstance();
+    std::mutex mutex;
+    std::vector<HALEvent> received;
+    std::atomic<int> batches{0};
+    std::atomic<uint64_t> deliveredNs{0};
+    std::thread::id deliveryThread;
+
+    cm.registerEventBatchCallback(ResourceType::ADC_CHANNEL, EventKey::ANY_SOURCE,
+                                  [&](const HALEvent* events, const size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        received.insert(received.end(), events, events + count);
+        deliveryThread = std::this_thread::get_id();
+        deliveredNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        batches++;
+    }, BatchConfig{1024, 2000});
+
+    for (uint64_t sample = 0; sample < 5; ++sample)
+    {
+        cm.publishEvent(ResourceType::ADC_CHANNEL, 3, HALEventKind::SAMPLE, 100 + sample, 1);
+    }
+
+    ASSERT_TRUE(waitFor([&] { return batches == 1; }));
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(received.size(), 5u);
+    EXPECT_EQ(received[4].value, 104u);
+    EXPECT_NE(deliveryThread, std::this_thread::get_id());
+    EXPECT_GE(deliveredNs.load(), received[0].timestampNs + 2000000);
+}
+
+TEST_F(CallbackManagerTest, ZeroBatchDelayDeliversEveryEvent)
+{
+    auto& cm = CallbackManager::getInstance();
+    std::vector<size_t> batchSizes;
+
+    cm.registerEventBatchCallback(ResourceType::UART_PORT, 4, [&](const HALEvent*, const size_t count) {
+        batchSizes.push_back(count);
+    }, BatchConfig{64, 0});
+
+    cm.publishEvent(ResourceType::UART_PORT, 4, HALEventKind::DATA_RECEIVED, 10);
+    cm.publishEvent(ResourceType::UART_PORT, 4, HALEventKind::DATA_RECEIVED, 12);
+    EXPECT_EQ(batchSizes, (std::vector<size_t>{1, 1}));
+}
+
+TEST_F(CallbackManagerTest, BudgetCountsOverruns)
+{
+    auto& cm = CallbackManager::getInstance();
+    CallbackSchedule budget;
+    budget.budgetUs = 1000;
+
+    const uint64_t slowId = cm.registerTimerCallback(3, []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    }, budget);
+    const uint64_t fastId = cm.registerTimerCallback(3, []() {}, budget);
+    const uint64_t unboundedId = cm.registerTimerCallback(3, []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    });
+    const uint64_t batchId = cm.registerEventBatchCallback(ResourceType::ADC_CHANNEL, 2, [](const HALEvent*, size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    }, BatchConfig{2, 0}, budget);
+
+    cm.invokeTimerCallback(3);
+    cm.invokeTimerCallback(3);
+    for (int i = 0; i < 4; ++i)
+    {
+        cm.publishEvent(ResourceType::ADC_CHANNEL, 2, HALEventKind::SAMPLE, i);
+    }
+
+    EXPECT_EQ(cm.getCallbackOverruns(slowId), 2u);
+    EXPECT_EQ(cm.getCallbackOverruns(fastId), 0u);
+    EXPECT_EQ(cm.getCallbackOverruns(unboundedId), 0u);
+    EXPECT_EQ(cm.getCallbackOverruns(batchId), 4u);
+
+    CallbackProfile profile;
+    if (CallbackManager::PROFILING_ENABLED)
+    {
+        ASSERT_TRUE(cm.getCallbackProfile(slowId, profile));
+        EXPECT_EQ(profile.overruns, 2u);
+    }
+
+    cm.resetCallbackProfiles();
+    EXPECT_EQ(cm.getCallbackOverruns(slowId), 0u);
+    EXPECT_EQ(cm.getCallbackOverruns(batchId), 0u);
+}
@@ -89,3 +89,11 @@ TEST_F(GPIOTest, MultiplePins)
     EXPECT_NO_THROW(gpio->setDirection(27, PinDirection::INPUT));
     EXPECT_NO_THROW(gpio->write(17, PinValue::HIGH));
 }
+
+TEST_F(GPIOTest, MaskOnUnconfiguredPins)
+{
+    PinMask mask;
+    mask.set(17).set(27);
+    EXPECT_FALSE(gpio->writeMask(mask, mask));
+    EXPECT_TRUE(gpio->readMask(mask).none());
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "gpio/gpio_linux.h"
+#include "fake_sysfs.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mex_hal;
+namespace fs = std::filesystem;
+
+class GPIOBenchmarkTest : public FakeSysfsTest
+{
+protected:
+    static constexpr uint8_t kPin = 17;
+    static constexpr int kToggles = 20000;
+    static constexpr int kThreads = 4;
+
+    void SetUp() override
+    {
+        ASSERT_NO_FATAL_FAILURE(FakeSysfsTest::SetUp());
+        createPin(kPin);
+        for (uint8_t pin = 0; pin < kThreads; ++pin)
+        {
+            createPin(pin);
+        }
+    }
+
+    static double toggleRate(const std::chrono::steady_clock::duration elapsed)
+    {
+        const double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0.0 ? kToggles / seconds : 0.0;
+    }
+};
+
+TEST_F(GPIOBenchmarkTest, ToggleRatePersistentFdVsOfstream)
+{
+    const std::string valuePath = (root / ("gpio" + std::to_string(kPin)) / "value").string();
+
+    // Baseline: the former open/format/close per call
+    const auto legacyStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < kToggles; ++i)
+    {
+        std::ofstream valueFile(valuePath);
+        ASSERT_TRUE(valueFile.is_open());
+        valueFile << ((i & 1) ? "1" : "0");
+        valueFile.close();
+    }
+    const double legacyRate = toggleRate(std::chrono::steady_clock::now() - legacyStart);
+
+    GPIOLinux gpio(root.string());
+    ASSERT_TRUE(gpio.setDirection(kPin, PinDirection::OUTPUT));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kToggles; ++i)
+    {
+        ASSERT_TRUE(gpio.write(kPin, (i & 1) ? PinValue::HIGH : PinValue::LOW));
+    }
+    const double rate = toggleRate(std::chrono::steady_clock::now() - start);
+
+    std::cout << "[ BENCH    ] ofstream per call: " << static_cast<uint64_t>(legacyRate) << " toggles/s\n"
+              << "[ BENCH    ] persistent fd:     " << static_cast<uint64_t>(rate) << " toggles/s\n";
+
+    EXPECT_GT(rate, 0.0);
+    EXPECT_EQ(gpio.read(kPin), PinValue::HIGH);
+}
+
+TEST_F(GPIOBenchmarkTest, DirectionWrittenThroughPersistentFd)
+{
+    GPIOLinux gpio(root.string());
+    ASSERT_TRUE(gpio.setDirection(kPin, PinDirection::OUTPUT));
+
+    std::ifstream directionFile(root / ("gpio" + std::to_string(kPin)) / "direction");
+    std::string direction;
+    directionFile >> direction;
+    EXPECT_EQ(direction, "out");
+}
+
+TEST_F(GPIOBenchmarkTest, ContentionOnDistinctPins)
+{
+    GPIOLinux gpio(root.string());
+    for (uint8_t pin = 0; pin < kThreads; ++pin)
+    {
+        ASSERT_TRUE(gpio.setDirection(pin, PinDirection::OUTPUT));
+    }
+
+    std::atomic<bool> ok{true};
+    const auto run = [&](const int threads) {
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                const auto pin = static_cast<uint8_t>(t);
+                for (int i = 0; i < kToggles; ++i)
+                {
+                    if (!gpio.write(pin, (i & 1) ? PinValue::HIGH : PinValue::LOW)) ok = false;
+
+                    // Mixed traffic, a reader on one pin must not wait for writers on others
+                    if ((i & 7) == 0) gpio.read(pin);
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        return toggleRate(std::chrono::steady_clock::now() - start) * threads;
+    };
+
+    const double single = run(1);
+    const double contended = run(kThreads);
+
+    std::cout << "[ BENCH    ] 1 thread:              " << static_cast<uint64_t>(single) << " toggles/s\n"
+              << "[ BENCH    ] " << kThreads << " threads, own pins: " << static_cast<uint64_t>(contended) << " toggles/s\n";
+
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(gpio.read(0), PinValue::HIGH);
+}
@@ -0,0 +1,450 @@
+#include <gtest/gtest.h>
+#include <hal/core.h>
+#include <hal/callback_manager.h>
+#include "gpio/gpio_cdev.h"
+#include "monotonic_clock/monotonic_clock.h"
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+using namespace mex_hal;
+
+/// @brief In-memory gpiochip implementing the v2 line request ioctls
+class FakeGPIOChip : public GPIOCdevIo
+{
+public:
+    int openChip(const std::string&) override
+    {
+        return eventfd(0, EFD_CLOEXEC);
+    }
+
+    int ioctl(int, const unsigned long request, void* arg) override
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        switch (request)
+        {
+            case GPIO_V2_GET_LINE_IOCTL:
+            {
+                auto* req = static_cast<gpio_v2_line_request*>(arg);
+                int fds[2];
+                if (pipe2(fds, O_CLOEXEC) != 0) return -1;
+                eventWriteFd.reset(fds[1]);
+                req->fd = fds[0];
+                offsets.assign(req->offsets, req->offsets + req->num_lines);
+                config = req->config;
+                applyOutputValues();
+                ++lineRequests;
+                return 0;
+            }
+            case GPIO_V2_LINE_SET_CONFIG_IOCTL:
+                config = *static_cast<gpio_v2_line_config*>(arg);
+                ++configUpdates;
+                return 0;
+            case GPIO_V2_LINE_SET_VALUES_IOCTL:
+            {
+                const auto* values = static_cast<gpio_v2_line_values*>(arg);
+                for (size_t i = 0; i < offsets.size(); ++i)
+                {
+                    if (values->mask & (1ULL << i)) levels[offsets[i]] = (values->bits >> i) & 1;
+                }
+                ++setValuesCalls;
+                return 0;
+            }
+            case GPIO_V2_LINE_GET_VALUES_IOCTL:
+            {
+                auto* values = static_cast<gpio_v2_line_values*>(arg);
+                values->bits = 0;
+                for (size_t i = 0; i < offsets.size(); ++i)
+                {
+                    if ((values->mask & (1ULL << i)) && levels[offsets[i]]) values->bits |= 1ULL << i;
+                }
+                ++getValuesCalls;
+                return 0;
+            }
+            default:
+                errno = ENOTTY;
+                return -1;
+        }
+    }
+
+    void injectEdge(const uint32_t offset, const bool rising, const uint64_t timestampNs)
+    {
+        gpio_v2_line_event event{};
+        event.timestamp_ns = timestampNs;
+        event.id = rising ? GPIO_V2_LINE_EVENT_RISING_EDGE : GPIO_V2_LINE_EVENT_FALLING_EDGE;
+        event.offset = offset;
+        std::lock_guard<std::mutex> lock(mutex);
+        ASSERT_EQ(::write(eventWriteFd.get(), &event, sizeof(event)), static_cast<ssize_t>(sizeof(event)));
+    }
+
+    uint64_t flagsFor(const uint32_t offset)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const uint64_t bit = bitFor(offset);
+        for (uint32_t i = 0; i < config.num_attrs; ++i)
+        {
+            if (config.attrs[i].attr.id == GPIO_V2_LINE_ATTR_ID_FLAGS && (config.attrs[i].mask & bit))
+                return config.attrs[i].attr.flags;
+        }
+        return config.flags;
+    }
+
+    uint32_t debounceFor(const uint32_t offset)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const uint64_t bit = bitFor(offset);
+        for (uint32_t i = 0; i < config.num_attrs; ++i)
+        {
+            if (config.attrs[i].attr.id == GPIO_V2_LINE_ATTR_ID_DEBOUNCE && (config.attrs[i].mask & bit))
+                return config.attrs[i].attr.debounce_period_us;
+        }
+        return 0;
+    }
+
+    std::mutex mutex;
+    FileDescriptor eventWriteFd;
+    std::vector<uint32_t> offsets;
+    gpio_v2_line_config config{};
+    std::map<uint32_t, bool> levels;
+    int lineRequests = 0;
+    int configUpdates = 0;
+    int setValuesCalls = 0;
+    int getValuesCalls = 0;
+
+private:
+    uint64_t bitFor(const uint32_t offset) const
+    {
+        for (size_t i = 0; i < offsets.size(); ++i)
+        {
+            if (offsets[i] == offset) return 1ULL << i;
+        }
+        return 0;
+    }
+
+    void applyOutputValues()
+    {
+        for (uint32_t i = 0; i < config.num_attrs; ++i)
+        {
+            const auto& attr = config.attrs[i];
+            if (attr.attr.id != GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES) continue;
+            for (size_t line = 0; line < offsets.size(); ++line)
+            {
+                if (attr.mask & (1ULL << line)) levels[offsets[line]] = (attr.attr.values >> line) & 1;
+            }
+        }
+    }
+};
+
+class GPIOCdevTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        CallbackManager::getInstance().clearAll();
+        chip = std::make_shared<FakeGPIOChip>();
+        gpio = std::make_unique<GPIOCdev>("/dev/gpiochip-fake", chip);
+    }
+
+    void TearDown() override
+    {
+        gpio.reset();
+        CallbackManager::getInstance().clearAll();
+    }
+
+    template <typename Predicate>
+    static bool waitFor(Predicate predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!predicate())
+        {
+            if (std::chrono::steady_clock::now() > deadline) return false;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    std::shared_ptr<FakeGPIOChip> chip;
+    std::unique_ptr<GPIOCdev> gpio;
+};
+
+TEST_F(GPIOCdevTest, CreateThroughHAL)
+{
+    const auto hal = createHAL(HALType::LINUX);
+    EXPECT_NE(hal->createGPIO(GPIOBackend::CDEV), nullptr);
+    EXPECT_NE(hal->createGPIO(GPIOBackend::SYSFS), nullptr);
+}
+
+TEST_F(GPIOCdevTest, WriteAndReadUseOneIoctl)
+{
+    ASSERT_TRUE(gpio->setDirection(3, PinDirection::OUTPUT));
+    EXPECT_NE(chip->flagsFor(3) & GPIO_V2_LINE_FLAG_OUTPUT, 0u);
+
+    ASSERT_TRUE(gpio->write(3, PinValue::HIGH));
+    EXPECT_EQ(chip->setValuesCalls, 1);
+    EXPECT_TRUE(chip->levels[3]);
+
+    // Outputs are served from the shadow, readback asks the chip
+    EXPECT_EQ(gpio->read(3), PinValue::HIGH);
+    EXPECT_EQ(chip->getValuesCalls, 0);
+    EXPECT_EQ(gpio->readback(3), PinValue::HIGH);
+    EXPECT_EQ(chip->getValuesCalls, 1);
+}
+
+TEST_F(GPIOCdevTest, ToggleUsesOneIoctl)
+{
+    ASSERT_TRUE(gpio->setDirection(3, PinDirection::OUTPUT));
+
+    ASSERT_TRUE(gpio->toggle(3));
+    EXPECT_TRUE(chip->levels[3]);
+    ASSERT_TRUE(gpio->toggle(3));
+    EXPECT_FALSE(chip->levels[3]);
+
+    EXPECT_EQ(chip->setValuesCalls, 2);
+    EXPECT_EQ(chip->getValuesCalls, 0);
+    EXPECT_EQ(gpio->read(3), PinValue::LOW);
+
+    ASSERT_TRUE(gpio->setDirection(5, PinDirection::INPUT));
+    EXPECT_FALSE(gpio->toggle(5));
+    EXPECT_FALSE(gpio->toggle(9));
+}
+
+TEST_F(GPIOCdevTest, AddingLinesRecreatesRequestAndKeepsOutputs)
+{
+    ASSERT_TRUE(gpio->setDirection(3, PinDirection::OUTPUT));
+    ASSERT_TRUE(gpio->write(3, PinValue::HIGH));
+    ASSERT_TRUE(gpio->setDirection(5, PinDirection::INPUT));
+
+    EXPECT_EQ(chip->lineRequests, 2);
+    EXPECT_EQ(chip->offsets, (std::vector<uint32_t>{3, 5}));
+    EXPECT_TRUE(chip->levels[3]);
+    EXPECT_NE(chip->flagsFor(3) & GPIO_V2_LINE_FLAG_OUTPUT, 0u);
+    EXPECT_NE(chip->flagsFor(5) & GPIO_V2_LINE_FLAG_INPUT, 0u);
+}
+
+TEST_F(GPIOCdevTest, DirectionChangeUsesSetConfig)
+{
+    ASSERT_TRUE(gpio->setDirection(3, PinDirection::INPUT));
+    ASSERT_TRUE(gpio->setDirection(3, PinDirection::OUTPUT));
+
+    EXPECT_EQ(chip->lineRequests, 1);
+    EXPECT_EQ(chip->configUpdates, 1);
+}
+
+TEST_F(GPIOCdevTest, UnknownLineFails)
+{
+    EXPECT_FALSE(gpio->write(9, PinValue::HIGH));
+    EXPECT_EQ(gpio->read(9), PinValue::LOW);
+    EXPECT_FALSE(gpio->removeInterrupt(9));
+}
+
+TEST_F(GPIOCdevTest, EdgeEventCarriesKernelTimestamp)
+{
+    std::atomic<int> calls{0};
+    std::atomic<bool> high{false};
+
+    ASSERT_TRUE(gpio->setInterrupt(5, EdgeTrigger::BOTH, [&](uint8_t, const PinValue value) {
+        high = value == PinValue::HIGH;
+        ++calls;
+    }));
+    EXPECT_EQ(chip->flagsFor(5) & (GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING),
+              GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING);
+
+    chip->injectEdge(5, true, 123456789);
+    ASSERT_TRUE(waitFor([&] { return calls.load() == 1; }));
+    EXPECT_TRUE(high);
+    EXPECT_EQ(gpio->getLastEventTimestampNs(5), 123456789u);
+}
+
+TEST_F(GPIOCdevTest, EventsSurviveRequestRecreation)
+{
+    std::atomic<int> calls{0};
+    ASSERT_TRUE(gpio->setInterrupt(5, EdgeTrigger::FALLING, [&](uint8_t, PinValue) { ++calls; }));
+
+    // Adding a line while the event thread is polling swaps the request descriptor
+    ASSERT_TRUE(gpio->setDirection(6, PinDirection::OUTPUT));
+    EXPECT_EQ(chip->lineRequests, 2);
+
+    chip->injectEdge(5, false, 42);
+    ASSERT_TRUE(waitFor([&] { return calls.load() == 1; }));
+}
+
+TEST_F(GPIOCdevTest, RemoveInterruptClearsEdgeFlags)
+{
+    ASSERT_TRUE(gpio->setInterrupt(5, EdgeTrigger::RISING, [](uint8_t, PinValue) {}));
+    ASSERT_TRUE(gpio->removeInterrupt(5));
+
+    EXPECT_EQ(chip->flagsFor(5) & (GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING), 0u);
+    EXPECT_FALSE(gpio->removeInterrupt(5));
+}
+
+TEST_F(GPIOCdevTest, DebounceUsesKernelAttribute)
+{
+    ASSERT_TRUE(gpio->setDirection(5, PinDirection::INPUT));
+    ASSERT_TRUE(gpio->setDebounce(5, 10));
+    EXPECT_EQ(chip->debounceFor(5), 10000u);
+}
+
+TEST_F(GPIOCdevTest, WriteMaskUpdatesBusWithOneIoctl)
+{
+    PinMask bus;
+    for (uint8_t pin = 8; pin < 16; ++pin)
+    {
+        ASSERT_TRUE(gpio->setDirection(pin, PinDirection::OUTPUT));
+        bus.set(pin);
+    }
+
+    PinMask values;
+    values.set(8).set(10).set(15);
+    ASSERT_TRUE(gpio->writeMask(bus, values));
+
+    EXPECT_EQ(chip->setValuesCalls, 1);
+    for (uint8_t pin = 8; pin < 16; ++pin)
+    {
+        EXPECT_EQ(chip->levels[pin], values.test(pin)) << "pin " << static_cast<int>(pin);
+    }
+
+    EXPECT_EQ(gpio->readMask(bus), values);
+    EXPECT_EQ(chip->getValuesCalls, 0);
+
+    // Inputs in the mask are still sampled with one GET_VALUES
+    ASSERT_TRUE(gpio->setDirection(20, PinDirection::INPUT));
+    chip->levels[20] = true;
+    bus.set(20);
+    values.set(20);
+    EXPECT_EQ(gpio->readMask(bus), values);
+    EXPECT_EQ(chip->getValuesCalls, 1);
+}
+
+TEST_F(GPIOCdevTest, WriteMaskRejectsUnknownLine)
+{
+    ASSERT_TRUE(gpio->setDirection(3, PinDirection::OUTPUT));
+
+    PinMask mask;
+    mask.set(3).set(4);
+    EXPECT_FALSE(gpio->writeMask(mask, mask));
+    EXPECT_EQ(chip->setValuesCalls, 0);
+}
+
+TEST_F(GPIOCdevTest, EdgeEventsQueuedWithKernelTimestamp)
+{
+    std::atomic<int> calls{0};
+    ASSERT_TRUE(gpio->setInterrupt(5, EdgeTrigger::BOTH, [&](uint8_t, PinValue) { ++calls; }));
+    ASSERT_TRUE(gpio->enableEdgeEvents(5, EdgeTrigger::BOTH));
+
+    chip->injectEdge(5, true, 1000);
+    chip->injectEdge(5, false, 2500);
+
+    GPIOEventQueue& queue = gpio->getEdgeEventQueue();
+    ASSERT_TRUE(waitFor([&] { return queue.size() == 2; }));
+
+    GPIOEdgeEvent events[4];
+    ASSERT_EQ(queue.drain(events, 4), 2u);
+    EXPECT_EQ(events[0].pin, 5);
+    EXPECT_EQ(events[0].value, PinValue::HIGH);
+    EXPECT_EQ(events[0].timestampNs, 1000u);
+    EXPECT_EQ(events[1].value, PinValue::LOW);
+    EXPECT_EQ(events[1].timestampNs - events[0].timestampNs, 1500u);
+    EXPECT_EQ(events[1].sequence, events[0].sequence + 1);
+
+    // Queue mode replaces the callback
+    EXPECT_EQ(calls.load(), 0);
+    ASSERT_TRUE(gpio->removeInterrupt(5));
+}
+
+TEST_F(GPIOCdevTest, SetDirectionMaskRequestsLinesOnce)
+{
+    PinMask bus;
+    for (uint8_t pin = 8; pin < 16; ++pin)
+    {
+        bus.set(pin);
+    }
+
+    ASSERT_TRUE(gpio->setDirectionMask(bus, PinDirection::OUTPUT));
+    EXPECT_EQ(chip->lineRequests, 1);
+    EXPECT_EQ(chip->offsets.size(), 8u);
+    EXPECT_NE(chip->flagsFor(12) & GPIO_V2_LINE_FLAG_OUTPUT, 0u);
+
+    ASSERT_TRUE(gpio->setDirectionMask(bus, PinDirection::INPUT));
+    EXPECT_EQ(chip->lineRequests, 1);
+    EXPECT_EQ(chip->configUpdates, 1);
+}
+
+TEST_F(GPIOCdevTest, StormDisablesEdgeDetectionUntilRearm)
+{
+    std::atomic<int> calls{0};
+    std::atomic<int> lastValue{-1};
+    EdgeRateLimit limit;
+    limit.maxEvents = 2;
+    limit.windowMs = 50;
+    limit.disableDuringStorm = true;
+    limit.rearmMs = 30;
+    ASSERT_TRUE(gpio->setInterrupt(5, EdgeTrigger::BOTH, [&](uint8_t, const PinValue value)
+    {
+        lastValue = static_cast<int>(value);
+        ++calls;
+    }, limit));
+
+    // Ten edges in 10 us, the last delivered one is falling
+    const uint64_t startNs = monotonicNs();
+    for (int i = 0; i < 10; ++i)
+    {
+        chip->injectEdge(5, i % 2 == 0, startNs + i * 1000);
+    }
+
+    ASSERT_TRUE(waitFor([&] { return gpio->getEdgeRateStats(5).dropped == 8; }));
+    EXPECT_EQ(calls.load(), 2);
+    EXPECT_EQ(chip->flagsFor(5) & (GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING), 0u);
+
+    // The line went high while detection was off, re-arming reports it
+    {
+        std::lock_guard<std::mutex> lock(chip->mutex);
+        chip->levels[5] = true;
+    }
+    ASSERT_TRUE(waitFor([&] { return !gpio->getEdgeRateStats(5).disabled && calls.load() == 3; }));
+    EXPECT_EQ(lastValue.load(), static_cast<int>(PinValue::HIGH));
+    EXPECT_NE(chip->flagsFor(5) & GPIO_V2_LINE_FLAG_EDGE_RISING, 0u);
+    EXPECT_NE(chip->flagsFor(5) & GPIO_V2_LINE_FLAG_EDGE_FALLING, 0u);
+    EXPECT_EQ(gpio->getEdgeRateStats(5).storms, 1u);
+}
+
+TEST_F(GPIOCdevTest, CoalescedEdgesDeliverLatestValue)
+{
+    std::mutex mutex;
+    std::vector<PinValue> values;
+    std::vector<uint32_t> coalesced;
+    EdgeRateLimit limit;
+    limit.maxEvents = 1;
+    limit.windowMs = 20;
+    limit.mode = EdgeRateMode::COALESCE;
+    ASSERT_TRUE(gpio->setInterrupt(6, EdgeTrigger::BOTH, [&](uint8_t, const PinValue value)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        values.push_back(value);
+    }, limit));
+
+    // Batch subscribers see how many edges each delivery stands in for
+    CallbackManager::getInstance().registerGPIOBatchCallback(6, [&](const GPIOEdgeEvent* events, const size_t count)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < count; ++i) coalesced.push_back(events[i].coalesced);
+    }, BatchConfig{8, 0});
+
+    const uint64_t startNs = monotonicNs();
+    for (int i = 0; i < 4; ++i)
+    {
+        chip->injectEdge(6, i % 2 == 0, startNs + i * 1000);
+    }
+
+    ASSERT_TRUE(waitFor([&] { std::lock_guard<std::mutex> lock(mutex); return values.size() == 2; }));
+    EXPECT_EQ(values[0], PinValue::HIGH);
+    EXPECT_EQ(values[1], PinValue::LOW);
+    ASSERT_TRUE(waitFor([&] { std::lock_guard<std::mutex> lock(mutex); return coalesced.size() == 2; }));
+    EXPECT_EQ(coalesced, (std::vector<uint32_t>{0, 2}));
+    EXPECT_EQ(gpio->getEdgeRateStats(6).coalesced, 3u);
+    EXPECT_EQ(gpio->getEdgeRateStats(6).storms, 1u);
+}
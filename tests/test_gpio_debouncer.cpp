@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "gpio/gpio_debouncer.h"
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr uint64_t kStableNs = 5000000; // 5 ms
+}
+
+TEST(GPIODebouncerTest, ChatterSettlesToOneTransition)
+{
+    GPIODebouncer debouncer;
+    debouncer.configure(4, kStableNs, PinValue::LOW);
+    ASSERT_TRUE(debouncer.isEnabled(4));
+
+    // Contact closes with four bounces 100 us apart
+    uint64_t deadline = 0;
+    const PinValue levels[] = {PinValue::HIGH, PinValue::LOW, PinValue::HIGH, PinValue::LOW, PinValue::HIGH};
+    for (int i = 0; i < 5; ++i)
+    {
+        deadline = debouncer.onEdge(4, levels[i], 1000000 + i * 100000);
+    }
+    EXPECT_EQ(deadline, 1400000 + kStableNs);
+
+    std::vector<GPIOEdgeEvent> settled;
+    EXPECT_EQ(debouncer.settle(deadline - 1, settled), deadline);
+    EXPECT_TRUE(settled.empty());
+
+    EXPECT_EQ(debouncer.settle(deadline, settled), GPIODebouncer::NO_DEADLINE);
+    ASSERT_EQ(settled.size(), 1u);
+    EXPECT_EQ(settled[0].pin, 4);
+    EXPECT_EQ(settled[0].value, PinValue::HIGH);
+    EXPECT_EQ(settled[0].timestampNs, 1400000u);
+    EXPECT_EQ(debouncer.getSuppressedCount(4), 4u);
+}
+
+TEST(GPIODebouncerTest, GlitchBackToSettledLevelIsSuppressed)
+{
+    GPIODebouncer debouncer;
+    debouncer.configure(2, kStableNs, PinValue::LOW);
+
+    debouncer.onEdge(2, PinValue::HIGH, 0);
+    const uint64_t deadline = debouncer.onEdge(2, PinValue::LOW, 50000);
+
+    std::vector<GPIOEdgeEvent> settled;
+    debouncer.settle(deadline, settled);
+    EXPECT_TRUE(settled.empty());
+    EXPECT_EQ(debouncer.getSuppressedCount(2), 2u);
+}
+
+TEST(GPIODebouncerTest, PinsSettleIndependently)
+{
+    GPIODebouncer debouncer;
+    debouncer.configure(1, kStableNs, PinValue::LOW);
+    debouncer.configure(9, 2 * kStableNs, PinValue::HIGH);
+
+    const uint64_t first = debouncer.onEdge(1, PinValue::HIGH, 0);
+    const uint64_t second = debouncer.onEdge(9, PinValue::LOW, 0);
+
+    std::vector<GPIOEdgeEvent> settled;
+    EXPECT_EQ(debouncer.settle(first, settled), second);
+    ASSERT_EQ(settled.size(), 1u);
+    EXPECT_EQ(settled[0].pin, 1);
+
+    settled.clear();
+    EXPECT_EQ(debouncer.settle(second, settled), GPIODebouncer::NO_DEADLINE);
+    ASSERT_EQ(settled.size(), 1u);
+    EXPECT_EQ(settled[0].pin, 9);
+    EXPECT_EQ(settled[0].value, PinValue::LOW);
+}
+
+TEST(GPIODebouncerTest, ZeroStableTimeAndCancelDisarm)
+{
+    GPIODebouncer debouncer;
+    EXPECT_FALSE(debouncer.isEnabled(3));
+
+    debouncer.configure(3, kStableNs, PinValue::LOW);
+    debouncer.onEdge(3, PinValue::HIGH, 0);
+    debouncer.cancel(3);
+
+    std::vector<GPIOEdgeEvent> settled;
+    EXPECT_EQ(debouncer.settle(kStableNs, settled), GPIODebouncer::NO_DEADLINE);
+    EXPECT_TRUE(settled.empty());
+
+    debouncer.configure(3, 0, PinValue::LOW);
+    EXPECT_FALSE(debouncer.isEnabled(3));
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <hal/gpio_event_queue.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace mex_hal;
+
+TEST(GPIOEventQueueTest, CapacityRoundedToPowerOfTwo)
+{
+    EXPECT_EQ(GPIOEventQueue(100).capacity(), 128u);
+    EXPECT_EQ(GPIOEventQueue(64).capacity(), 64u);
+    EXPECT_EQ(GPIOEventQueue().capacity(), GPIOEventQueue::DEFAULT_CAPACITY);
+}
+
+TEST(GPIOEventQueueTest, DrainPreservesOrderAndFields)
+{
+    GPIOEventQueue queue(8);
+    ASSERT_TRUE(queue.push(4, PinValue::HIGH, 1000));
+    ASSERT_TRUE(queue.push(5, PinValue::LOW, 2000));
+    ASSERT_TRUE(queue.push(4, PinValue::LOW, 3000, 5));
+    EXPECT_EQ(queue.size(), 3u);
+
+    GPIOEdgeEvent events[8];
+    ASSERT_EQ(queue.drain(events, 8), 3u);
+    EXPECT_EQ(events[0].pin, 4);
+    EXPECT_EQ(events[0].value, PinValue::HIGH);
+    EXPECT_EQ(events[1].timestampNs, 2000u);
+    EXPECT_EQ(events[2].sequence, 2u);
+    EXPECT_EQ(events[0].coalesced, 0u);
+    EXPECT_EQ(events[2].coalesced, 5u);
+    EXPECT_EQ(queue.size(), 0u);
+
+    GPIOEdgeEvent event;
+    EXPECT_FALSE(queue.pop(event));
+}
+
+TEST(GPIOEventQueueTest, OverflowDropsNewestAndCounts)
+{
+    GPIOEventQueue queue(4);
+    for (uint64_t i = 0; i < 6; ++i)
+    {
+        queue.push(1, PinValue::HIGH, i);
+    }
+    EXPECT_EQ(queue.getOverflowCount(), 2u);
+
+    GPIOEdgeEvent events[8];
+    ASSERT_EQ(queue.drain(events, 8), 4u);
+    EXPECT_EQ(events[3].sequence, 3u);
+
+    // The sequence keeps counting dropped edges, consumers see the gap
+    ASSERT_TRUE(queue.push(1, PinValue::LOW, 99));
+    ASSERT_TRUE(queue.pop(events[0]));
+    EXPECT_EQ(events[0].sequence, 6u);
+}
+
+TEST(GPIOEventQueueTest, ConcurrentConsumersReceiveEachEventOnce)
+{
+    constexpr uint64_t kEvents = 200000;
+    constexpr int kConsumers = 4;
+
+    GPIOEventQueue queue(256);
+    std::atomic<bool> producerDone{false};
+    std::vector<std::vector<uint64_t>> received(kConsumers);
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < kConsumers; ++c)
+    {
+        consumers.emplace_back([&, c] {
+            GPIOEdgeEvent batch[32];
+            for (;;)
+            {
+                const size_t count = queue.drain(batch, 32);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    received[c].push_back(batch[i].sequence);
+                }
+                if (count == 0 && producerDone.load(std::memory_order_acquire) && queue.size() == 0)
+                {
+                    break;
+                }
+            }
+        });
+    }
+
+    for (uint64_t i = 0; i < kEvents; ++i)
+    {
+        queue.push(static_cast<uint8_t>(i), PinValue::HIGH, i);
+    }
+    producerDone.store(true, std::memory_order_release);
+
+    for (auto& consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    std::vector<bool> seen(kEvents, false);
+    uint64_t total = 0;
+    for (const auto& sequences : received)
+    {
+        uint64_t previous = 0;
+        bool first = true;
+        for (const uint64_t sequence : sequences)
+        {
+            ASSERT_LT(sequence, kEvents);
+            ASSERT_FALSE(seen[sequence]) << "duplicate " << sequence;
+            seen[sequence] = true;
+
+            // Each consumer claims runs in ring order
+            EXPECT_TRUE(first || sequence > previous);
+            previous = sequence;
+            first = false;
+            ++total;
+        }
+    }
+    EXPECT_EQ(total + queue.getOverflowCount(), kEvents);
+}
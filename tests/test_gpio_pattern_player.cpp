@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <hal/gpio_pattern_player.h>
+#include "monotonic_clock/monotonic_clock.h"
+#include "stub_gpio.h"
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr uint64_t kMs = 1000000;
+
+    /// @brief GPIO controller that records every bulk write with its time
+    class RecordingGPIO : public StubGPIO
+    {
+    public:
+        struct Write
+        {
+            uint64_t timeNs;
+            PinMask mask;
+            PinMask values;
+        };
+
+
+        bool writeMask(const PinMask& mask, const PinMask& values) override
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            writes.push_back({monotonicNs(), mask, values});
+            return !failWrites;
+        }
+
+        std::vector<Write> snapshot()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            return writes;
+        }
+
+        bool failWrites = false;
+
+    private:
+        std::mutex mutex;
+        std::vector<Write> writes;
+    };
+
+    void waitUntilDone(const GPIOPatternPlayer& player)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (player.isRunning() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    std::vector<GPIOPatternStep> blinkPattern()
+    {
+        PinMask led;
+        led.set(17);
+        return {{0, led, led}, {5 * kMs, led, PinMask()}};
+    }
+}
+
+TEST(GPIOPatternPlayerTest, PlaysStepsAtTheirOffsets)
+{
+    RecordingGPIO gpio;
+    GPIOPatternPlayer player(gpio);
+
+    PinMask bus;
+    bus.set(2).set(3);
+    ASSERT_TRUE(player.load({{0, bus, PinMask().set(2)},
+                             {4 * kMs, bus, PinMask().set(3)},
+                             {10 * kMs, bus, PinMask()}}));
+
+    const uint64_t startNs = monotonicNs();
+    ASSERT_TRUE(player.start());
+    waitUntilDone(player);
+    EXPECT_FALSE(player.isRunning());
+
+    const auto writes = gpio.snapshot();
+    ASSERT_EQ(writes.size(), 3u);
+    EXPECT_EQ(writes[0].values, PinMask().set(2));
+    EXPECT_EQ(writes[1].values, PinMask().set(3));
+    EXPECT_EQ(writes[2].mask, bus);
+
+    // Deadlines are absolute from the start, steps are never early
+    EXPECT_GE(writes[1].timeNs - startNs, 4 * kMs);
+    EXPECT_GE(writes[2].timeNs - startNs, 10 * kMs);
+
+    const GPIOPatternStats stats = player.getStats();
+    EXPECT_EQ(stats.cycles, 1u);
+    EXPECT_EQ(stats.steps, 3u);
+    EXPECT_EQ(stats.writeErrors, 0u);
+    EXPECT_GE(stats.maxLatenessNs, stats.meanLatenessNs);
+    EXPECT_EQ(player.getStepStats(1).plays, 1u);
+    EXPECT_EQ(player.getStepStats(3).plays, 0u);
+}
+
+TEST(GPIOPatternPlayerTest, LoopingKeepsAbsoluteSchedule)
+{
+    RecordingGPIO gpio;
+    GPIOPatternPlayer player(gpio);
+    ASSERT_TRUE(player.load(blinkPattern(), 10 * kMs));
+
+    const uint64_t startNs = monotonicNs();
+    ASSERT_TRUE(player.start(true));
+    std::this_thread::sleep_for(std::chrono::milliseconds(65));
+    EXPECT_TRUE(player.isRunning());
+    EXPECT_TRUE(player.stop());
+    EXPECT_FALSE(player.isRunning());
+
+    const auto writes = gpio.snapshot();
+    ASSERT_GE(writes.size(), 6u);
+
+    // Every write lands on or after its slot of the 10 ms grid anchored at start()
+    for (size_t i = 0; i < writes.size(); ++i)
+    {
+        const uint64_t offsetNs = (i / 2) * 10 * kMs + (i % 2) * 5 * kMs;
+        EXPECT_GE(writes[i].timeNs - startNs, offsetNs) << "write " << i;
+    }
+
+    const GPIOPatternStats stats = player.getStats();
+    EXPECT_GE(stats.cycles, 3u);
+    EXPECT_EQ(stats.steps, writes.size());
+}
+
+TEST(GPIOPatternPlayerTest, StopInterruptsLongGap)
+{
+    RecordingGPIO gpio;
+    GPIOPatternPlayer player(gpio);
+
+    PinMask led;
+    led.set(1);
+    ASSERT_TRUE(player.load({{0, led, led}, {10000 * kMs, led, PinMask()}}));
+    ASSERT_TRUE(player.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+    const auto before = std::chrono::steady_clock::now();
+    EXPECT_TRUE(player.stop());
+    EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::milliseconds(500));
+    EXPECT_EQ(gpio.snapshot().size(), 1u);
+}
+
+TEST(GPIOPatternPlayerTest, RejectsInvalidPatterns)
+{
+    RecordingGPIO gpio;
+    GPIOPatternPlayer player(gpio);
+    PinMask led;
+    led.set(0);
+
+    EXPECT_FALSE(player.start());
+    EXPECT_FALSE(player.load({}));
+    EXPECT_FALSE(player.load({{5 * kMs, led, led}, {1 * kMs, led, led}}));
+    EXPECT_FALSE(player.load(blinkPattern(), 1 * kMs));
+
+    // A single step at offset 0 has no cycle length to loop on
+    ASSERT_TRUE(player.load({{0, led, led}}));
+    EXPECT_FALSE(player.start(true));
+
+    EXPECT_FALSE(player.setThreadPriority(-1));
+    EXPECT_FALSE(player.setThreadAffinity(-2));
+}
+
+TEST(GPIOPatternPlayerTest, CountsWriteErrors)
+{
+    RecordingGPIO gpio;
+    gpio.failWrites = true;
+    GPIOPatternPlayer player(gpio);
+
+    ASSERT_TRUE(player.load(blinkPattern()));
+    ASSERT_TRUE(player.start());
+    waitUntilDone(player);
+
+    EXPECT_EQ(player.getStats().writeErrors, 2u);
+    EXPECT_EQ(player.getStats().steps, 2u);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include "gpio/gpio_rate_limiter.h"
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr uint64_t kMs = 1000000;
+
+    EdgeRateLimit limitOf(const uint32_t maxEvents, const EdgeRateMode mode, const bool disable = false)
+    {
+        EdgeRateLimit limit;
+        limit.maxEvents = maxEvents;
+        limit.windowMs = 10;
+        limit.mode = mode;
+        limit.disableDuringStorm = disable;
+        return limit;
+    }
+
+    PinValue levelOf(const int edge)
+    {
+        return (edge % 2 == 0) ? PinValue::HIGH : PinValue::LOW;
+    }
+}
+
+TEST(GPIORateLimiterTest, DropsEdgesBeyondTheWindowLimit)
+{
+    GPIORateLimiter limiter;
+    limiter.configure(4, limitOf(3, EdgeRateMode::DROP));
+    ASSERT_TRUE(limiter.isEnabled(4));
+
+    uint64_t deadline;
+    int delivered = 0;
+    for (int i = 0; i < 100; ++i)
+    {
+        if (limiter.onEdge(4, levelOf(i), 1000 + i * 10000, deadline) == GPIORateLimiter::Verdict::DELIVER) ++delivered;
+        EXPECT_EQ(deadline, GPIORateLimiter::NO_DEADLINE);
+    }
+
+    // 100 edges 10 us apart fit in one 10 ms window
+    EXPECT_EQ(delivered, 3);
+    const EdgeRateStats stats = limiter.getStats(4);
+    EXPECT_EQ(stats.dropped, 97u);
+    EXPECT_EQ(stats.storms, 1u);
+    EXPECT_TRUE(stats.stormActive);
+
+    // The next window opens with a fresh budget
+    EXPECT_EQ(limiter.onEdge(4, PinValue::HIGH, 20 * kMs, deadline), GPIORateLimiter::Verdict::DELIVER);
+}
+
+TEST(GPIORateLimiterTest, CoalescesToLatestValueAtWindowEnd)
+{
+    GPIORateLimiter limiter;
+    limiter.configure(2, limitOf(1, EdgeRateMode::COALESCE));
+
+    uint64_t deadline;
+    EXPECT_EQ(limiter.onEdge(2, PinValue::HIGH, 0, deadline), GPIORateLimiter::Verdict::DELIVER);
+    EXPECT_EQ(limiter.onEdge(2, PinValue::LOW, 1000, deadline), GPIORateLimiter::Verdict::SUPPRESS);
+    EXPECT_EQ(limiter.onEdge(2, PinValue::HIGH, 2000, deadline), GPIORateLimiter::Verdict::SUPPRESS);
+    EXPECT_EQ(limiter.onEdge(2, PinValue::LOW, 3000, deadline), GPIORateLimiter::Verdict::SUPPRESS);
+    EXPECT_EQ(deadline, 10 * kMs);
+
+    std::vector<GPIOEdgeEvent> flushed;
+    PinMask rearm;
+    EXPECT_EQ(limiter.settle(deadline - 1, flushed, rearm), deadline);
+    EXPECT_TRUE(flushed.empty());
+
+    EXPECT_EQ(limiter.settle(deadline, flushed, rearm), GPIORateLimiter::NO_DEADLINE);
+    ASSERT_EQ(flushed.size(), 1u);
+    EXPECT_EQ(flushed[0].value, PinValue::LOW);
+    EXPECT_EQ(flushed[0].timestampNs, 3000u);
+    EXPECT_EQ(flushed[0].coalesced, 2u);
+    EXPECT_EQ(limiter.getStats(2).coalesced, 3u);
+    EXPECT_TRUE(rearm.none());
+    EXPECT_EQ(limiter.takeCoalesced(2), 0u);
+}
+
+TEST(GPIORateLimiterTest, CoalescedEdgesWithoutFlushAreReportedWithTheNextDelivery)
+{
+    GPIORateLimiter limiter;
+    limiter.configure(2, limitOf(1, EdgeRateMode::COALESCE));
+
+    // The burst ends on the delivered level, the flush has nothing to deliver
+    uint64_t deadline;
+    EXPECT_EQ(limiter.onEdge(2, PinValue::HIGH, 0, deadline), GPIORateLimiter::Verdict::DELIVER);
+    EXPECT_EQ(limiter.onEdge(2, PinValue::LOW, 1000, deadline), GPIORateLimiter::Verdict::SUPPRESS);
+    EXPECT_EQ(limiter.onEdge(2, PinValue::HIGH, 2000, deadline), GPIORateLimiter::Verdict::SUPPRESS);
+
+    std::vector<GPIOEdgeEvent> flushed;
+    PinMask rearm;
+    limiter.settle(deadline, flushed, rearm);
+    EXPECT_TRUE(flushed.empty());
+
+    // Both edges still have to reach the subscriber's accounting
+    EXPECT_EQ(limiter.onEdge(2, PinValue::LOW, 20 * kMs, deadline), GPIORateLimiter::Verdict::DELIVER);
+    EXPECT_EQ(limiter.takeCoalesced(2), 2u);
+    EXPECT_EQ(limiter.takeCoalesced(2), 0u);
+}
+
+TEST(GPIORateLimiterTest, StormEndsAfterAWindowWithinTheLimit)
+{
+    GPIORateLimiter limiter;
+    limiter.configure(1, limitOf(2, EdgeRateMode::DROP));
+
+    uint64_t deadline;
+    uint64_t now = 0;
+    const auto burst = [&](const int edges)
+    {
+        for (int i = 0; i < edges; ++i) limiter.onEdge(1, levelOf(i), now + i * 1000, deadline);
+        now += 10 * kMs;
+    };
+
+    // Back-to-back overflowing windows are one storm
+    burst(5);
+    burst(5);
+    EXPECT_EQ(limiter.getStats(1).storms, 1u);
+
+    // A window within the limit ends it, the next overflow is a new storm
+    burst(1);
+    burst(5);
+    EXPECT_EQ(limiter.getStats(1).storms, 2u);
+}
+
+TEST(GPIORateLimiterTest, DisablesDuringStormAndReportsLevelOnRearm)
+{
+    GPIORateLimiter limiter;
+    EdgeRateLimit limit = limitOf(2, EdgeRateMode::DROP, true);
+    limit.rearmMs = 50;
+    limiter.configure(7, limit);
+
+    uint64_t deadline;
+    EXPECT_EQ(limiter.onEdge(7, PinValue::HIGH, 0, deadline), GPIORateLimiter::Verdict::DELIVER);
+    EXPECT_EQ(limiter.onEdge(7, PinValue::LOW, 1000, deadline), GPIORateLimiter::Verdict::DELIVER);
+    EXPECT_EQ(limiter.onEdge(7, PinValue::HIGH, 2000, deadline), GPIORateLimiter::Verdict::DISABLE);
+    EXPECT_EQ(deadline, 2000 + 50 * kMs);
+    EXPECT_TRUE(limiter.isDisabled(7));
+
+    // Edges already in flight are suppressed without extending the pause
+    EXPECT_EQ(limiter.onEdge(7, PinValue::LOW, 3000, deadline), GPIORateLimiter::Verdict::SUPPRESS);
+    EXPECT_EQ(deadline, GPIORateLimiter::NO_DEADLINE);
+
+    std::vector<GPIOEdgeEvent> flushed;
+    PinMask rearm;
+    EXPECT_EQ(limiter.settle(2000 + 50 * kMs, flushed, rearm), GPIORateLimiter::NO_DEADLINE);
+    EXPECT_TRUE(rearm.test(7));
+    EXPECT_FALSE(limiter.isDisabled(7));
+
+    // Only a level that differs from the last delivered one is reported
+    EXPECT_FALSE(limiter.onRearm(7, PinValue::LOW));
+    EXPECT_TRUE(limiter.onRearm(7, PinValue::HIGH));
+
+    const EdgeRateStats stats = limiter.getStats(7);
+    EXPECT_EQ(stats.storms, 1u);
+    EXPECT_EQ(stats.dropped, 2u);
+    EXPECT_FALSE(stats.disabled);
+}
+
+TEST(GPIORateLimiterTest, ZeroLimitDisablesAndConfigureResets)
+{
+    GPIORateLimiter limiter;
+    EXPECT_FALSE(limiter.isEnabled(3));
+
+    limiter.configure(3, limitOf(1, EdgeRateMode::DROP));
+    uint64_t deadline;
+    limiter.onEdge(3, PinValue::HIGH, 0, deadline);
+    limiter.onEdge(3, PinValue::LOW, 1, deadline);
+    EXPECT_EQ(limiter.getStats(3).dropped, 1u);
+
+    limiter.configure(3, EdgeRateLimit{});
+    EXPECT_FALSE(limiter.isEnabled(3));
+    EXPECT_EQ(limiter.getStats(3).dropped, 0u);
+}
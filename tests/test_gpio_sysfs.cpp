@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+#include "gpio/gpio_linux.h"
+#include "fake_sysfs.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace mex_hal;
+namespace fs = std::filesystem;
+
+class GPIOSysfsTest : public FakeSysfsTest
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_NO_FATAL_FAILURE(FakeSysfsTest::SetUp());
+        for (uint8_t pin = 0; pin < 8; ++pin)
+        {
+            createPin(pin);
+        }
+    }
+
+    std::string attribute(const uint8_t pin, const std::string& name) const
+    {
+        std::ifstream file(root / ("gpio" + std::to_string(pin)) / name);
+        std::string value;
+        file >> value;
+        return value;
+    }
+
+    // epoll refuses regular files, a FIFO stands in for a pollable sysfs value attribute
+    void makePollable(const uint8_t pin) const
+    {
+        const fs::path value = root / ("gpio" + std::to_string(pin)) / "value";
+        fs::remove(value);
+        ASSERT_EQ(mkfifo(value.c_str(), 0600), 0);
+    }
+
+    static size_t threadCount()
+    {
+        return static_cast<size_t>(std::distance(fs::directory_iterator("/proc/self/task"), fs::directory_iterator{}));
+    }
+};
+
+TEST_F(GPIOSysfsTest, WriteMaskWritesEveryPin)
+{
+    GPIOLinux gpio(root.string());
+
+    PinMask bus;
+    for (uint8_t pin = 0; pin < 8; ++pin)
+    {
+        ASSERT_TRUE(gpio.setDirection(pin, PinDirection::OUTPUT));
+        bus.set(pin);
+    }
+
+    PinMask values;
+    values.set(1).set(6);
+    ASSERT_TRUE(gpio.writeMask(bus, values));
+
+    for (uint8_t pin = 0; pin < 8; ++pin)
+    {
+        EXPECT_EQ(attribute(pin, "value"), values.test(pin) ? "1" : "0") << "pin " << static_cast<int>(pin);
+    }
+    EXPECT_EQ(gpio.readMask(bus), values);
+}
+
+TEST_F(GPIOSysfsTest, WriteMaskRejectsUnconfiguredPin)
+{
+    GPIOLinux gpio(root.string());
+    ASSERT_TRUE(gpio.setDirection(0, PinDirection::OUTPUT));
+
+    PinMask mask;
+    mask.set(0).set(1);
+    EXPECT_FALSE(gpio.writeMask(mask, mask));
+    EXPECT_EQ(attribute(0, "value"), "0");
+}
+
+TEST_F(GPIOSysfsTest, ConcurrentWriteMasksNeverMixOnTheBus)
+{
+    GPIOLinux gpio(root.string());
+    PinMask bus;
+    for (uint8_t pin = 0; pin < 8; ++pin)
+    {
+        ASSERT_TRUE(gpio.setDirection(pin, PinDirection::OUTPUT));
+        bus.set(pin);
+    }
+
+    // Two writers drive the whole bus to opposite values, a sample must always see one of them
+    std::atomic<bool> stop{false};
+    std::thread high([&] { while (!stop) gpio.writeMask(bus, bus); });
+    std::thread low([&] { while (!stop) gpio.writeMask(bus, PinMask{}); });
+
+    size_t mixed = 0;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const PinMask sample = gpio.readMask(bus);
+        if (sample.any() && sample != bus) ++mixed;
+    }
+    stop = true;
+    high.join();
+    low.join();
+
+    EXPECT_EQ(mixed, 0u);
+    const PinMask last = gpio.readMask(bus);
+    EXPECT_TRUE(last.none() || last == bus);
+}
+
+TEST_F(GPIOSysfsTest, OneDispatcherThreadServesAllInterrupts)
+{
+    const size_t before = threadCount();
+    {
+        GPIOLinux gpio(root.string());
+        for (uint8_t pin = 0; pin < 8; ++pin)
+        {
+            makePollable(pin);
+            ASSERT_TRUE(gpio.setInterrupt(pin, EdgeTrigger::BOTH, [](uint8_t, PinValue) {}));
+        }
+        EXPECT_EQ(attribute(3, "edge"), "both");
+        EXPECT_EQ(threadCount(), before + 1);
+
+        // Re-arming after removal reuses the dispatcher
+        ASSERT_TRUE(gpio.removeInterrupt(3));
+        EXPECT_EQ(attribute(3, "edge"), "none");
+        EXPECT_FALSE(gpio.removeInterrupt(3));
+        ASSERT_TRUE(gpio.setInterrupt(3, EdgeTrigger::RISING, [](uint8_t, PinValue) {}));
+        EXPECT_EQ(threadCount(), before + 1);
+    }
+    EXPECT_EQ(threadCount(), before);
+}
+
+TEST_F(GPIOSysfsTest, ShutdownWakesDispatcherImmediately)
+{
+    auto gpio = std::make_unique<GPIOLinux>(root.string());
+    makePollable(0);
+    ASSERT_TRUE(gpio->setInterrupt(0, EdgeTrigger::FALLING, [](uint8_t, PinValue) {}));
+
+    const auto start = std::chrono::steady_clock::now();
+    gpio.reset();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+}
+
+TEST_F(GPIOSysfsTest, InterruptThreadScheduleIsValidated)
+{
+    GPIOLinux gpio(root.string());
+    EXPECT_FALSE(gpio.setInterruptThreadPriority(-1));
+    EXPECT_FALSE(gpio.setInterruptThreadPriority(1000));
+    EXPECT_FALSE(gpio.setInterruptThreadAffinity(-2));
+    EXPECT_TRUE(gpio.setInterruptThreadPriority(0));
+    EXPECT_TRUE(gpio.setInterruptThreadAffinity(0));
+
+    // The stored schedule is applied once the dispatcher starts
+    makePollable(0);
+    EXPECT_TRUE(gpio.setInterrupt(0, EdgeTrigger::BOTH, [](uint8_t, PinValue) {}));
+    EXPECT_TRUE(gpio.setInterruptThreadAffinity(-1));
+}
+
+TEST_F(GPIOSysfsTest, EdgeEventsShareTheDispatcher)
+{
+    GPIOLinux gpio(root.string());
+    makePollable(0);
+    makePollable(1);
+    ASSERT_TRUE(gpio.setInterrupt(0, EdgeTrigger::BOTH, [](uint8_t, PinValue) {}));
+    ASSERT_TRUE(gpio.enableEdgeEvents(1, EdgeTrigger::RISING));
+    EXPECT_EQ(attribute(1, "edge"), "rising");
+
+    // Switching a pin between callback and queue mode keeps it armed
+    ASSERT_TRUE(gpio.enableEdgeEvents(0, EdgeTrigger::FALLING));
+    EXPECT_EQ(attribute(0, "edge"), "falling");
+    EXPECT_EQ(gpio.getEdgeEventQueue().size(), 0u);
+
+    ASSERT_TRUE(gpio.removeInterrupt(1));
+    EXPECT_FALSE(gpio.removeInterrupt(1));
+}
+
+TEST_F(GPIOSysfsTest, DebouncedPinWatchesBothEdges)
+{
+    GPIOLinux gpio(root.string());
+    EXPECT_FALSE(gpio.setDebounce(2, 5));
+
+    // The level sample comes from the regular value file opened at export
+    ASSERT_TRUE(gpio.setDirection(2, PinDirection::INPUT));
+    ASSERT_TRUE(gpio.setDebounce(2, 5));
+
+    // Settled levels are filtered by the requested trigger, so the kernel must report every edge
+    makePollable(2);
+    const FileDescriptor writer(open((root / "gpio2" / "value").c_str(), O_RDWR | O_NONBLOCK));
+    ASSERT_TRUE(writer.isValid());
+    ASSERT_TRUE(gpio.setInterrupt(2, EdgeTrigger::RISING, [](uint8_t, PinValue) {}));
+    EXPECT_EQ(attribute(2, "edge"), "both");
+
+    ASSERT_TRUE(gpio.setDebounce(2, 0));
+    EXPECT_EQ(attribute(2, "edge"), "rising");
+    EXPECT_EQ(gpio.getSuppressedBounceCount(2), 0u);
+}
+
+TEST_F(GPIOSysfsTest, SetDirectionMaskExportsPinsTogether)
+{
+    // Pins 8..15 appear only after the export, like a kernel populating sysfs
+    std::thread kernel([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        for (uint8_t pin = 8; pin < 16; ++pin)
+        {
+            const fs::path pinDir = root / ("gpio" + std::to_string(pin));
+            fs::create_directories(pinDir);
+            std::ofstream(pinDir / "direction") << "in";
+            std::ofstream(pinDir / "edge") << "none";
+            std::ofstream(pinDir / "value") << "0";
+        }
+    });
+
+    GPIOLinux gpio(root.string());
+    PinMask bus;
+    for (uint8_t pin = 4; pin < 16; ++pin)
+    {
+        bus.set(pin);
+    }
+    const bool configured = gpio.setDirectionMask(bus, PinDirection::OUTPUT);
+    kernel.join();
+
+    ASSERT_TRUE(configured);
+    for (uint8_t pin = 4; pin < 16; ++pin)
+    {
+        EXPECT_EQ(attribute(pin, "direction"), "out") << "pin " << static_cast<int>(pin);
+    }
+    EXPECT_TRUE(gpio.writeMask(bus, bus));
+}
+
+TEST_F(GPIOSysfsTest, OutputReadsComeFromShadow)
+{
+    GPIOLinux gpio(root.string());
+    ASSERT_TRUE(gpio.setDirection(2, PinDirection::OUTPUT));
+    ASSERT_TRUE(gpio.write(2, PinValue::HIGH));
+
+    // Something else drives the attribute, only a readback notices
+    std::ofstream(root / "gpio2" / "value") << "0";
+    EXPECT_EQ(gpio.read(2), PinValue::HIGH);
+    EXPECT_EQ(gpio.readMask(PinMask().set(2)), PinMask().set(2));
+    EXPECT_EQ(gpio.readback(2), PinValue::LOW);
+
+    // Inputs always go to the attribute
+    ASSERT_TRUE(gpio.setDirection(2, PinDirection::INPUT));
+    std::ofstream(root / "gpio2" / "value") << "1";
+    EXPECT_EQ(gpio.read(2), PinValue::HIGH);
+}
+
+TEST_F(GPIOSysfsTest, ToggleInvertsShadowWithOneWrite)
+{
+    GPIOLinux gpio(root.string());
+    ASSERT_TRUE(gpio.setDirection(4, PinDirection::OUTPUT));
+
+    ASSERT_TRUE(gpio.toggle(4));
+    EXPECT_EQ(attribute(4, "value"), "1");
+    EXPECT_EQ(gpio.read(4), PinValue::HIGH);
+
+    ASSERT_TRUE(gpio.toggle(4));
+    EXPECT_EQ(attribute(4, "value"), "0");
+    EXPECT_EQ(gpio.read(4), PinValue::LOW);
+
+    ASSERT_TRUE(gpio.setDirection(5, PinDirection::INPUT));
+    EXPECT_FALSE(gpio.toggle(5));
+    EXPECT_FALSE(gpio.toggle(6));
+}
+
+TEST_F(GPIOSysfsTest, RateLimitedInterruptStartsClean)
+{
+    makePollable(3);
+    FileDescriptor writer(open((root / "gpio3" / "value").c_str(), O_RDWR | O_NONBLOCK));
+    ASSERT_TRUE(writer.isValid());
+
+    GPIOLinux gpio(root.string());
+    EdgeRateLimit limit;
+    limit.maxEvents = 10;
+    limit.windowMs = 100;
+    limit.mode = EdgeRateMode::COALESCE;
+    limit.disableDuringStorm = true;
+    ASSERT_TRUE(gpio.setInterrupt(3, EdgeTrigger::RISING, [](uint8_t, PinValue) {}, limit));
+
+    EXPECT_EQ(attribute(3, "edge"), "rising");
+    const EdgeRateStats stats = gpio.getEdgeRateStats(3);
+    EXPECT_EQ(stats.storms, 0u);
+    EXPECT_FALSE(stats.stormActive);
+    EXPECT_FALSE(stats.disabled);
+    EXPECT_TRUE(gpio.removeInterrupt(3));
+}
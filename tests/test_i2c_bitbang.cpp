@@ -0,0 +1,339 @@
+#include <gtest/gtest.h>
+#include <hal/core.h>
+#include <hal/callback_manager.h>
+#include "i2c/i2c_bitbang.h"
+#include "device_config/device_config.h"
+#include "stub_gpio.h"
+#include <array>
+#include <vector>
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr uint8_t kScl = 2;
+    constexpr uint8_t kSda = 3;
+    constexpr uint8_t kAddress = 0x50;
+
+    /// @brief Open-drain GPIO lines wired to an I2C register memory slave model
+    class I2CSlaveGPIO : public StubGPIO
+    {
+    public:
+
+        // OUTPUT pulls the line low, INPUT releases it to the pull-up
+        bool setDirection(const uint8_t pin, const PinDirection direction) override
+        {
+            ++directionChanges;
+            const bool scl = sclLevel();
+            const bool sda = sdaLevel();
+
+            if (pin == kScl) sclLow_ = direction == PinDirection::OUTPUT;
+            else if (pin == kSda) sdaLow_ = direction == PinDirection::OUTPUT;
+            else return false;
+
+            if (sclLevel() != scl)
+            {
+                if (sclLevel()) onRise();
+                else onFall();
+            }
+            else if (scl && sdaLevel() != sda)
+            {
+                if (sdaLevel()) onStop();
+                else onStart();
+            }
+            return true;
+        }
+
+        PinValue read(const uint8_t pin) override
+        {
+            if (pin == kScl)
+            {
+                if (sclLevel() && stretchReads > 0)
+                {
+                    --stretchReads;
+                    return PinValue::LOW;
+                }
+                return sclLevel() ? PinValue::HIGH : PinValue::LOW;
+            }
+            return sdaLevel() ? PinValue::HIGH : PinValue::LOW;
+        }
+
+        std::array<uint8_t, 256> memory{};
+        size_t starts = 0;
+        size_t stops = 0;
+        size_t directionChanges = 0;
+        uint32_t stretchReads = 0;
+        uint32_t stuckClocks = 0;
+
+    private:
+        enum class State { IDLE, ADDRESS, WRITE, READ, IGNORE };
+
+        [[nodiscard]] bool sclLevel() const { return !sclLow_; }
+        [[nodiscard]] bool sdaLevel() const { return !sdaLow_ && !slaveLow_ && stuckClocks == 0; }
+
+        void onStart()
+        {
+            ++starts;
+            state_ = State::ADDRESS;
+            bit_ = 0;
+            shift_ = 0;
+            slaveLow_ = false;
+        }
+
+        void onStop()
+        {
+            ++stops;
+            state_ = State::IDLE;
+            slaveLow_ = false;
+        }
+
+        void onRise()
+        {
+            if (state_ == State::IDLE || state_ == State::IGNORE) return;
+
+            if (bit_ < 8)
+            {
+                if (state_ != State::READ) shift_ = static_cast<uint8_t>(shift_ << 1 | (sdaLevel() ? 1 : 0));
+            }
+            else if (state_ == State::READ)
+            {
+                masterAck_ = !sdaLevel();
+            }
+            ++bit_;
+        }
+
+        void onFall()
+        {
+            if (stuckClocks > 0)
+            {
+                --stuckClocks;
+                return;
+            }
+            if (state_ == State::IDLE || state_ == State::IGNORE) return;
+
+            if (bit_ == 8)
+            {
+                // Release SDA for the master's acknowledge, or acknowledge the received byte
+                if (state_ == State::READ)
+                {
+                    slaveLow_ = false;
+                    return;
+                }
+                if (state_ == State::ADDRESS)
+                {
+                    if ((shift_ >> 1) != kAddress)
+                    {
+                        state_ = State::IGNORE;
+                        return;
+                    }
+                    reading_ = (shift_ & 1) != 0;
+                    pointerPending_ = true;
+                }
+                else if (pointerPending_)
+                {
+                    pointer_ = shift_;
+                    pointerPending_ = false;
+                }
+                else
+                {
+                    memory[pointer_++] = shift_;
+                }
+                slaveLow_ = true;
+                return;
+            }
+
+            if (bit_ == 9)
+            {
+                slaveLow_ = false;
+                bit_ = 0;
+                shift_ = 0;
+                if (state_ == State::ADDRESS)
+                {
+                    state_ = reading_ ? State::READ : State::WRITE;
+                    if (reading_) present();
+                }
+                else if (state_ == State::READ)
+                {
+                    if (masterAck_) present();
+                    else state_ = State::IGNORE;
+                }
+                return;
+            }
+
+            if (state_ == State::READ) slaveLow_ = ((out_ >> (7 - bit_)) & 1) == 0;
+        }
+
+        void present()
+        {
+            out_ = memory[pointer_++];
+            slaveLow_ = (out_ & 0x80) == 0;
+        }
+
+        bool sclLow_ = false;
+        bool sdaLow_ = false;
+        bool slaveLow_ = false;
+        State state_ = State::IDLE;
+        int bit_ = 0;
+        uint8_t shift_ = 0;
+        uint8_t out_ = 0;
+        uint8_t pointer_ = 0;
+        bool pointerPending_ = false;
+        bool reading_ = false;
+        bool masterAck_ = false;
+    };
+
+    SoftI2CPins busPins(const uint32_t stretchTimeoutUs = 1000)
+    {
+        SoftI2CPins pins;
+        pins.scl = kScl;
+        pins.sda = kSda;
+        pins.stretchTimeoutUs = stretchTimeoutUs;
+        return pins;
+    }
+}
+
+TEST(I2CBitBangTest, WritesAndReadsRegisters)
+{
+    auto gpio = std::make_shared<I2CSlaveGPIO>();
+    I2CBitBang i2c(gpio, busPins());
+    ASSERT_TRUE(i2c.init(0));
+    ASSERT_TRUE(i2c.setSpeed(0));
+    ASSERT_TRUE(i2c.setDeviceAddress(kAddress));
+
+    ASSERT_TRUE(i2c.write({0x10, 0xDE, 0xAD, 0x01}));
+    EXPECT_EQ(gpio->memory[0x10], 0xDE);
+    EXPECT_EQ(gpio->memory[0x11], 0xAD);
+    EXPECT_EQ(gpio->memory[0x12], 0x01);
+
+    // Register pointer write and read in one transaction with a repeated START
+    std::vector<uint8_t> rx(3);
+    ASSERT_TRUE(i2c.writeRead(kAddress, {0x10}, rx));
+    EXPECT_EQ(rx, (std::vector<uint8_t>{0xDE, 0xAD, 0x01}));
+    EXPECT_EQ(gpio->starts, 3u);
+    EXPECT_EQ(gpio->stops, 2u);
+
+    // A plain read continues after the last register read
+    gpio->memory[0x13] = 0x7E;
+    ASSERT_TRUE(i2c.read(rx, 1));
+    EXPECT_EQ(rx, (std::vector<uint8_t>{0x7E}));
+    EXPECT_EQ(gpio->read(kSda), PinValue::HIGH);
+    EXPECT_EQ(gpio->read(kScl), PinValue::HIGH);
+}
+
+TEST(I2CBitBangTest, MissingDeviceNacksAndLeavesBusIdle)
+{
+    auto gpio = std::make_shared<I2CSlaveGPIO>();
+    I2CBitBang i2c(gpio, busPins());
+    ASSERT_TRUE(i2c.init(0));
+    ASSERT_TRUE(i2c.setSpeed(0));
+
+    ASSERT_TRUE(i2c.setDeviceAddress(0x51));
+    EXPECT_FALSE(i2c.write({0x00}));
+    EXPECT_EQ(gpio->stops, 1u);
+    EXPECT_EQ(gpio->read(kSda), PinValue::HIGH);
+
+    EXPECT_FALSE(i2c.setDeviceAddress(0x80));
+}
+
+TEST(I2CBitBangTest, PublishesTransfersOnEventBus)
+{
+    auto gpio = std::make_shared<I2CSlaveGPIO>();
+    I2CBitBang i2c(gpio, busPins());
+    ASSERT_TRUE(i2c.init(0));
+    ASSERT_TRUE(i2c.setSpeed(0));
+    ASSERT_NE(i2c.getResourceId(), 0u);
+
+    auto& cm = CallbackManager::getInstance();
+    std::vector<HALEvent> events;
+    const uint64_t id = cm.registerEventCallback(ResourceType::I2C_BUS, i2c.getResourceId(),
+                                                 [&events](const HALEvent& event) { events.push_back(event); });
+
+    ASSERT_TRUE(i2c.setDeviceAddress(kAddress));
+    ASSERT_TRUE(i2c.write({0x20, 0x01, 0x02}));
+    ASSERT_TRUE(i2c.setDeviceAddress(0x51));
+    EXPECT_FALSE(i2c.write({0x00}));
+    cm.unregisterEventCallback(id);
+
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].kind, HALEventKind::TRANSFER_COMPLETE);
+    EXPECT_EQ(events[0].channel, kAddress);
+    EXPECT_EQ(events[0].value, 3u);
+    EXPECT_EQ(events[1].kind, HALEventKind::IO_ERROR);
+    EXPECT_EQ(events[1].channel, 0x51u);
+
+    // The same transfers are counted for the bus resource
+    ResourceIoStats stats;
+    ASSERT_TRUE(ResourceManager::getInstance().getIoStats(i2c.getResourceId(), stats));
+    EXPECT_EQ(stats.operations, 2u);
+    EXPECT_EQ(stats.bytes, 3u);
+    EXPECT_EQ(stats.errors, 1u);
+    EXPECT_GT(stats.maxLatencyNs, 0u);
+}
+
+TEST(I2CBitBangTest, HonoursClockStretching)
+{
+    auto gpio = std::make_shared<I2CSlaveGPIO>();
+    I2CBitBang i2c(gpio, busPins());
+    ASSERT_TRUE(i2c.init(0));
+    ASSERT_TRUE(i2c.setSpeed(0));
+    ASSERT_TRUE(i2c.setDeviceAddress(kAddress));
+
+    gpio->stretchReads = 5;
+    EXPECT_TRUE(i2c.write({0x20, 0x42}));
+    EXPECT_EQ(gpio->memory[0x20], 0x42);
+    EXPECT_EQ(gpio->stretchReads, 0u);
+
+    // A slave that never releases SCL fails the transfer after the timeout
+    gpio->stretchReads = UINT32_MAX;
+    EXPECT_FALSE(i2c.write({0x20, 0x43}));
+    EXPECT_EQ(gpio->memory[0x20], 0x42);
+}
+
+TEST(I2CBitBangTest, InitRecoversStuckBus)
+{
+    auto gpio = std::make_shared<I2CSlaveGPIO>();
+    gpio->stuckClocks = 4;
+
+    I2CBitBang i2c(gpio, busPins());
+    ASSERT_TRUE(i2c.init(0));
+    EXPECT_EQ(gpio->stuckClocks, 0u);
+    EXPECT_EQ(gpio->read(kSda), PinValue::HIGH);
+}
+
+TEST(I2CBitBangTest, SdaOnlyChangesWithItsLevel)
+{
+    auto gpio = std::make_shared<I2CSlaveGPIO>();
+    I2CBitBang i2c(gpio, busPins(0));
+    ASSERT_TRUE(i2c.init(0));
+    ASSERT_TRUE(i2c.setSpeed(0));
+    ASSERT_TRUE(i2c.setDeviceAddress(kAddress));
+
+    gpio->directionChanges = 0;
+    ASSERT_TRUE(i2c.write({0x30}));
+    const size_t pointerOnly = gpio->directionChanges;
+
+    // Nine SCL pulses per byte, 0x00 pulls SDA once and releases it for the acknowledge
+    gpio->directionChanges = 0;
+    ASSERT_TRUE(i2c.write({0x30, 0x00}));
+    EXPECT_EQ(gpio->directionChanges - pointerOnly, 18u + 2u);
+
+    // 0x55 alternates, every bit moves SDA and the acknowledge finds it released
+    gpio->directionChanges = 0;
+    ASSERT_TRUE(i2c.write({0x30, 0x55}));
+    EXPECT_EQ(gpio->directionChanges - pointerOnly, 18u + 8u);
+}
+
+TEST(I2CBitBangTest, HALFallsBackWithoutI2cDev)
+{
+    DeviceConfig::getInstance().refreshI2C();
+    if (!DeviceConfig::getInstance().getI2cInfos().empty())
+    {
+        GTEST_SKIP() << "Board has a hardware I2C bus";
+    }
+
+    auto hal = createHAL(HALType::LINUX);
+    EXPECT_EQ(dynamic_cast<I2CBitBang*>(hal->createI2C().get()), nullptr);
+
+    hal->setSoftI2CPins(busPins());
+    EXPECT_NE(dynamic_cast<I2CBitBang*>(hal->createI2C().get()), nullptr);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <hal/callback_manager.h>
+#include <hal/inplace_function.h>
+#include "timer/timer_linux.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+
+using namespace mex_hal;
+
+namespace
+{
+    std::atomic<bool> countAllocations{false};
+    std::atomic<size_t> allocations{0};
+
+    /// @brief Counts its live instances \struct Tracked
+    struct Tracked
+    {
+        explicit Tracked(int& live) : live(&live) { ++live; }
+        Tracked(Tracked&& other) noexcept : live(other.live) { ++*live; }
+        ~Tracked() { --*live; }
+        int* live;
+    };
+
+    template <typename Predicate>
+    bool waitFor(Predicate&& predicate)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!predicate() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return predicate();
+    }
+}
+
+void* operator new(const size_t size)
+{
+    if (countAllocations.load(std::memory_order_relaxed))
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+TEST(InplaceFunctionTest, CallsAndMovesCallable)
+{
+    int live = 0;
+    int calls = 0;
+    {
+        InplaceFunction<int(int)> function = [tracked = Tracked(live), &calls](const int value) {
+            ++calls;
+            return value * 2;
+        };
+        EXPECT_TRUE(function);
+        EXPECT_EQ(function(21), 42);
+        EXPECT_EQ(live, 1);
+
+        InplaceFunction<int(int)> moved = std::move(function);
+        EXPECT_FALSE(function);
+        EXPECT_TRUE(moved);
+        EXPECT_EQ(moved(1), 2);
+        EXPECT_EQ(live, 1);
+
+        moved = nullptr;
+        EXPECT_FALSE(moved);
+        EXPECT_EQ(live, 0);
+
+        moved = [tracked = Tracked(live)](const int value) { return value; };
+        EXPECT_EQ(live, 1);
+    }
+    EXPECT_EQ(live, 0);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(InplaceFunctionTest, EmptyFunctions)
+{
+    TimerCallback empty;
+    EXPECT_FALSE(empty);
+    EXPECT_THROW(empty(), std::bad_function_call);
+
+    void (*none)() = nullptr;
+    TimerCallback fromNull = none;
+    EXPECT_FALSE(fromNull);
+}
+
+TEST(InplaceFunctionTest, CapturesUpToCapacityInPlace)
+{
+    // Move-only captures are fine, the storage is part of the object
+    auto owned = std::make_unique<int>(7);
+    std::array<uint8_t, CALLBACK_CAPACITY - sizeof(void*)> bytes{};
+    bytes.back() = 5;
+
+    countAllocations = true;
+    InterruptCallback callback = [owned = std::move(owned), bytes](uint8_t pin, PinValue) {
+        EXPECT_EQ(*owned + bytes.back(), 12);
+        EXPECT_EQ(pin, 3);
+    };
+    callback(3, PinValue::HIGH);
+    InterruptCallback moved = std::move(callback);
+    moved(3, PinValue::LOW);
+    countAllocations = false;
+
+    EXPECT_EQ(allocations.exchange(0), 0u);
+    EXPECT_LE(sizeof(InterruptCallback), CALLBACK_CAPACITY + 2 * sizeof(void*));
+
+    // The same capture exceeds the small buffer of std::function, which the counter must notice
+    countAllocations = true;
+    std::function<void()> heap = [bytes]() { (void)bytes; };
+    countAllocations = false;
+    EXPECT_GT(allocations.exchange(0), 0u);
+}
+
+TEST(InplaceFunctionTest, CallbackManagerInvokeDoesNotAllocate)
+{
+    auto& cm = CallbackManager::getInstance();
+    cm.clearAll();
+
+    std::atomic<int> gpioCalls{0};
+    std::atomic<int> timerCalls{0};
+    std::array<uint64_t, 7> padding{};
+    for (int i = 0; i < 8; ++i)
+    {
+        cm.registerGPIOCallback(12, [&gpioCalls, padding](uint8_t, PinValue) { gpioCalls += 1 + static_cast<int>(padding[0]); });
+        cm.registerTimerCallback(4, [&timerCalls]() { timerCalls++; });
+    }
+
+    // The executor queues in place as well, its threads and rings exist before counting starts
+    ASSERT_TRUE(cm.startExecutor({CallbackWorkerConfig{0, -1, 256}}));
+    std::atomic<int> queuedCalls{0};
+    cm.registerGPIOCallback(13, [&queuedCalls](uint8_t, PinValue) { queuedCalls++; }, CallbackSchedule{0, -1});
+
+    countAllocations = true;
+    for (int i = 0; i < 1000; ++i)
+    {
+        cm.invokeGPIOCallback(12, PinValue::HIGH);
+        cm.invokeTimerCallback(4);
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        cm.invokeGPIOCallback(13, PinValue::LOW);
+    }
+    EXPECT_TRUE(waitFor([&] { return queuedCalls == 100; }));
+    countAllocations = false;
+
+    EXPECT_EQ(allocations.exchange(0), 0u);
+    EXPECT_EQ(gpioCalls, 8000);
+    EXPECT_EQ(timerCalls, 8000);
+
+    cm.stopExecutor();
+    cm.clearAll();
+}
+
+TEST(InplaceFunctionTest, TimerTicksDoNotAllocate)
+{
+    TimerLinux timer;
+    ASSERT_TRUE(timer.init(TimerMode::PERIODIC));
+
+    std::atomic<int> ticks{0};
+    std::array<uint64_t, 6> state{};
+    ASSERT_TRUE(timer.start(1000, [&ticks, state]() { ticks += 1 + static_cast<int>(state[0]); }));
+    ASSERT_TRUE(waitFor([&] { return ticks >= 1; }));
+
+    countAllocations = true;
+    const int before = ticks;
+    EXPECT_TRUE(waitFor([&] { return ticks >= before + 10; }));
+    countAllocations = false;
+    timer.stop();
+
+    EXPECT_EQ(allocations.exchange(0), 0u);
+}
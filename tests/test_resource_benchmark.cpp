@@ -0,0 +1,412 @@
+#include <gtest/gtest.h>
+#include <hal/resource_manager.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr int kGuards = 200000;
+    constexpr int kThreads = 4;
+    constexpr int kResources = 10000;
+
+    /// @brief The former reference counting: global mutex and a map lookup per addRef and release
+    class LockedRegistry
+    {
+    public:
+        void add(const uint64_t id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            resources_[id] = std::make_unique<ResourceInfo>();
+            resources_[id]->refCount.store(1);
+        }
+
+        void addRef(const uint64_t id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = resources_.find(id);
+            if (it != resources_.end()) it->second->refCount.fetch_add(1, std::memory_order_acq_rel);
+        }
+
+        void release(const uint64_t id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = resources_.find(id);
+            if (it != resources_.end()) it->second->refCount.fetch_sub(1, std::memory_order_acq_rel);
+        }
+
+        uint32_t getRefCount(const uint64_t id)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = resources_.find(id);
+            return it != resources_.end() ? it->second->refCount.load(std::memory_order_acquire) : 0;
+        }
+
+    private:
+        std::mutex mutex_;
+        std::unordered_map<uint64_t, std::unique_ptr<ResourceInfo>> resources_;
+    };
+
+    /**
+     * @brief Get the heap bytes in use
+     * @return The allocated bytes
+     */
+    size_t heapInUse()
+    {
+        return mallinfo2().uordblks;
+    }
+
+    /**
+     * @brief Run a guard loop on several threads
+     * @param threads The number of threads
+     * @param churn The loop of one thread, given its index
+     * @return Nanoseconds per guard over all threads
+     */
+    template <typename Churn>
+    double nsPerGuard(const int threads, Churn&& churn)
+    {
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&churn, t] { churn(t); });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (static_cast<double>(kGuards) * threads);
+    }
+}
+
+class ResourceBenchmarkTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ResourceManager::getInstance().clearAll();
+    }
+
+    void TearDown() override
+    {
+        ResourceManager::getInstance().clearAll();
+    }
+};
+
+TEST_F(ResourceBenchmarkTest, GuardChurnLockedVsLockFree)
+{
+    auto& rm = ResourceManager::getInstance();
+    const uint64_t sharedId = rm.registerResource(ResourceType::SPI_BUS, "spi_shared", nullptr);
+    std::vector<uint64_t> ownIds;
+    for (int t = 0; t < kThreads; ++t)
+    {
+        ownIds.push_back(rm.registerResource(ResourceType::GPIO_PIN, "gpio_" + std::to_string(t), nullptr));
+    }
+
+    LockedRegistry legacy;
+    legacy.add(sharedId);
+    for (const uint64_t id : ownIds)
+    {
+        legacy.add(id);
+    }
+
+    const double legacyShared = nsPerGuard(kThreads, [&](int) {
+        for (int i = 0; i < kGuards; ++i)
+        {
+            legacy.addRef(sharedId);
+            legacy.release(sharedId);
+        }
+    });
+    const double legacyOwn = nsPerGuard(kThreads, [&](const int t) {
+        for (int i = 0; i < kGuards; ++i)
+        {
+            legacy.addRef(ownIds[t]);
+            legacy.release(ownIds[t]);
+        }
+    });
+    const double shared = nsPerGuard(kThreads, [&](int) {
+        for (int i = 0; i < kGuards; ++i)
+        {
+            ResourceGuard guard(sharedId);
+        }
+    });
+    const double own = nsPerGuard(kThreads, [&](const int t) {
+        for (int i = 0; i < kGuards; ++i)
+        {
+            ResourceGuard guard(ownIds[t]);
+        }
+    });
+    const ResourceGuard held(sharedId);
+    const double handle = nsPerGuard(kThreads, [&](int) {
+        for (int i = 0; i < kGuards; ++i)
+        {
+            ResourceGuard guard = held.share();
+        }
+    });
+
+    std::cout << "[ BENCH    ] " << kThreads << " threads, mutex + map, shared resource: " << legacyShared
+              << " ns/guard\n"
+              << "[ BENCH    ] " << kThreads << " threads, mutex + map, own resources:   " << legacyOwn
+              << " ns/guard\n"
+              << "[ BENCH    ] " << kThreads << " threads, lock-free, shared resource:   " << shared << " ns/guard\n"
+              << "[ BENCH    ] " << kThreads << " threads, lock-free, own resources:     " << own << " ns/guard\n"
+              << "[ BENCH    ] " << kThreads << " threads, share() of a held guard:      " << handle << " ns/guard\n";
+
+    EXPECT_EQ(rm.getRefCount(sharedId), 2u);
+    for (const uint64_t id : ownIds)
+    {
+        EXPECT_EQ(rm.getRefCount(id), 1u);
+    }
+}
+
+TEST_F(ResourceBenchmarkTest, GuardsSurviveUnregistrationChurn)
+{
+    auto& rm = ResourceManager::getInstance();
+    const uint64_t busId = rm.registerResource(ResourceType::I2C_BUS, "i2c_busy", nullptr);
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> latestId{busId};
+
+    // Registration churn retires indexes and resources while guards look IDs up
+    std::thread churn([&] {
+        while (!stop.load())
+        {
+            const uint64_t id = rm.registerResource(ResourceType::GPIO_PIN, "gpio_churn", nullptr);
+            latestId = id;
+            rm.release(id);
+
+            // A guard that found the new resource holds it briefly
+            while (!rm.unregisterResource(id))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    const double ns = nsPerGuard(kThreads, [&](int) {
+        for (int i = 0; i < kGuards; ++i)
+        {
+            // Every other guard names a churned ID, live, retired or not yet registered
+            ResourceGuard guard((i & 1) != 0 ? busId : latestId.load() + static_cast<uint64_t>(i % 4) - 1);
+        }
+    });
+    stop = true;
+    churn.join();
+
+    std::cout << "[ BENCH    ] guards during registration churn: " << ns << " ns/guard\n";
+    EXPECT_EQ(rm.getRefCount(busId), 1u);
+    EXPECT_EQ(rm.getResourceCount(), 1u);
+}
+
+TEST_F(ResourceBenchmarkTest, SlotMapMemoryAndLookup)
+{
+    auto& rm = ResourceManager::getInstance();
+
+    // Run on its own, as ctest does, so no slot of an earlier test is reused and the chunks are counted
+    std::vector<uint64_t> ids;
+    ids.reserve(kResources);
+
+    LockedRegistry legacy;
+    const size_t legacyBefore = heapInUse();
+    for (uint64_t id = 1; id <= kResources; ++id)
+    {
+        legacy.add(id);
+    }
+    const double legacyBytes = static_cast<double>(heapInUse() - legacyBefore) / kResources;
+
+    const size_t before = heapInUse();
+    for (int i = 0; i < kResources; ++i)
+    {
+        ids.push_back(rm.registerResource(ResourceType::GPIO_PIN, "gpio", nullptr));
+    }
+    const double bytes = static_cast<double>(heapInUse() - before) / kResources;
+
+    uint64_t sum = 0;
+    const auto legacyStart = std::chrono::steady_clock::now();
+    for (int round = 0; round < 20; ++round)
+    {
+        for (uint64_t id = 1; id <= kResources; ++id)
+        {
+            sum += legacy.getRefCount(id);
+        }
+    }
+    const auto legacyElapsed = std::chrono::steady_clock::now() - legacyStart;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < 20; ++round)
+    {
+        for (const uint64_t id : ids)
+        {
+            sum += rm.getRefCount(id);
+        }
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    const auto perLookup = [](const std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / (20.0 * kResources);
+    };
+    std::cout << "[ BENCH    ] map + unique_ptr: " << legacyBytes << " heap bytes/resource, "
+              << perLookup(legacyElapsed) << " ns/lookup\n"
+              << "[ BENCH    ] slot map:         " << bytes << " heap bytes/resource, " << perLookup(elapsed)
+              << " ns/lookup\n";
+
+    EXPECT_EQ(sum, 2u * 20u * kResources);
+    EXPECT_EQ(rm.getResourceCount(), static_cast<size_t>(kResources));
+}
+
+TEST_F(ResourceBenchmarkTest, GuardChurnWithMonitoringSnapshots)
+{
+    auto& rm = ResourceManager::getInstance();
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < 64; ++i)
+    {
+        ids.push_back(rm.registerResource(ResourceType::GPIO_PIN, "gpio_" + std::to_string(i), nullptr));
+    }
+
+    const auto churn = [&](const int t) {
+        for (int i = 0; i < kGuards; ++i)
+        {
+            ResourceGuard guard(ids[static_cast<size_t>(t * 16 + (i & 15))]);
+        }
+    };
+    const double quiet = nsPerGuard(kThreads, churn);
+
+    // A monitor polling as fast as it can, far above 100 Hz
+    std::atomic<bool> stop{false};
+    uint64_t polls = 0;
+    std::thread monitor([&] {
+        std::vector<ResourceState> resources;
+        while (!stop.load())
+        {
+            rm.snapshot(resources);
+            EXPECT_EQ(resources.size(), ids.size());
+            ++polls;
+        }
+    });
+    const double monitored = nsPerGuard(kThreads, churn);
+    stop = true;
+    monitor.join();
+
+    std::cout << "[ BENCH    ] guards without monitor:        " << quiet << " ns/guard\n"
+              << "[ BENCH    ] guards with snapshot() polling: " << monitored << " ns/guard, " << polls
+              << " snapshots\n";
+    EXPECT_GT(polls, 0u);
+}
+
+TEST_F(ResourceBenchmarkTest, ParallelTeardownOfBoardConfig)
+{
+    auto& rm = ResourceManager::getInstance();
+    constexpr int kBuses = 8;
+    constexpr int kPins = 8;
+
+    // Eight bit-banged buses on eight pins each, every release waits like a close() or unexport
+    const auto registerBoard = [&rm] {
+        for (int b = 0; b < kBuses; ++b)
+        {
+            std::vector<uint64_t> pins;
+            for (int p = 0; p < kPins; ++p)
+            {
+                pins.push_back(rm.registerResource(ResourceType::GPIO_PIN, "GPIO" + std::to_string(b * kPins + p),
+                                                   nullptr));
+            }
+            rm.registerResource(ResourceType::SPI_BUS, "gpio-spi" + std::to_string(b), nullptr, pins);
+        }
+    };
+    std::atomic<int> releases{0};
+    const auto release = [&releases](const ResourceState&) {
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+        ++releases;
+    };
+    const auto ms = [](const std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+
+    // The destructors release one resource after the other in no particular order
+    registerBoard();
+    auto start = std::chrono::steady_clock::now();
+    for (const ResourceState& resource : rm.snapshot())
+    {
+        release(resource);
+    }
+    rm.clearAll();
+    const double unordered = ms(std::chrono::steady_clock::now() - start);
+
+    registerBoard();
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(rm.teardown(release, 1));
+    const double ordered = ms(std::chrono::steady_clock::now() - start);
+
+    registerBoard();
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(rm.teardown(release, kBuses));
+    const double parallel = ms(std::chrono::steady_clock::now() - start);
+
+    std::cout << "[ BENCH    ] " << kBuses * (kPins + 1) << " resources, unordered sequential release: "
+              << unordered << " ms\n"
+              << "[ BENCH    ] " << kBuses * (kPins + 1) << " resources, teardown on 1 thread:         "
+              << ordered << " ms\n"
+              << "[ BENCH    ] " << kBuses * (kPins + 1) << " resources, teardown on " << kBuses
+              << " threads:        " << parallel << " ms\n";
+
+    EXPECT_EQ(releases.load(), 3 * kBuses * (kPins + 1));
+    EXPECT_EQ(rm.getResourceCount(), 0u);
+    EXPECT_LT(parallel, unordered);
+}
+
+TEST_F(ResourceBenchmarkTest, IoCountingSharedVsSharded)
+{
+    auto& rm = ResourceManager::getInstance();
+    const uint64_t busId = rm.registerResource(ResourceType::SPI_BUS, "spi_saturated", nullptr);
+
+    // One set of atomics per resource, every thread's update contends on its cache line
+    struct SharedCounters
+    {
+        std::atomic<uint64_t> operations{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> errors{0};
+        std::atomic<uint64_t> totalLatencyNs{0};
+        std::atomic<uint64_t> maxLatencyNs{0};
+    } shared;
+
+    const double contended = nsPerGuard(kThreads, [&shared](int) {
+        for (uint64_t i = 0; i < kGuards; ++i)
+        {
+            shared.operations.fetch_add(1, std::memory_order_relaxed);
+            shared.bytes.fetch_add(32, std::memory_order_relaxed);
+            shared.errors.fetch_add(0, std::memory_order_relaxed);
+            shared.totalLatencyNs.fetch_add(i & 1023, std::memory_order_relaxed);
+            uint64_t max = shared.maxLatencyNs.load(std::memory_order_relaxed);
+            while ((i & 1023) > max && !shared.maxLatencyNs.compare_exchange_weak(max, i & 1023)) {}
+        }
+    });
+    const double sharded = nsPerGuard(kThreads, [&rm, busId](int) {
+        for (uint64_t i = 0; i < kGuards; ++i)
+        {
+            rm.recordIo(busId, 32, i & 1023, true);
+        }
+    });
+
+    ResourceIoStats stats;
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(rm.getIoStats(busId, stats));
+    const double readUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[ BENCH    ] " << kThreads << " threads, shared atomic counters: " << contended << " ns/op\n"
+              << "[ BENCH    ] " << kThreads << " threads, per-thread shards:      " << sharded << " ns/op\n"
+              << "[ BENCH    ] aggregation on read:                " << readUs << " us\n";
+
+    EXPECT_EQ(shared.operations.load(), static_cast<uint64_t>(kGuards) * kThreads);
+    EXPECT_EQ(stats.operations, static_cast<uint64_t>(kGuards) * kThreads);
+    EXPECT_EQ(stats.bytes, 32u * kGuards * kThreads);
+    EXPECT_EQ(stats.maxLatencyNs, 1023u);
+}
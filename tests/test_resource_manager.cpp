@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 #include <hal/resource_manager.h>
+#include <hal/resource_visualizer.h>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -122,18 +127,21 @@ TEST_F(ResourceManagerTest, GetResourceInfo)
         &dummyHandle
     );
     
-    const ResourceInfo* info = rm.getResourceInfo(id);
-    ASSERT_NE(info, nullptr);
-    EXPECT_EQ(info->type, ResourceType::I2C_BUS);
-    EXPECT_EQ(info->name, "i2c_1");
-    EXPECT_EQ(info->handle, &dummyHandle);
+    ResourceState info;
+    ASSERT_TRUE(rm.getResourceInfo(id, info));
+    EXPECT_EQ(info.id, id);
+    EXPECT_EQ(info.type, ResourceType::I2C_BUS);
+    EXPECT_EQ(info.name, "i2c_1");
+    EXPECT_EQ(info.handle, &dummyHandle);
+    EXPECT_EQ(info.refCount, 1u);
 }
 
 TEST_F(ResourceManagerTest, GetResourceInfoInvalid)
 {
     auto& rm = ResourceManager::getInstance();
-    const ResourceInfo* info = rm.getResourceInfo(9999);
-    EXPECT_EQ(info, nullptr);
+    ResourceState info;
+    EXPECT_FALSE(rm.getResourceInfo(9999, info));
+    EXPECT_FALSE(rm.getResourceInfo(0, info));
 }
 
 TEST_F(ResourceManagerTest, MultipleResources)
@@ -241,3 +249,308 @@ TEST_F(ResourceManagerTest, ResourceGuardMove)
     ResourceGuard guard2(std::move(guard1));
     EXPECT_EQ(rm.getRefCount(id), 2);  // Still 2 after move
 }
+
+TEST_F(ResourceManagerTest, StaleHandleIsDetected)
+{
+    auto& rm = ResourceManager::getInstance();
+    int first = 1, second = 2;
+
+    const uint64_t staleId = rm.registerResource(ResourceType::UART_PORT, "uart_0", &first);
+    rm.release(staleId);
+    ASSERT_TRUE(rm.unregisterResource(staleId));
+
+    // The freed slot is reused under a new generation
+    const uint64_t id = rm.registerResource(ResourceType::UART_PORT, "uart_1", &second);
+    EXPECT_EQ(static_cast<uint32_t>(id), static_cast<uint32_t>(staleId));
+    EXPECT_NE(id, staleId);
+
+    ResourceState info;
+    EXPECT_FALSE(rm.getResourceInfo(staleId, info));
+    EXPECT_EQ(rm.addRef(staleId), 0u);
+    EXPECT_EQ(rm.release(staleId), 0u);
+    EXPECT_FALSE(rm.unregisterResource(staleId));
+    rm.setInUse(staleId, true);
+
+    ASSERT_TRUE(rm.getResourceInfo(id, info));
+    EXPECT_EQ(info.name, "uart_1");
+    EXPECT_EQ(info.refCount, 1u);
+    EXPECT_FALSE(info.inUse);
+
+    ResourceGuard staleGuard(staleId);
+    EXPECT_EQ(rm.getRefCount(id), 1u);
+}
+
+TEST_F(ResourceManagerTest, ResourceGuardOutlivesClearAll)
+{
+    auto& rm = ResourceManager::getInstance();
+    int dummyHandle = 42;
+
+    const uint64_t id = rm.registerResource(ResourceType::PWM_CHANNEL, "pwm_0", &dummyHandle);
+    {
+        ResourceGuard guard(id);
+        rm.clearAll();
+        EXPECT_EQ(rm.getRefCount(id), 0u);
+
+        // The guarded slot is not reused until the guard releases it
+        const uint64_t other = rm.registerResource(ResourceType::PWM_CHANNEL, "pwm_1", &dummyHandle);
+        EXPECT_NE(static_cast<uint32_t>(other), static_cast<uint32_t>(id));
+    }
+
+    rm.registerResource(ResourceType::PWM_CHANNEL, "pwm_2", &dummyHandle);
+    EXPECT_EQ(rm.getRefCount(id), 0u);
+    EXPECT_EQ(rm.getResourceCount(), 2u);
+}
+
+TEST_F(ResourceManagerTest, ResourceGuardShareTakesReference)
+{
+    auto& rm = ResourceManager::getInstance();
+    int dummyHandle = 42;
+
+    const uint64_t id = rm.registerResource(ResourceType::SPI_BUS, "spi_0", &dummyHandle);
+    {
+        const ResourceGuard guard(id);
+        const ResourceGuard shared = guard.share();
+        EXPECT_EQ(shared.getResourceId(), id);
+        EXPECT_EQ(rm.getRefCount(id), 3u);
+
+        // After unregistration a shared guard holds nothing new
+        rm.clearAll();
+        const ResourceGuard late = guard.share();
+        EXPECT_EQ(rm.getRefCount(id), 0u);
+    }
+
+    const ResourceGuard empty(id);
+    const ResourceGuard none = empty.share();
+    EXPECT_EQ(none.getResourceId(), id);
+    EXPECT_EQ(rm.getResourceCount(), 0u);
+}
+
+TEST_F(ResourceManagerTest, SnapshotCopiesLiveResources)
+{
+    auto& rm = ResourceManager::getInstance();
+    int handle1 = 1, handle2 = 2, handle3 = 3;
+
+    const uint64_t id1 = rm.registerResource(ResourceType::GPIO_PIN, "gpio_1", &handle1);
+    const uint64_t id2 = rm.registerResource(ResourceType::SPI_BUS, "spi_0", &handle2);
+    const uint64_t id3 = rm.registerResource(ResourceType::I2C_BUS, "i2c_1", &handle3);
+    rm.setInUse(id3, true);
+    rm.release(id2);
+    ASSERT_TRUE(rm.unregisterResource(id2));
+
+    std::vector<ResourceState> resources = rm.snapshot();
+    ASSERT_EQ(resources.size(), 2u);
+    std::sort(resources.begin(), resources.end(),
+              [](const ResourceState& a, const ResourceState& b) { return a.name < b.name; });
+    EXPECT_EQ(resources[0].id, id1);
+    EXPECT_EQ(resources[0].type, ResourceType::GPIO_PIN);
+    EXPECT_EQ(resources[0].handle, &handle1);
+    EXPECT_EQ(resources[0].refCount, 1u);
+    EXPECT_EQ(resources[1].id, id3);
+    EXPECT_EQ(resources[1].name, "i2c_1");
+    EXPECT_TRUE(resources[1].inUse);
+
+    // A reused buffer shrinks to the live resources
+    rm.release(id1);
+    ASSERT_TRUE(rm.unregisterResource(id1));
+    rm.snapshot(resources);
+    ASSERT_EQ(resources.size(), 1u);
+    EXPECT_EQ(resources[0].id, id3);
+}
+
+TEST_F(ResourceManagerTest, VisualizerSeesSparseIds)
+{
+    auto& rm = ResourceManager::getInstance();
+    int handle = 0;
+
+    std::vector<uint64_t> ids;
+    for (int i = 0; i < 4; ++i)
+    {
+        ids.push_back(rm.registerResource(ResourceType::ADC_CHANNEL, "adc_" + std::to_string(i), &handle));
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+        rm.release(ids[i]);
+        ASSERT_TRUE(rm.unregisterResource(ids[i]));
+    }
+
+    // Only the highest ID is left, a scan of 1..count misses it
+    ResourceVisualizer visualizer;
+    visualizer.gatherResourceData();
+    const std::vector<ResourceUsage> usages = visualizer.getResourceUsages();
+    ASSERT_EQ(usages.size(), 1u);
+    EXPECT_EQ(usages[0].id, ids[3]);
+    EXPECT_EQ(usages[0].name, "adc_3");
+}
+
+TEST_F(ResourceManagerTest, DependencyQueries)
+{
+    auto& rm = ResourceManager::getInstance();
+    int handle = 0;
+
+    const uint64_t sclk = rm.registerResource(ResourceType::GPIO_PIN, "GPIO5", &handle);
+    const uint64_t mosi = rm.registerResource(ResourceType::GPIO_PIN, "GPIO6", &handle);
+    const uint64_t bus = rm.registerResource(ResourceType::SPI_BUS, "gpio-spi", &handle, {sclk, mosi, sclk});
+    ASSERT_NE(bus, 0u);
+
+    EXPECT_EQ(rm.getDependencies(bus), (std::vector<uint64_t>{sclk, mosi}));
+    EXPECT_EQ(rm.getDependents(sclk), std::vector<uint64_t>{bus});
+    EXPECT_TRUE(rm.getDependencies(sclk).empty());
+
+    // Snapshots carry the edges, the visualizer builds its graph from them
+    const std::vector<ResourceState> resources = rm.snapshot();
+    const auto busState = std::find_if(resources.begin(), resources.end(),
+                                       [bus](const ResourceState& state) { return state.id == bus; });
+    ASSERT_NE(busState, resources.end());
+    EXPECT_EQ(busState->dependencies, (std::vector<uint64_t>{sclk, mosi}));
+
+    ResourceVisualizer visualizer;
+    visualizer.gatherResourceData();
+    visualizer.buildResourceGraph();
+    const std::vector<ResourceNode> graph = visualizer.getResourceGraph();
+    ASSERT_EQ(graph.size(), 3u);
+    const auto busNode = std::find_if(graph.begin(), graph.end(),
+                                      [bus](const ResourceNode& node) { return node.id == bus; });
+    ASSERT_NE(busNode, graph.end());
+    EXPECT_EQ(busNode->dependencies, (std::vector<uint64_t>{sclk, mosi}));
+
+    // An unregistered parent fails the registration
+    rm.release(mosi);
+    rm.release(bus);
+    ASSERT_TRUE(rm.unregisterResource(bus));
+    ASSERT_TRUE(rm.unregisterResource(mosi));
+    EXPECT_EQ(rm.registerResource(ResourceType::SPI_BUS, "gpio-spi", &handle, {sclk, mosi}), 0u);
+    EXPECT_EQ(rm.getResourceCount(), 1u);
+
+    // Unregistering drops the edges of the resource
+    EXPECT_TRUE(rm.getDependents(sclk).empty());
+    EXPECT_TRUE(rm.getDependencies(bus).empty());
+}
+
+TEST_F(ResourceManagerTest, DependencyCycleIsRejected)
+{
+    auto& rm = ResourceManager::getInstance();
+    int handle = 0;
+
+    const uint64_t a = rm.registerResource(ResourceType::UART_PORT, "a", &handle);
+    const uint64_t b = rm.registerResource(ResourceType::FILE_DESCRIPTOR, "b", &handle);
+    const uint64_t c = rm.registerResource(ResourceType::FILE_DESCRIPTOR, "c", &handle);
+
+    EXPECT_TRUE(rm.addDependency(a, b));
+    EXPECT_TRUE(rm.addDependency(b, c));
+    EXPECT_TRUE(rm.addDependency(a, b));
+    EXPECT_FALSE(rm.addDependency(c, a));
+    EXPECT_FALSE(rm.addDependency(b, a));
+    EXPECT_FALSE(rm.addDependency(a, a));
+    EXPECT_FALSE(rm.addDependency(a, 0));
+    EXPECT_TRUE(rm.getDependencies(c).empty());
+
+    std::vector<uint64_t> order;
+    ASSERT_TRUE(rm.getTeardownOrder(order));
+    EXPECT_EQ(order, (std::vector<uint64_t>{a, b, c}));
+
+    // Without the edge to b, c no longer waits for a
+    EXPECT_TRUE(rm.removeDependency(b, c));
+    EXPECT_FALSE(rm.removeDependency(b, c));
+    EXPECT_TRUE(rm.addDependency(c, a));
+    ASSERT_TRUE(rm.getTeardownOrder(order));
+    EXPECT_EQ(order, (std::vector<uint64_t>{c, a, b}));
+}
+
+TEST_F(ResourceManagerTest, TeardownReleasesDependentsFirst)
+{
+    auto& rm = ResourceManager::getInstance();
+    int handle = 0;
+
+    // Four buses on three pins each, a sensor on every bus
+    std::vector<std::vector<uint64_t>> dependencies;
+    std::vector<uint64_t> ids;
+    for (int b = 0; b < 4; ++b)
+    {
+        std::vector<uint64_t> pins;
+        for (int p = 0; p < 3; ++p)
+        {
+            pins.push_back(rm.registerResource(ResourceType::GPIO_PIN, "GPIO" + std::to_string(b * 3 + p), &handle));
+            ids.push_back(pins.back());
+        }
+        ids.push_back(rm.registerResource(ResourceType::I2C_BUS, "bus" + std::to_string(b), &handle, pins));
+        const uint64_t bus = ids.back();
+        ids.push_back(rm.registerResource(ResourceType::ADC_CHANNEL, "sensor" + std::to_string(b), &handle, {bus}));
+    }
+    ASSERT_EQ(std::count(ids.begin(), ids.end(), 0u), 0);
+
+    std::mutex mutex;
+    std::vector<uint64_t> released;
+    ASSERT_TRUE(rm.teardown([&](const ResourceState& resource) {
+        // Dependents are unregistered before the release of their dependencies starts
+        EXPECT_TRUE(rm.getDependents(resource.id).empty()) << resource.name;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(mutex);
+        released.push_back(resource.id);
+    }, 4));
+
+    ASSERT_EQ(released.size(), ids.size());
+    const auto position = [&](const uint64_t id) {
+        return std::find(released.begin(), released.end(), id) - released.begin();
+    };
+    for (size_t i = 0; i < ids.size(); i += 5)
+    {
+        for (size_t p = 0; p < 3; ++p)
+        {
+            EXPECT_LT(position(ids[i + 3]), position(ids[i + p]));
+        }
+        EXPECT_LT(position(ids[i + 4]), position(ids[i + 3]));
+    }
+    EXPECT_EQ(rm.getResourceCount(), 0u);
+    EXPECT_EQ(rm.getRefCount(ids[0]), 0u);
+}
+
+TEST_F(ResourceManagerTest, IoStatsAreSummedOverThreads)
+{
+    auto& rm = ResourceManager::getInstance();
+    int handle = 0;
+    const uint64_t id = rm.registerResource(ResourceType::SPI_BUS, "spi_io", &handle);
+
+    // Each thread counts in its own shard, the shards of exited threads keep their counts
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&rm, id, t] {
+            for (uint64_t i = 1; i <= 1000; ++i)
+            {
+                rm.recordIo(id, 4, i + t, true);
+            }
+            rm.recordIo(id, 0, 10, false);
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ResourceIoTimer(id).finish(2, true);
+
+    ResourceIoStats stats;
+    ASSERT_TRUE(rm.getIoStats(id, stats));
+    EXPECT_EQ(stats.operations, 4u * 1001u + 1u);
+    EXPECT_EQ(stats.bytes, 4u * 4000u + 2u);
+    EXPECT_EQ(stats.errors, 4u);
+    EXPECT_GE(stats.totalLatencyNs, 4u * 500500u + 6000u + 40u);
+    EXPECT_GE(stats.maxLatencyNs, 1003u);
+
+    ResourceVisualizer visualizer;
+    visualizer.gatherResourceData();
+    const std::vector<ResourceUsage> usages = visualizer.getResourceUsages();
+    ASSERT_EQ(usages.size(), 1u);
+    EXPECT_EQ(usages[0].io.operations, stats.operations);
+
+    // A later resource in the same slot starts from zero, the stale ID counts nothing
+    rm.release(id);
+    ASSERT_TRUE(rm.unregisterResource(id));
+    EXPECT_FALSE(rm.getIoStats(id, stats));
+    const uint64_t next = rm.registerResource(ResourceType::SPI_BUS, "spi_io", &handle);
+    rm.recordIo(id, 4, 1, true);
+    rm.recordIo(next, 8, 1, true);
+    rm.recordIo(0, 4, 1, true);
+    ASSERT_TRUE(rm.getIoStats(next, stats));
+    EXPECT_EQ(stats.operations, 1u);
+    EXPECT_EQ(stats.bytes, 8u);
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include <hal/soft_pwm.h>
+#include "monotonic_clock/monotonic_clock.h"
+#include "stub_gpio.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <dirent.h>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr uint32_t kMs = 1000000;
+
+    size_t threadCount()
+    {
+        size_t count = 0;
+        DIR* dir = opendir("/proc/self/task");
+        if (dir == nullptr) return 0;
+        while (const dirent* entry = readdir(dir))
+        {
+            if (entry->d_name[0] != '.') ++count;
+        }
+        closedir(dir);
+        return count;
+    }
+
+    /// @brief GPIO controller that records every level change with its time
+    class RecordingGPIO : public StubGPIO
+    {
+    public:
+        struct Change
+        {
+            uint64_t timeNs;
+            uint8_t pin;
+            bool high;
+        };
+
+
+        bool setDirection(const uint8_t pin, const PinDirection direction) override
+        {
+            return pin != kBrokenPin && direction == PinDirection::OUTPUT;
+        }
+
+        bool write(const uint8_t pin, const PinValue value) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            changes_.push_back({monotonicNs(), pin, value == PinValue::HIGH});
+            return true;
+        }
+
+        bool writeMask(const PinMask& mask, const PinMask& values) override
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const uint64_t nowNs = monotonicNs();
+            for (size_t pin = 0; pin < mask.size(); ++pin)
+            {
+                if (mask.test(pin)) changes_.push_back({nowNs, static_cast<uint8_t>(pin), values.test(pin)});
+            }
+            return true;
+        }
+
+        std::vector<Change> changesOf(const uint8_t pin)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<Change> changes;
+            for (const Change& change : changes_)
+            {
+                if (change.pin == pin) changes.push_back(change);
+            }
+            return changes;
+        }
+
+        static constexpr uint8_t kBrokenPin = 99;
+
+    private:
+        std::mutex mutex_;
+        std::vector<Change> changes_;
+    };
+
+    /// @brief Recording GPIO controller whose first falling write stalls the scheduler thread
+    class StallingGPIO : public RecordingGPIO
+    {
+    public:
+        bool writeMask(const PinMask& mask, const PinMask& values) override
+        {
+            if (mask.any() && values.none() && !stalled_.exchange(true))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(45));
+            }
+            return RecordingGPIO::writeMask(mask, values);
+        }
+
+    private:
+        std::atomic<bool> stalled_{false};
+    };
+
+    std::unique_ptr<SoftPWM> startChannel(SoftPWMScheduler& scheduler, const uint8_t pin,
+                                               const uint32_t periodNs, const uint32_t dutyNs)
+    {
+        auto pwm = scheduler.createChannel();
+        EXPECT_TRUE(pwm->init(0, pin));
+        EXPECT_TRUE(pwm->setPeriod(periodNs));
+        EXPECT_TRUE(pwm->setDutyCycle(dutyNs));
+        EXPECT_TRUE(pwm->enable(true));
+        return pwm;
+    }
+}
+
+TEST(SoftPWMTest, SixteenChannelsShareOneThread)
+{
+    auto gpio = std::make_shared<RecordingGPIO>();
+    SoftPWMScheduler scheduler(gpio);
+
+    // Sanitizer runtimes start helper threads with the first thread, get that out of the way
+    std::thread([] {}).join();
+    const size_t threadsBefore = threadCount();
+    std::vector<std::unique_ptr<PWMInterface>> channels;
+    for (uint8_t pin = 0; pin < 16; ++pin)
+    {
+        channels.push_back(startChannel(scheduler, pin, 4 * kMs, (pin + 1) * 200000));
+    }
+    EXPECT_EQ(threadCount(), threadsBefore + 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    for (uint8_t pin = 0; pin < 16; ++pin)
+    {
+        const auto changes = gpio->changesOf(pin);
+        size_t rises = 0;
+        for (const auto& change : changes) rises += change.high ? 1 : 0;
+        EXPECT_GE(rises, 5u) << "pin " << static_cast<int>(pin);
+    }
+
+    // Equal periods start on the same grid, the rising edges of all channels share writes
+    const SoftPWMStats stats = scheduler.getStats();
+    EXPECT_GT(stats.edges, 0u);
+    EXPECT_LT(stats.writes, stats.edges);
+    EXPECT_EQ(stats.writeErrors, 0u);
+    EXPECT_GE(stats.maxJitterNs, stats.meanJitterNs);
+}
+
+TEST(SoftPWMTest, EdgesFollowPeriodAndDutyCycle)
+{
+    auto gpio = std::make_shared<RecordingGPIO>();
+    SoftPWMScheduler scheduler(gpio);
+    const uint64_t startNs = monotonicNs();
+    auto pwm = startChannel(scheduler, 5, 2 * kMs, 500000);
+
+    // The inactive level written while configuring precedes the first edge
+    const auto edgesOf = [&gpio]
+    {
+        auto changes = gpio->changesOf(5);
+        const auto firstRise = std::find_if(changes.begin(), changes.end(),
+                                            [](const RecordingGPIO::Change& change) { return change.high; });
+        changes.erase(changes.begin(), firstRise);
+        return changes;
+    };
+
+    // Wall-clock spacing of the writes depends on the load, only order and counts are checked
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (edgesOf().size() < 6 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto changes = edgesOf();
+    const SoftPWMStats stats = pwm->getStats();
+    const uint64_t elapsedNs = monotonicNs() - startNs;
+    ASSERT_GE(changes.size(), 6u);
+
+    // Every period rises once and falls once, starting from the inactive level
+    size_t rises = 0;
+    for (size_t i = 0; i < changes.size(); ++i)
+    {
+        EXPECT_EQ(changes[i].high, i % 2 == 0) << "change " << i;
+        rises += changes[i].high ? 1 : 0;
+    }
+
+    // Rises and skipped periods together never outnumber the 2 ms grid points that passed
+    EXPECT_LE(rises + stats.missedPeriods, elapsedNs / (2 * kMs) + 1);
+    EXPECT_GE(stats.edges, changes.size());
+    EXPECT_EQ(stats.missedPeriods, scheduler.getChannelStats(0).missedPeriods);
+}
+
+TEST(SoftPWMTest, StalledThreadSkipsPeriodsWithoutRuntPulses)
+{
+    auto gpio = std::make_shared<StallingGPIO>();
+    SoftPWMScheduler scheduler(gpio);
+
+    // The first fall stalls the thread past the next rise and its whole active phase
+    auto pwm = startChannel(scheduler, 5, 20 * kMs, 10 * kMs);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (gpio->changesOf(5).size() < 6 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto changes = gpio->changesOf(5);
+    ASSERT_GE(changes.size(), 6u);
+
+    // A late rise would fall right after it, half the duty leaves room for scheduling noise
+    for (size_t i = 0; i + 1 < changes.size(); ++i)
+    {
+        if (!changes[i].high || changes[i + 1].high) continue;
+        EXPECT_GE(changes[i + 1].timeNs - changes[i].timeNs, 5 * kMs) << "pulse " << i;
+    }
+    EXPECT_GE(pwm->getStats().missedPeriods, 1u);
+}
+
+TEST(SoftPWMTest, ConstantLevelsAndPolarity)
+{
+    auto gpio = std::make_shared<RecordingGPIO>();
+    SoftPWMScheduler scheduler(gpio);
+    auto pwm = scheduler.createChannel();
+    ASSERT_TRUE(pwm->init(0, 7));
+    ASSERT_TRUE(pwm->setPeriod(kMs));
+
+    ASSERT_TRUE(pwm->enable(true));
+    EXPECT_FALSE(gpio->changesOf(7).back().high);
+
+    ASSERT_TRUE(pwm->setDutyCyclePercent(100.0f));
+    EXPECT_TRUE(gpio->changesOf(7).back().high);
+
+    ASSERT_TRUE(pwm->setPolarity(true));
+    EXPECT_FALSE(gpio->changesOf(7).back().high);
+
+    ASSERT_TRUE(pwm->enable(false));
+    EXPECT_TRUE(gpio->changesOf(7).back().high);
+    EXPECT_FALSE(pwm->isEnabled());
+    EXPECT_EQ(pwm->getDutyCycle(), kMs);
+
+    // No edge was ever scheduled
+    EXPECT_EQ(scheduler.getStats().edges, 0u);
+}
+
+TEST(SoftPWMTest, RejectsInvalidConfiguration)
+{
+    auto gpio = std::make_shared<RecordingGPIO>();
+    SoftPWMScheduler scheduler(gpio);
+
+    auto pwm = scheduler.createChannel();
+    EXPECT_FALSE(pwm->setPeriod(kMs));
+    ASSERT_TRUE(pwm->init(0, 3));
+    EXPECT_FALSE(pwm->init(0, 4));
+    EXPECT_FALSE(pwm->enable(true));
+
+    ASSERT_TRUE(pwm->setPeriod(kMs));
+    EXPECT_FALSE(pwm->setDutyCycle(kMs + 1));
+    EXPECT_FALSE(pwm->setDutyCyclePercent(120.0f));
+
+    // Too short to toggle, but a constant level is fine
+    ASSERT_TRUE(pwm->setPeriod(SoftPWMScheduler::MIN_PERIOD_NS / 2));
+    ASSERT_TRUE(pwm->setDutyCycle(SoftPWMScheduler::MIN_PERIOD_NS / 4));
+    EXPECT_FALSE(pwm->enable(true));
+
+    auto sameLine = scheduler.createChannel();
+    EXPECT_FALSE(sameLine->init(0, 3));
+    auto brokenLine = scheduler.createChannel();
+    EXPECT_FALSE(brokenLine->init(0, RecordingGPIO::kBrokenPin));
+
+    // Releasing a channel frees its line
+    pwm.reset();
+    EXPECT_TRUE(sameLine->init(0, 3));
+}
@@ -0,0 +1,201 @@
+#include <gtest/gtest.h>
+#include <hal/core.h>
+#include "spi/spi_bitbang.h"
+#include "device_config/device_config.h"
+#include "monotonic_clock/monotonic_clock.h"
+#include "stub_gpio.h"
+#include <vector>
+
+using namespace mex_hal;
+
+namespace
+{
+    constexpr uint8_t kSclk = 10;
+    constexpr uint8_t kMosi = 11;
+    constexpr uint8_t kMiso = 12;
+    constexpr uint8_t kCs = 13;
+
+    /// @brief GPIO controller wired to an SPI slave model that answers with fixed bytes
+    class SPISlaveGPIO : public StubGPIO
+    {
+    public:
+        SPISlaveGPIO(const SPIMode mode, std::vector<uint8_t> response)
+            : cpol_(mode == SPIMode::MODE_2 || mode == SPIMode::MODE_3)
+            , cpha_(mode == SPIMode::MODE_1 || mode == SPIMode::MODE_3)
+            , response_(std::move(response))
+        {
+        }
+
+
+        PinValue read(const uint8_t pin) override
+        {
+            ++reads;
+            return pin == kMiso && miso_ ? PinValue::HIGH : PinValue::LOW;
+        }
+
+        bool writeMask(const PinMask& mask, const PinMask& values) override
+        {
+            ++writes;
+            if (mask.test(kSclk) && mask.test(kMosi)) ++clockDataWrites;
+
+            // Chip select first, then data, then the clock edge it travels with
+            if (mask.test(kCs) && values.test(kCs) != cs_)
+            {
+                cs_ = values.test(kCs);
+                if (!cs_) select();
+            }
+            if (mask.test(kMosi)) mosi_ = values.test(kMosi);
+            if (mask.test(kSclk) && values.test(kSclk) != sclk_)
+            {
+                sclk_ = values.test(kSclk);
+                if (!cs_) clockEdge(sclk_ != cpol_);
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool sclk() const { return sclk_; }
+        [[nodiscard]] bool cs() const { return cs_; }
+
+        std::vector<uint8_t> received;
+        size_t writes = 0;
+        size_t clockDataWrites = 0;
+        size_t reads = 0;
+        bool badIdleClock = false;
+
+    private:
+        void select()
+        {
+            if (sclk_ != cpol_) badIdleClock = true;
+            inBits_ = 0;
+            outBit_ = 0;
+            if (!cpha_) present();
+        }
+
+        void clockEdge(const bool leading)
+        {
+            // CPHA=0 samples on the leading edge and shifts on the trailing one, CPHA=1 the other way round
+            if (leading != cpha_) sample();
+            else present();
+        }
+
+        void sample()
+        {
+            shiftIn_ = static_cast<uint8_t>(shiftIn_ << 1 | (mosi_ ? 1 : 0));
+            if (++inBits_ % 8 == 0) received.push_back(shiftIn_);
+        }
+
+        void present()
+        {
+            const size_t byte = outBit_ / 8;
+            miso_ = byte < response_.size() && ((response_[byte] >> (7 - outBit_ % 8)) & 1) != 0;
+            ++outBit_;
+        }
+
+        bool cpol_;
+        bool cpha_;
+        std::vector<uint8_t> response_;
+        bool sclk_ = false;
+        bool mosi_ = false;
+        bool miso_ = false;
+        bool cs_ = true;
+        uint8_t shiftIn_ = 0;
+        size_t inBits_ = 0;
+        size_t outBit_ = 0;
+    };
+
+    SoftSPIPins busPins()
+    {
+        SoftSPIPins pins;
+        pins.sclk = kSclk;
+        pins.mosi = kMosi;
+        pins.miso = kMiso;
+        pins.cs = kCs;
+        return pins;
+    }
+}
+
+TEST(SPIBitBangTest, TransfersInAllModes)
+{
+    for (const SPIMode mode : {SPIMode::MODE_0, SPIMode::MODE_1, SPIMode::MODE_2, SPIMode::MODE_3})
+    {
+        auto gpio = std::make_shared<SPISlaveGPIO>(mode, std::vector<uint8_t>{0xA5, 0x5A});
+        SPIBitBang spi(gpio, busPins());
+        ASSERT_TRUE(spi.init(0, 0, 0, mode));
+
+        std::vector<uint8_t> rx;
+        ASSERT_TRUE(spi.transfer({0x3C, 0x81}, rx));
+
+        const int index = static_cast<int>(mode);
+        EXPECT_EQ(rx, (std::vector<uint8_t>{0xA5, 0x5A})) << "mode " << index;
+        EXPECT_EQ(gpio->received, (std::vector<uint8_t>{0x3C, 0x81})) << "mode " << index;
+        EXPECT_FALSE(gpio->badIdleClock) << "mode " << index;
+        EXPECT_TRUE(gpio->cs()) << "mode " << index;
+        EXPECT_EQ(gpio->sclk(), mode == SPIMode::MODE_2 || mode == SPIMode::MODE_3) << "mode " << index;
+    }
+}
+
+TEST(SPIBitBangTest, ClockEdgeAndDataShareOneWrite)
+{
+    auto gpio = std::make_shared<SPISlaveGPIO>(SPIMode::MODE_0, std::vector<uint8_t>{});
+    SPIBitBang spi(gpio, busPins());
+    ASSERT_TRUE(spi.init(0, 0, 0, SPIMode::MODE_0));
+
+    // Two writes per bit, one of them carries the data, plus the chip select release
+    gpio->writes = 0;
+    gpio->clockDataWrites = 0;
+    ASSERT_TRUE(spi.write({0xFF, 0x00, 0x55}));
+    EXPECT_EQ(gpio->writes, 3u * 16u + 1u);
+    EXPECT_EQ(gpio->clockDataWrites, 3u * 8u);
+    EXPECT_EQ(gpio->reads, 0u);
+
+    // CPHA=1 needs its own chip select phase before the first edge
+    ASSERT_TRUE(spi.setMode(SPIMode::MODE_1));
+    gpio->writes = 0;
+    std::vector<uint8_t> rx;
+    ASSERT_TRUE(spi.transfer({0x01}, rx));
+    EXPECT_EQ(gpio->writes, 16u + 2u);
+    EXPECT_EQ(gpio->reads, 8u);
+}
+
+TEST(SPIBitBangTest, PacesClockToRequestedSpeed)
+{
+    auto gpio = std::make_shared<SPISlaveGPIO>(SPIMode::MODE_0, std::vector<uint8_t>{});
+    SPIBitBang spi(gpio, busPins());
+    ASSERT_TRUE(spi.init(0, 0, 10000, SPIMode::MODE_0));
+
+    // 16 bits at 10 kHz are 32 half periods of 50 us
+    const uint64_t startNs = monotonicNs();
+    ASSERT_TRUE(spi.write({0x12, 0x34}));
+    EXPECT_GE(monotonicNs() - startNs, 32u * 50000u);
+    EXPECT_EQ(gpio->received, (std::vector<uint8_t>{0x12, 0x34}));
+}
+
+TEST(SPIBitBangTest, RejectsInvalidUse)
+{
+    auto gpio = std::make_shared<SPISlaveGPIO>(SPIMode::MODE_0, std::vector<uint8_t>{});
+
+    SPIBitBang spi(gpio, busPins());
+    std::vector<uint8_t> rx;
+    EXPECT_FALSE(spi.transfer({0x00}, rx));
+    EXPECT_FALSE(spi.setSpeed(1000));
+
+    SoftSPIPins shared = busPins();
+    shared.miso = kMosi;
+    SPIBitBang overlapping(gpio, shared);
+    EXPECT_FALSE(overlapping.init(0, 0, 0, SPIMode::MODE_0));
+}
+
+TEST(SPIBitBangTest, HALFallsBackWithoutSpidev)
+{
+    DeviceConfig::getInstance().refreshSPI();
+    if (!DeviceConfig::getInstance().getSpiInfos().empty())
+    {
+        GTEST_SKIP() << "Board has a hardware SPI bus";
+    }
+
+    auto hal = createHAL(HALType::LINUX);
+    EXPECT_EQ(dynamic_cast<SPIBitBang*>(hal->createSPI().get()), nullptr);
+
+    hal->setSoftSPIPins(busPins());
+    EXPECT_NE(dynamic_cast<SPIBitBang*>(hal->createSPI().get()), nullptr);
+}
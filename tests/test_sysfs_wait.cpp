@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include "sysfs_wait/sysfs_wait.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace mex_hal;
+namespace fs = std::filesystem;
+
+class SysfsWaitTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        char tmpl[] = "/tmp/mex_hal_sysfs_XXXXXX";
+        ASSERT_NE(mkdtemp(tmpl), nullptr);
+        root = tmpl;
+    }
+
+    void TearDown() override
+    {
+        for (auto& thread : creators)
+        {
+            thread.join();
+        }
+        fs::remove_all(root);
+    }
+
+    // Simulates udev creating an attribute some time after the export write
+    void createLater(const fs::path& path, const std::chrono::milliseconds delay)
+    {
+        creators.emplace_back([path, delay] {
+            std::this_thread::sleep_for(delay);
+            fs::create_directories(path.parent_path());
+            std::ofstream(path) << "0";
+        });
+    }
+
+    fs::path root;
+    std::vector<std::thread> creators;
+};
+
+TEST_F(SysfsWaitTest, ExistingNodeIsReadyImmediately)
+{
+    std::ofstream(root / "value") << "0";
+    EXPECT_TRUE(SysfsWait::waitForNode((root / "value").string(), 0));
+}
+
+TEST_F(SysfsWaitTest, MissingNodeTimesOut)
+{
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(SysfsWait::waitForNode((root / "missing").string(), 20));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(200));
+}
+
+TEST_F(SysfsWaitTest, ReturnsSoonAfterNodeAppears)
+{
+    createLater(root / "gpio5" / "value", std::chrono::milliseconds(15));
+
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(SysfsWait::waitForNode((root / "gpio5" / "value").string()));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+}
+
+TEST_F(SysfsWaitTest, BatchWaitsOverlap)
+{
+    constexpr int kNodes = 16;
+    std::vector<std::string> paths;
+    for (int i = 0; i < kNodes; ++i)
+    {
+        const fs::path path = root / ("gpio" + std::to_string(i)) / "value";
+        createLater(path, std::chrono::milliseconds(20));
+        paths.push_back(path.string());
+    }
+
+    // Sequential fixed sleeps would cost kNodes * 20 ms
+    const auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(SysfsWait::waitForNodes(paths));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(kNodes * 20));
+}
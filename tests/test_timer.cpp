@@ -1,9 +1,11 @@
 #include <gtest/gtest.h>
 #include <hal/core.h>
 #include <hal/timer.h>
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 
 using namespace mex_hal;
 
@@ -195,3 +197,68 @@ TEST_F(TimerTest, DifferentIntervals)
     // Timer1 should have fired approximately twice as often as Timer2
     EXPECT_GT(count1, count2);
 }
+
+TEST_F(TimerTest, OverrunSkipsMissedPeriods)
+{
+    timer->init(TimerMode::PERIODIC);
+    std::atomic<int> count{0};
+    std::vector<TimerOverrun> reported;
+
+    ASSERT_TRUE(timer->setDeadlineBudget(5000, [&reported](const TimerOverrun& overrun) {
+        reported.push_back(overrun);
+    }));
+
+    timer->start(10000, [&count]() {  // 10ms, the third tick runs for 35ms
+        if (count++ == 2)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(35));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    EXPECT_FALSE(timer->setDeadlineBudget(0, nullptr));
+    timer->stop();
+
+    const TimerDeadlineStats stats = timer->getDeadlineStats();
+    EXPECT_EQ(stats.ticks, static_cast<uint64_t>(count.load()));
+    EXPECT_GE(stats.overruns, 1u);
+    EXPECT_GE(stats.missedPeriods, 3u);
+    EXPECT_GE(stats.maxResponseNs, 35000000u);
+
+    // The missed ticks are skipped, not fired back-to-back
+    EXPECT_LE(count.load(), 10);
+
+    ASSERT_EQ(reported.size(), stats.overruns);
+    const auto slow = std::find_if(reported.begin(), reported.end(),
+                                   [](const TimerOverrun& overrun) { return overrun.tick == 2; });
+    ASSERT_NE(slow, reported.end());
+    EXPECT_EQ(slow->budgetNs, 5000000u);
+    EXPECT_GE(slow->missedPeriods, 3u);
+}
+
+TEST_F(TimerTest, BudgetLongerThanIntervalStillSkipsMissedPeriods)
+{
+    timer->init(TimerMode::PERIODIC);
+    std::atomic<int> count{0};
+    std::vector<TimerOverrun> reported;
+
+    // The slow tick stays within the budget, the ticks it ran past are still skipped
+    ASSERT_TRUE(timer->setDeadlineBudget(100000, [&reported](const TimerOverrun& overrun) {
+        reported.push_back(overrun);
+    }));
+
+    timer->start(10000, [&count]() {  // 10ms, the third tick runs for 35ms
+        if (count++ == 2)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(35));
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(120));
+    timer->stop();
+
+    const TimerDeadlineStats stats = timer->getDeadlineStats();
+    EXPECT_GE(stats.missedPeriods, 3u);
+    EXPECT_LE(count.load(), 10);
+    ASSERT_EQ(reported.size(), stats.overruns);
+    EXPECT_TRUE(std::none_of(reported.begin(), reported.end(),
+                             [](const TimerOverrun& overrun) { return overrun.tick == 2; }));
+}